@@ -8,93 +8,7 @@
  */
 
 #include "smooth_axis.h"
-#include "smooth_axis_debug.h"
-#include <math.h>
-
-// ----------------------------------------------------------------------------
-// Internal Constants
-// ----------------------------------------------------------------------------
-static const uint16_t SMOOTH_AXIS_INIT_CALIBRATION_CYCLES = 256;
-
-// Clamp measured dt during AUTO warmup to avoid pathological cases
-static const float SMOOTH_AXIS_AUTO_DT_MIN_MS = 0.1f;   // 10,000 Hz max
-static const float SMOOTH_AXIS_AUTO_DT_MAX_MS = 50.0f;  // 20 Hz min
-static const float FALLBACK_DELTA_TIME        = 0.016f; // 60 Hz assumption before warmup
-
-
-
-// ----------------------------------------------------------------------------
-// Default "Feel" Parameters (normalized to 1023 ADC range)
-// ----------------------------------------------------------------------------
-
-static const float CANONICAL_MAX = 1023.0f; // Reference resolution scale
-static const float FULL_OFF_U    = 0.0f;    // No dead zone by default
-static const float FULL_ON_U     = 1023.0f; // No dead zone by default
-static const float STICKY_U      = 3.0f;    // ~0.3% magnetic zone
-static const float MAX_THRESH_U  = 30.0f;    // ~2.9% upper threshold limit
-
-// EMA convergence: 5% remaining = "settled" (Reached 95%)
-static const float EMA_CONVERGENCE_THRESHOLD = 0.05f;
-
-// Noise estimation: slow EMA for stable noise floor tracking
-static const float NOISE_SMOOTHING_RATE = 0.005f;
-
-// Dynamic threshold headroom: threshold = 3.5x noise estimate
-static const float THRESHOLD_NOISE_MULTIPLIER = 3.5f;
-
-//Prevent floor/ceiling overlap (0.5 =< would be ambiguous)
-static const float MAX_STICKY_ZONE = 0.49f;
-
-
-// ============================================================================
-// Inline Math Utilities
-// ============================================================================
-
-static inline float clamp_f(float x, float lo, float hi) {
-    return x < lo ? lo : (x > hi ? hi : x);
-}
-
-static inline float clamp_f_0_1(float x) {
-    return clamp_f(x, 0.0f, 1.0f);
-}
-
-static inline float abs_f(float x) {
-    return x < 0.0f ? -x : x;
-}
-
-// Exponential Moving Average: out = (1-α)·old + α·new
-static inline float ema(float old, float new, float alpha) {
-    return (1.0f - alpha) * old + alpha * new;
-}
-
-// Linear interpolation: map x from [in_min, in_max] to [out_min, out_max]
-static inline float map_f(float x, float in_min, float in_max, float out_min, float out_max) {
-    if (in_max == in_min) {
-        return out_min;  // Degenerate case: avoid division by zero
-    }
-    float t = (x - in_min) / (in_max - in_min);
-    return out_min + t * (out_max - out_min);
-}
-
-// Scale the threshold inversely with settle_time (longer settle times allows lower threshold)
-static inline float compute_dyn_scale(float settle_time_sec) {
-    const float t_ref = 0.1f;  // Reference settle time (100ms)
-    float       ratio = settle_time_sec / t_ref;
-    if (ratio < 1.0f) { ratio = 1.0f; }
-    return 1.0f / ratio;  // Linear inverse scaling
-}
-
-static inline float sign_of(const float residual) {
-    return (residual > 0.0f) ? 1.0f : (residual < 0.0f) ? -1.0f : 0.0f;
-}
-
-// Noise detection heuristic: true movement has consistent sign, noise flips randomly
-static inline bool has_sign_flipped(const float current, const float previous) {
-    float r_sign    = sign_of(current);
-    float last_sign = sign_of(previous);
-    return r_sign != last_sign || (r_sign == 0.0f && last_sign == 0.0f);
-}
-
+#include "smooth_axis_internal.h"
 
 // ============================================================================
 // Input Pipeline Helpers
@@ -103,154 +17,95 @@ static inline bool has_sign_flipped(const float current, const float previous) {
 
 // Apply library defaults from canonical constants (normalized to user's max_raw)
 static void set_default_config(smooth_axis_config_t *cfg, uint16_t max_raw) {
-    cfg->max_raw          = max_raw ? max_raw : 1;
+    SMOOTH_AXIS_ASSERT(SMOOTH_AXIS_MAX_RAW == 0 || max_raw == SMOOTH_AXIS_MAX_RAW,
+                       "max_raw must match the compile-time SMOOTH_AXIS_MAX_RAW");
+    cfg->max_raw          = SMOOTH_AXIS_MAX_RAW ? SMOOTH_AXIS_MAX_RAW : (max_raw ? max_raw : 1);
     cfg->full_off_norm    = clamp_f_0_1(FULL_OFF_U / CANONICAL_MAX);
     cfg->full_on_norm     = clamp_f_0_1(FULL_ON_U / CANONICAL_MAX);
-    cfg->sticky_zone_norm = clamp_f(STICKY_U / CANONICAL_MAX, 0.0f, MAX_STICKY_ZONE);
+    cfg->sticky_zone_norm = SMOOTH_AXIS_ENABLE_STICKY ? clamp_f(STICKY_U / CANONICAL_MAX, 0.0f, MAX_STICKY_ZONE) : 0.0f;
+    cfg->timer_hz         = 1000u;  // now_ms() in milliseconds
+    cfg->auto_dt_tracking = false;
+    cfg->fast_warmup      = false;  // Full 256-update warmup
+    cfg->idle_frames      = 0;      // Idle detection off
+    cfg->decimation       = 0;      // Every raw sample enters the EMA
 }
 
-// Normalize raw ADC [0..max_raw] to [0..1], with full_off/full_on dead zone clipping
-static float input_norm(const smooth_axis_t *axis, uint16_t raw_value) {
-    uint16_t max_raw = axis->cfg.max_raw;
-    if (max_raw == 0) { max_raw = 1; }  // Safety: avoid division by zero
-    
-    float norm = (float)raw_value / (float)max_raw;
-    norm = clamp_f_0_1(norm);
-    
-    float off = axis->cfg.full_off_norm;
-    float on  = axis->cfg.full_on_norm;
-    if (on <= off) {  // Degenerate config: treat as full range
-        off = 0.0f;
-        on  = 1.0f;
-    }
-    
-    // Clip to dead zones, then re-stretch to [0..1]
-    norm = clamp_f(norm, off, on);
-    norm = map_f(norm, off, on, 0.0f, 1.0f);
-    return norm;
-}
-
-
-
 // ============================================================================
 // Output Pipeline Helpers
 // ============================================================================
 
-// True if normalized delta exceeds 1 LSB in integer output (prevents sub-quantum updates)
-static bool would_change_output(const smooth_axis_t *axis, float diff) {
-    float max_raw = axis->cfg.max_raw ? (float)axis->cfg.max_raw : 1.0f;
-    float epsilon = 1.0f / max_raw;  // One LSB in normalized space
-    return diff > epsilon;
+// Any change to the smoothed state: the next read recomputes the output
+static inline void output_invalidate(smooth_axis_t *axis) {
+    axis->_out._valid = false;
 }
 
-// Dynamic threshold: scales with noise level, clamped to [1x .. 10x] of base threshold
-static float get_dynamic_threshold(const smooth_axis_t *axis) {
-    float dynamic_threshold      = THRESHOLD_NOISE_MULTIPLIER * axis->_noise_estimate_norm;
-    float settle_time_attenuated = dynamic_threshold * axis->cfg._threshold_attenuation;
-    return clamp_f(settle_time_attenuated, 0.0f, MAX_THRESH_U / CANONICAL_MAX);
+// Nominal output after smoothing + sticky zone processing
+static smooth_axis_output_t compute_output(const smooth_axis_t *axis) {
+    smooth_axis_output_t out;
+#if SMOOTH_AXIS_FIXED_POINT
+    out._norm = axis->_has_first_sample ? apply_sticky_margins_q30(&axis->_fx, axis->_smoothed_norm) : 0;
+    out._u16  = output_u16_q30(&axis->cfg, out._norm);
+#else
+    out._norm = axis->_has_first_sample ? apply_sticky_margins(&axis->cfg, axis->_smoothed_norm) : 0;
+    out._u16  = output_u16(&axis->cfg, out._norm);
+#endif
+    out._valid = true;
+    return out;
 }
 
-// Apply sticky zones: endpoints snap to exact 0.0/1.0, middle region re-stretched to [0..1]
-static float apply_sticky_margins(float axis_position, float sticky_margin_size) {
-    sticky_margin_size = clamp_f(sticky_margin_size, 0.0f, MAX_STICKY_ZONE);
-    
-    float sticky_floor   = sticky_margin_size;
-    float sticky_ceiling = 1.0f - sticky_margin_size;
-    
-    // Snap to endpoints if inside sticky zones
-    if (axis_position <= sticky_floor) { return 0.0f; }
-    if (axis_position >= sticky_ceiling) { return 1.0f; }
-    
-    // Re-stretch middle region to fill [0..1]
-    axis_position =
-            map_f(axis_position, 0.0f, 1.0f, -sticky_margin_size, 1.0f + sticky_margin_size);
-    return clamp_f_0_1(axis_position);
+// Output for this update, filling the cache (non-const paths only: has_new_value())
+static const smooth_axis_output_t *refresh_output(smooth_axis_t *axis) {
+    if (!axis->_out._valid) { axis->_out = compute_output(axis); }
+    return &axis->_out;
 }
 
-// Get nominal output after smoothing + sticky zone processing
-static float get_normalized(const smooth_axis_t *axis) {
-    if (!axis || !axis->_has_first_sample) {
-        return 0.0f;
-    }
-    return apply_sticky_margins(axis->_smoothed_norm, axis->cfg.sticky_zone_norm);
+// Output for the const getters: the cache if has_new_value() filled it since the
+// last update, else computed without writing (a const axis may be read-only)
+static inline smooth_axis_output_t read_output(const smooth_axis_t *axis) {
+    return axis->_out._valid ? axis->_out : compute_output(axis);
 }
 
+// Convert internal value representation to the public float API
+static inline float value_to_norm(smooth_axis_value_t v) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return q30_to_f(v);
+#else
+    return v;
+#endif
+}
 
-// ============================================================================
-// EMA Math
-// ============================================================================
+// Normalize raw sample into the internal value representation
+static inline smooth_axis_value_t axis_input_norm(const smooth_axis_t *axis, uint16_t raw_value) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return input_norm_q30(&axis->_fx, &axis->cfg, raw_value);
+#else
+    return input_norm(&axis->cfg, raw_value);
+#endif
+}
 
-// Compute decay rate k such that: after settle_time_sec, error reduces to 5%
-// Formula: k = ln(0.05) / settle_time  →  alpha(dt) = 1 - exp(k·dt)
-static float compute_ema_decay_rate(const float settle_time_sec) {
-    if (settle_time_sec <= 0.0f) {
-        return 0.0f;
-    }
-    // (ln(0) = NAN , ln(1) = 0 (No decay)
-    float residual = clamp_f(EMA_CONVERGENCE_THRESHOLD, 1e-4f, 0.9999f);
-    float ln_r     = logf(residual);  // negative
-    return ln_r / settle_time_sec;
-}
-
-// Convert decay rate k and time step dt into EMA alpha.
-// alpha = 1 - exp(k·dt), clamped for numerical stability
-static float get_alpha_from_dt(const float k, const float dt_sec) {
-    if (dt_sec > 0.0f && k != 0.0f) {
-        float ratio = clamp_f(k * dt_sec, -20.0f, 0.0f);  // Prevent overflow
-        return 1.0f - expf(ratio);
-    }
-    // Fallback: instant response (no smoothing)
-    // Legitimate cases: k (settle_time) = 0 , or dt=0 (first frame)
-    // Bug case: negative dt (should assert in debug)
-    SMOOTH_AXIS_ASSERT(dt_sec >= 0.0f || k == 0.0f,
-                       "negative dt is invalid");
-    return 1.0f;
+static inline bool value_sign_flipped(smooth_axis_value_t current, smooth_axis_value_t previous) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return has_sign_flipped_q(current, previous);
+#else
+    return has_sign_flipped(current, previous);
+#endif
+}
+
+static inline smooth_axis_value_t axis_dynamic_threshold(const smooth_axis_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return get_dynamic_threshold_q30(&axis->_fx, axis->_noise_estimate_norm);
+#else
+    return get_dynamic_threshold(&axis->cfg, axis->_noise_estimate_norm);
+#endif
 }
 
+
 // ============================================================================
 // Warmup (AUTO_DT Mode)
 // ============================================================================
 
-static bool is_warmup_finished(const smooth_axis_t *axis) {
-    return axis->_warmup_cycles_done >= SMOOTH_AXIS_INIT_CALIBRATION_CYCLES;
-}
-
-// Measure average dt over 256 samples, then compute fixed alpha (AUTO_DT only)
-static void auto_run_warmup_cycle_if_needed(smooth_axis_t *axis) {
-    if (is_warmup_finished(axis)) { return; }
-    
-    SMOOTH_AXIS_CHECK_RETURN(axis->cfg.now_ms != NULL, "AUTO mode requires now_ms function");
-    
-    uint32_t now_ms = axis->cfg.now_ms();
-    if (axis->_last_time_ms == 0) {
-        axis->_last_time_ms = now_ms;  // First call: just record timestamp
-        return;
-    }
-    
-    // Measure dt and accumulate
-    float dt_ms = (float)(now_ms - axis->_last_time_ms);
-    axis->_last_time_ms = now_ms;
-    dt_ms = clamp_f(dt_ms, SMOOTH_AXIS_AUTO_DT_MIN_MS, SMOOTH_AXIS_AUTO_DT_MAX_MS);
-    
-    float dt_sec = dt_ms / 1000.0f;
-    axis->_dt_accum_sec += dt_sec;
-    axis->_warmup_cycles_done++;
-    
-    
-    // Warmup complete: compute fixed alpha from average dt
-    if (is_warmup_finished(axis)) {
-        float dt_avg = axis->_dt_accum_sec / (float)axis->_warmup_cycles_done;
-        axis->_auto_alpha = get_alpha_from_dt(axis->cfg._ema_decay_rate, dt_avg);
-        
-        SMOOTH_DEBUGF("warmup complete: cycles=%u dt_avg=%.2fms alpha=%.4f",
-                      axis->_warmup_cycles_done,
-                      dt_avg * 1000.0f,
-                      axis->_auto_alpha);
-    }
-}
-
 // Set initial smoothed value from first raw sample (skip EMA on frame 0)
-static bool initialize_on_first_sample(smooth_axis_t *axis, float norm) {
+static bool initialize_on_first_sample(smooth_axis_t *axis, smooth_axis_value_t norm) {
     if (axis->_has_first_sample) {
         return false;  // Already initialized
     }
@@ -258,7 +113,7 @@ static bool initialize_on_first_sample(smooth_axis_t *axis, float norm) {
     axis->_has_first_sample = true;
     axis->_smoothed_norm    = norm;
     
-    SMOOTH_DEBUGF("first sample: norm=%.3f", norm);
+    SMOOTH_DEBUGF("first sample: norm=%.3f", value_to_norm(norm));
     return true;
 }
 
@@ -268,39 +123,188 @@ static bool initialize_on_first_sample(smooth_axis_t *axis, float norm) {
 // ============================================================================
 
 // Track noise level via sign-flip detection: noise oscillates around signal, movement is directional
-static void update_noise_estimate(smooth_axis_t *axis, const float current_residual) {
-    bool is_noise_sample = has_sign_flipped(current_residual, axis->_last_residual);
-    axis->_last_residual = current_residual;
-    
+static void update_noise_estimate(smooth_axis_t *axis, const smooth_axis_value_t current_residual) {
     /* === Sign Flip Discrimination ===
     Sign flip → likely noise (update estimate). No flip → likely movement (decay estimate). */
-    float new_sample = is_noise_sample ? abs_f(current_residual) : 0.0f;
-    
+#if SMOOTH_AXIS_FIXED_POINT
+    axis->_noise_estimate_norm = noise_step_q30(axis->_noise_estimate_norm,
+                                                current_residual,
+                                                axis->_last_residual);
+#else
+#if defined(SMOOTH_AXIS_DEBUG_ENABLE) && SMOOTH_AXIS_DEBUG_ENABLE
     float old_noise = axis->_noise_estimate_norm;
+#endif
     
-    axis->_noise_estimate_norm = ema(axis->_noise_estimate_norm, new_sample, NOISE_SMOOTHING_RATE);
-    axis->_noise_estimate_norm = clamp_f_0_1(axis->_noise_estimate_norm);
-    
+    axis->_noise_estimate_norm = noise_step(axis->_noise_estimate_norm,
+                                            current_residual,
+                                            axis->_last_residual);
     
-    // Debug: log significant noise changes
+#if defined(SMOOTH_AXIS_DEBUG_ENABLE) && SMOOTH_AXIS_DEBUG_ENABLE
+    // Debug: log significant noise changes (bookkeeping compiled out otherwise)
     float noise_change = abs_f(axis->_noise_estimate_norm - old_noise);
     if (noise_change > 0.01f) {
         SMOOTH_DEBUGF("noise: %.4f -> %.4f %s",
                       old_noise,
                       axis->_noise_estimate_norm,
-                      is_noise_sample ? "(spike)" : "(settling)");
+                      has_sign_flipped(current_residual, axis->_last_residual)
+                      ? "(spike)" : "(settling)");
     }
+#endif
+#endif
+    
+    SMOOTH_AXIS_STAT(stats_ema_step(&axis->_stats,
+                                    value_sign_flipped(current_residual, axis->_last_residual)));
+    axis->_last_residual = current_residual;
 }
 
-// Apply EMA smoothing + update noise estimate
-static void update_core(smooth_axis_t *axis, uint16_t raw_value, float alpha) {
-    float norm = input_norm(axis, raw_value);
+// ============================================================================
+// Idle Detection (cfg.idle_frames > 0)
+// ============================================================================
+
+static void idle_init(smooth_axis_idle_t *idle) {
+    idle->_quiet_frames = 0;
+    idle->_raw_lo       = 0;
+    idle->_raw_hi       = 0;
+    idle->_active       = false;
+    idle->_residual_sum = 0;
+}
+
+// Residual magnitude that still counts as "not moving": 8x noise, at least one raw step
+static inline smooth_axis_value_t idle_band(const smooth_axis_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    int64_t band = (int64_t)axis->_noise_estimate_norm * IDLE_NOISE_MULTIPLIER;
+    int32_t step = (int32_t)(((int64_t)256 * axis->_fx._in_gain) >> axis->_fx._in_shift);
+    return band > step ? (band > Q30_ONE ? Q30_ONE : (int32_t)band) : step;
+#else
+    float band = (float)IDLE_NOISE_MULTIPLIER * axis->_noise_estimate_norm;
+    float step = axis->cfg._map._in_scale;
+    return band > step ? band : step;
+#endif
+}
+
+// True if the mean residual of the quiet run is within one output LSB. A step smaller
+// than the noise band is quiet from its first frame while the EMA still closes on it:
+// its residuals share a sign, and freezing then would hold the output off target.
+static inline bool idle_settled(const smooth_axis_t *axis) {
+    const smooth_axis_idle_t *idle = &axis->_idle;
+#if SMOOTH_AXIS_FIXED_POINT
+    int64_t sum = idle->_residual_sum < 0 ? -idle->_residual_sum : idle->_residual_sum;
+    return sum * cfg_max_raw(&axis->cfg) <= (int64_t)idle->_quiet_frames * Q30_ONE;
+#else
+    float sum = idle->_residual_sum < 0 ? -idle->_residual_sum : idle->_residual_sum;
+    return sum <= (float)idle->_quiet_frames * axis->cfg._map._lsb_norm;
+#endif
+}
+
+// Count quiet updates and the raw range they cover; go idle after cfg.idle_frames of them
+static void idle_track(smooth_axis_t *axis, uint16_t raw_value, smooth_axis_value_t diff) {
+    smooth_axis_idle_t *idle = &axis->_idle;
+    
+    if ((diff < 0 ? -diff : diff) > idle_band(axis)) {
+        idle->_quiet_frames = 0;
+        return;
+    }
+    if (idle->_quiet_frames == 0) {
+        idle->_raw_lo       = raw_value;
+        idle->_raw_hi       = raw_value;
+        idle->_residual_sum = 0;
+    } else if (raw_value < idle->_raw_lo) {
+        idle->_raw_lo = raw_value;
+    } else if (raw_value > idle->_raw_hi) {
+        idle->_raw_hi = raw_value;
+    }
+    idle->_residual_sum += diff;
+    
+    if (++idle->_quiet_frames >= axis->cfg.idle_frames) {
+        if (!idle_settled(axis)) {  // Still converging: start a new quiet run
+            idle->_quiet_frames = 0;
+            return;
+        }
+        // Widen by a quarter of the range (+1 step): noise tails beyond what the quiet
+        // frames happened to show must not wake the axis
+        uint16_t margin = (uint16_t)(1u + (uint16_t)(idle->_raw_hi - idle->_raw_lo) / 4u);
+        idle->_raw_lo   = idle->_raw_lo > margin ? (uint16_t)(idle->_raw_lo - margin) : 0;
+        idle->_raw_hi   = idle->_raw_hi < UINT16_MAX - margin
+                        ? (uint16_t)(idle->_raw_hi + margin) : UINT16_MAX;
+        idle->_active = true;
+        SMOOTH_DEBUGF("idle: window [%u .. %u]", idle->_raw_lo, idle->_raw_hi);
+    }
+}
+
+// Idle fast path: true if the sample is inside the wake window (skip all filter work)
+static inline bool idle_hold(smooth_axis_t *axis, uint16_t raw_value) {
+    smooth_axis_idle_t *idle = &axis->_idle;
+    
+    if (!idle->_active) { return false; }
+    if (raw_value >= idle->_raw_lo && raw_value <= idle->_raw_hi) { return true; }
+    
+    idle->_active       = false;  // Real movement: wake and process this sample
+    idle->_quiet_frames = 0;
+    SMOOTH_DEBUGF("idle: wake on raw=%u", raw_value);
+    return false;
+}
+
+// ============================================================================
+// Oversampling Front-End (cfg.decimation >= 2)
+// ============================================================================
+
+static void decim_init(smooth_axis_decim_t *d) {
+    d->_sum    = 0;
+    d->_dt_sum = 0.0f;
+    d->_count  = 0;
+}
+
+// Boxcar (first-order CIC) accumulate: true once cfg.decimation samples are summed.
+// 255 x 65535 fits the 32-bit sum with 8 bits to spare for the Q8 mean.
+static inline bool decim_push(smooth_axis_t *axis, uint16_t raw_value, float dt_sec) {
+    smooth_axis_decim_t *d       = &axis->_decim;
+    uint16_t             max_raw = cfg_max_raw(&axis->cfg);
+    
+    d->_sum    += raw_value > max_raw ? max_raw : raw_value;  // Clip as input_norm() would
+    d->_dt_sum += dt_sec;
+    return ++d->_count >= axis->cfg.decimation;
+}
+
+// Mean of the finished block, normalized with its fraction kept; clears the accumulator.
+// Also returns the mean rounded to raw units (idle window) and the block's dt.
+static smooth_axis_value_t decim_take(smooth_axis_t *axis, uint16_t *mean_raw, float *dt_sec) {
+    smooth_axis_decim_t *d = &axis->_decim;
+    uint32_t             n = d->_count;
+    
+#if SMOOTH_AXIS_FIXED_POINT
+    smooth_axis_value_t norm = input_norm_q30_q8(&axis->_fx, (int32_t)(((d->_sum << 8) + n / 2) / n));
+#else
+    smooth_axis_value_t norm = input_norm_frac(&axis->cfg, (float)d->_sum / (float)n);
+#endif
+    *mean_raw = (uint16_t)((d->_sum + n / 2) / n);
+    *dt_sec   = d->_dt_sum;
+    decim_init(d);
+    return norm;
+}
+
+
+// ============================================================================
+// EMA Step
+// ============================================================================
+
+// Apply EMA smoothing + update noise estimate (raw_value feeds idle tracking)
+static void update_core(smooth_axis_t *axis,
+                        smooth_axis_value_t norm,
+                        uint16_t raw_value,
+                        smooth_axis_value_t alpha) {
+    output_invalidate(axis);
     if (initialize_on_first_sample(axis, norm)) { return; }
     
-    float diff = norm - axis->_smoothed_norm;
+    smooth_axis_value_t diff = norm - axis->_smoothed_norm;
+#if SMOOTH_AXIS_FIXED_POINT
+    axis->_smoothed_norm += q30_mul(alpha, diff); // EMA: x += α·(target - x)
+#else
     axis->_smoothed_norm += alpha * diff; // EMA: x += α·(target - x)
+#endif
     
     update_noise_estimate(axis, diff);
+    
+    if (axis->cfg.idle_frames) { idle_track(axis, raw_value, diff); }
 }
 
 
@@ -321,6 +325,8 @@ void smooth_axis_config_auto_dt(smooth_axis_config_t *cfg,
     cfg->now_ms                 = now_ms;
     cfg->_ema_decay_rate        = compute_ema_decay_rate(settle_time_sec);
     cfg->_threshold_attenuation = compute_dyn_scale(settle_time_sec);
+    map_coeffs_init(cfg);
+    alpha_lut_build(cfg);
 }
 
 void smooth_axis_config_live_dt(smooth_axis_config_t *cfg,
@@ -333,6 +339,8 @@ void smooth_axis_config_live_dt(smooth_axis_config_t *cfg,
     cfg->settle_time_sec        = settle_time_sec;
     cfg->_ema_decay_rate        = compute_ema_decay_rate(settle_time_sec);
     cfg->_threshold_attenuation = compute_dyn_scale(settle_time_sec);
+    map_coeffs_init(cfg);
+    alpha_lut_build(cfg);
 }
 
 void smooth_axis_init(smooth_axis_t *axis, const smooth_axis_config_t *cfg) {
@@ -340,18 +348,38 @@ void smooth_axis_init(smooth_axis_t *axis, const smooth_axis_config_t *cfg) {
     SMOOTH_AXIS_CHECK_RETURN(cfg != NULL, "config is NULL");
     SMOOTH_AXIS_CHECK_RETURN(cfg->mode != SMOOTH_AXIS_MODE_AUTO_DT || cfg->now_ms != NULL,
                              "AUTO mode requires now_ms function");
+#if !SMOOTH_AXIS_ENABLE_LIVE_DT
+    SMOOTH_AXIS_CHECK_RETURN(cfg->mode == SMOOTH_AXIS_MODE_AUTO_DT,
+                             "LIVE_DT is compiled out (SMOOTH_AXIS_ENABLE_LIVE_DT 0)");
+#endif
     
     axis->cfg                  = *cfg;
-    axis->_smoothed_norm       = 0.0f;
-    axis->_noise_estimate_norm = 0.01f;  // Initial noise floor estimate
-    axis->_last_reported_norm  = 0.0f;
-    // 60 Hz assumption until warmup
-    axis->_auto_alpha          = get_alpha_from_dt(cfg->_ema_decay_rate, FALLBACK_DELTA_TIME);
-    axis->_dt_accum_sec        = 0.0f;
-    axis->_warmup_cycles_done  = 0;
-    axis->_last_time_ms        = 0;
-    axis->_last_residual       = 0.0f;
+    map_coeffs_init(&axis->cfg);  // Pick up feel edits made after smooth_axis_config_*()
+    axis->_smoothed_norm       = 0;
+    axis->_last_reported_norm  = 0;
+    axis->_last_residual       = 0;
     axis->_has_first_sample    = false;
+    warmup_init(&axis->_warmup, cfg);
+#if SMOOTH_AXIS_ENABLE_LIVE_DT
+    alpha_cache_init(&axis->_live_alpha);
+#endif
+    idle_init(&axis->_idle);
+    decim_init(&axis->_decim);
+    output_invalidate(axis);
+    SMOOTH_AXIS_STAT(stats_clear(&axis->_stats));
+#if SMOOTH_AXIS_FIXED_POINT
+    fixed_coeffs_init(&axis->_fx, cfg);
+#if SMOOTH_AXIS_ENABLE_LIVE_DT
+    axis->_fx._alpha_q30       = q30_from_f(cfg->mode == SMOOTH_AXIS_MODE_LIVE_DT
+                                            ? axis->_live_alpha._alpha
+                                            : axis->_warmup._auto_alpha);
+#else
+    axis->_fx._alpha_q30       = q30_from_f(axis->_warmup._auto_alpha);
+#endif
+    axis->_noise_estimate_norm = q30_from_f(INITIAL_NOISE_NORM);
+#else
+    axis->_noise_estimate_norm = INITIAL_NOISE_NORM;
+#endif
     
     SMOOTH_DEBUGF("init: mode=%s max_raw=%u settle_time=%.3fs",
                   cfg->mode == SMOOTH_AXIS_MODE_AUTO_DT ? "AUTO_DT" : "LIVE_DT",
@@ -362,13 +390,31 @@ void smooth_axis_init(smooth_axis_t *axis, const smooth_axis_config_t *cfg) {
 void smooth_axis_reset(smooth_axis_t *axis, uint16_t raw_value) {
     SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
     
-    float norm = raw_value ? input_norm(axis, raw_value) : 0.0f;
+    smooth_axis_value_t norm = raw_value ? axis_input_norm(axis, raw_value) : 0;
     
     axis->_smoothed_norm       = norm;
-    axis->_noise_estimate_norm = 0.01f;
+#if SMOOTH_AXIS_FIXED_POINT
+    axis->_noise_estimate_norm = q30_from_f(INITIAL_NOISE_NORM);
+#else
+    axis->_noise_estimate_norm = INITIAL_NOISE_NORM;
+#endif
     axis->_last_reported_norm  = norm;
-    axis->_last_residual       = 0.0f;
+    axis->_last_residual       = 0;
     axis->_has_first_sample    = raw_value ? true : false;
+    idle_init(&axis->_idle);
+    decim_init(&axis->_decim);
+    output_invalidate(axis);
+}
+
+void smooth_axis_seed_auto_dt(smooth_axis_t *axis, float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(axis->cfg.mode == SMOOTH_AXIS_MODE_AUTO_DT,
+                             "seed_auto_dt() requires AUTO_DT mode");
+    
+    warmup_seed(&axis->_warmup, &axis->cfg, dt_sec);
+#if SMOOTH_AXIS_FIXED_POINT
+    axis->_fx._alpha_q30 = q30_from_f(axis->_warmup._auto_alpha);
+#endif
 }
 
 
@@ -376,97 +422,422 @@ void smooth_axis_reset(smooth_axis_t *axis, uint16_t raw_value) {
 // Public API - Update
 // ============================================================================
 
+// AUTO_DT input stage (decimation). False while a block is still collecting.
+static inline bool auto_dt_input(smooth_axis_t *axis, uint16_t *raw_value, smooth_axis_value_t *norm) {
+    if (axis->cfg.decimation > 1) {
+        // Warmup then times decimated samples, so alpha is for N·dt
+        if (!decim_push(axis, *raw_value, 0.0f)) { return false; }
+        float unused_dt;
+        *norm = decim_take(axis, raw_value, &unused_dt);
+    } else {
+        *norm = axis_input_norm(axis, *raw_value);
+    }
+    return true;
+}
+
+// Timebase work on the axis' own warmup. Returns true when alpha changed.
+static inline bool auto_dt_timebase(smooth_axis_t *axis) {
+    if (!auto_dt_step(&axis->_warmup, &axis->cfg)) { return false; }  // Warmup end / tracking
+#if SMOOTH_AXIS_FIXED_POINT
+    axis->_fx._alpha_q30 = q30_from_f(axis->_warmup._auto_alpha);
+#endif
+    SMOOTH_AXIS_STAT(stats_dt(&axis->_stats, warmup_dt_sec(&axis->_warmup)));
+    return true;
+}
+
+// AUTO_DT filter step at the current fixed alpha
+static inline void auto_dt_apply(smooth_axis_t *axis, uint16_t raw_value, smooth_axis_value_t norm) {
+    if (idle_hold(axis, raw_value)) { return; }  // Timer kept running: dt stays valid
+#if SMOOTH_AXIS_FIXED_POINT
+    update_core(axis, norm, raw_value, axis->_fx._alpha_q30);  // Fixed alpha after warmup
+#else
+    update_core(axis, norm, raw_value, axis->_warmup._auto_alpha);  // Fixed alpha after warmup
+#endif
+}
+
+// Group member: take over the leader's calibrated timebase. A member with its own
+// settle time or decimation gets the alpha for its own decay rate and N·dt.
+static void auto_dt_adopt(smooth_axis_t *axis, const smooth_axis_t *lead) {
+    axis->_warmup = lead->_warmup;
+
+    float lead_n = lead->cfg.decimation > 1 ? (float)lead->cfg.decimation : 1.0f;
+    float n      = axis->cfg.decimation > 1 ? (float)axis->cfg.decimation : 1.0f;
+    if (n != lead_n || axis->cfg._ema_decay_rate != lead->cfg._ema_decay_rate) {
+        warmup_restore(&axis->_warmup, &axis->cfg, warmup_dt_sec(&lead->_warmup) * n / lead_n);
+    }
+#if SMOOTH_AXIS_FIXED_POINT
+    axis->_fx._alpha_q30 = q30_from_f(axis->_warmup._auto_alpha);
+#endif
+    SMOOTH_AXIS_STAT(stats_dt(&axis->_stats, warmup_dt_sec(&axis->_warmup)));
+}
+
 void smooth_axis_update_auto_dt(smooth_axis_t *axis, uint16_t raw_value) {
     SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
     SMOOTH_AXIS_CHECK_RETURN(axis->cfg.mode == SMOOTH_AXIS_MODE_AUTO_DT,
                              "wrong mode: use update_live_dt() for LIVE_DT mode");
+    SMOOTH_AXIS_STAT(axis->_stats.updates++);
+    
+    smooth_axis_value_t norm;
+    if (!auto_dt_input(axis, &raw_value, &norm)) { return; }
+    (void)auto_dt_timebase(axis);
+    auto_dt_apply(axis, raw_value, norm);
+}
+
+void smooth_axis_update_auto_dt_group(smooth_axis_t *axes, const uint16_t *raw, size_t n) {
+    SMOOTH_AXIS_CHECK_RETURN(axes != NULL && raw != NULL, "axes or raw is NULL");
+    for (size_t i = 0; i < n; i++) {
+        SMOOTH_AXIS_CHECK_RETURN(axes[i].cfg.mode == SMOOTH_AXIS_MODE_AUTO_DT,
+                                 "wrong mode: every group member must be AUTO_DT");
+    }
     
-    auto_run_warmup_cycle_if_needed(axis);
+    // axes[0] carries the group timebase: one timer read per call, not per axis
+    bool adopt = false;
+    for (size_t i = 0; i < n; i++) {
+        smooth_axis_t      *axis      = &axes[i];
+        uint16_t            raw_value = raw[i];
+        smooth_axis_value_t norm;
+        SMOOTH_AXIS_STAT(axis->_stats.updates++);
+        
+        bool ready = auto_dt_input(axis, &raw_value, &norm);
+        if (i == 0) {
+            adopt = ready && auto_dt_timebase(axis);
+        } else if (adopt) {
+            auto_dt_adopt(axis, &axes[0]);  // Warmup end / tracking step: broadcast
+        }
+        if (ready) { auto_dt_apply(axis, raw_value, norm); }
+    }
+}
+
+#if SMOOTH_AXIS_ENABLE_LIVE_DT
+// LIVE_DT filter step on one (possibly decimated) sample
+static void live_dt_core(smooth_axis_t *axis,
+                         smooth_axis_value_t norm,
+                         uint16_t raw_value,
+                         float dt_sec) {
+    if (idle_hold(axis, raw_value)) { return; }
     
-    update_core(axis, raw_value, axis->_auto_alpha);  // Fixed alpha after warmup
+#if SMOOTH_AXIS_FIXED_POINT
+    if (alpha_cache_refresh(&axis->_live_alpha, &axis->cfg, dt_sec)) {
+        axis->_fx._alpha_q30 = q30_from_f(axis->_live_alpha._alpha);  // Only when dt changes
+        SMOOTH_AXIS_STAT(stats_dt(&axis->_stats, dt_sec));
+    }
+    update_core(axis, norm, raw_value, axis->_fx._alpha_q30);
+#else
+    if (alpha_cache_refresh(&axis->_live_alpha, &axis->cfg, dt_sec)) {  // Skipped at steady dt
+        SMOOTH_AXIS_STAT(stats_dt(&axis->_stats, dt_sec));
+    }
+    update_core(axis, norm, raw_value, axis->_live_alpha._alpha);
+#endif
+}
+
+// Finished decimation block -> one filter step spanning the block's dt
+static void live_dt_emit(smooth_axis_t *axis) {
+    uint16_t            mean_raw;
+    float               block_dt;
+    smooth_axis_value_t norm = decim_take(axis, &mean_raw, &block_dt);
+    live_dt_core(axis, norm, mean_raw, block_dt);
 }
 
 void smooth_axis_update_live_dt(smooth_axis_t *axis, uint16_t raw_value, float dt_sec) {
     SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
     SMOOTH_AXIS_CHECK_RETURN(axis->cfg.mode == SMOOTH_AXIS_MODE_LIVE_DT,
                              "wrong mode: use update_auto_dt() for AUTO_DT mode");
+    SMOOTH_AXIS_STAT(axis->_stats.updates++);
+    
+    if (axis->cfg.decimation > 1) {
+        if (decim_push(axis, raw_value, dt_sec)) { live_dt_emit(axis); }
+        return;
+    }
+    live_dt_core(axis, axis_input_norm(axis, raw_value), raw_value, dt_sec);
+}
+
+void smooth_axis_update_block(smooth_axis_t *axis,
+                              const uint16_t *samples,
+                              size_t n,
+                              float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(samples != NULL || n == 0, "samples is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(axis->cfg.mode == SMOOTH_AXIS_MODE_LIVE_DT,
+                             "wrong mode: update_block() requires LIVE_DT mode");
+    if (n == 0) { return; }
+    SMOOTH_AXIS_STAT(axis->_stats.updates += (uint32_t)n);
+    
+    if (axis->cfg.decimation > 1) {  // Fill the accumulator in runs; the EMA runs once per N
+        smooth_axis_decim_t *d       = &axis->_decim;
+        uint16_t             max_raw = cfg_max_raw(&axis->cfg);
+        size_t               k       = 0;
+        while (k < n) {
+            size_t   run    = axis->cfg.decimation - d->_count;
+            uint32_t sum    = 0;
+            float    dt_sum = d->_dt_sum;
+            if (run > n - k) { run = n - k; }
+            for (size_t j = 0; j < run; j++) {
+                uint16_t raw = samples[k + j];
+                sum    += raw > max_raw ? max_raw : raw;
+                dt_sum += dt_sec;  // Same summation order as per-sample decim_push()
+            }
+            d->_sum    += sum;
+            d->_dt_sum  = dt_sum;
+            d->_count   = (uint8_t)(d->_count + run);
+            k          += run;
+            if (d->_count >= axis->cfg.decimation) { live_dt_emit(axis); }
+        }
+        return;
+    }
+    
+    // Uniform spacing: one alpha for the whole block
+#if SMOOTH_AXIS_FIXED_POINT
+    if (alpha_cache_refresh(&axis->_live_alpha, &axis->cfg, dt_sec)) {
+        axis->_fx._alpha_q30 = q30_from_f(axis->_live_alpha._alpha);
+        SMOOTH_AXIS_STAT(stats_dt(&axis->_stats, dt_sec));
+    }
+    const smooth_axis_value_t alpha = axis->_fx._alpha_q30;
+#else
+    if (alpha_cache_refresh(&axis->_live_alpha, &axis->cfg, dt_sec)) {
+        SMOOTH_AXIS_STAT(stats_dt(&axis->_stats, dt_sec));
+    }
+    const smooth_axis_value_t alpha = axis->_live_alpha._alpha;
+#endif
+    
+    if (axis->cfg.idle_frames) {  // Per-sample hold / idle tracking, as n single updates would
+        for (size_t k = 0; k < n; k++) {
+            if (!idle_hold(axis, samples[k])) {
+                update_core(axis, axis_input_norm(axis, samples[k]), samples[k], alpha);
+            }
+        }
+        return;
+    }
+    
+    output_invalidate(axis);
+    size_t i = 0;
+    if (initialize_on_first_sample(axis, axis_input_norm(axis, samples[0]))) { i = 1; }
+    
+    // Same per-sample math as update_core(), with the state held in locals
+    smooth_axis_value_t smoothed = axis->_smoothed_norm;
+    smooth_axis_value_t noise    = axis->_noise_estimate_norm;
+    smooth_axis_value_t residual = axis->_last_residual;
+    
+    for (; i < n; i++) {
+        smooth_axis_value_t diff = axis_input_norm(axis, samples[i]) - smoothed;
+#if SMOOTH_AXIS_FIXED_POINT
+        smoothed += q30_mul(alpha, diff);
+        noise     = noise_step_q30(noise, diff, residual);
+#else
+        smoothed += alpha * diff;
+        noise     = noise_step(noise, diff, residual);
+#endif
+        SMOOTH_AXIS_STAT(stats_ema_step(&axis->_stats, value_sign_flipped(diff, residual)));
+        residual = diff;
+    }
     
-    float live_alpha = get_alpha_from_dt(axis->cfg._ema_decay_rate,
-                                         dt_sec); // Recompute alpha each frame
-    update_core(axis, raw_value, live_alpha);
+    axis->_smoothed_norm       = smoothed;
+    axis->_noise_estimate_norm = noise;
+    axis->_last_residual       = residual;
 }
+#endif // SMOOTH_AXIS_ENABLE_LIVE_DT
 
 // ============================================================================
 // Public API - Output & Query
 // ============================================================================
 
 float smooth_axis_get_norm(const smooth_axis_t *axis) {
-    return get_normalized(axis);
+    SMOOTH_AXIS_GUARD_VAL(axis != NULL, 0.0f);
+    return value_to_norm(read_output(axis)._norm);
 }
 
 uint16_t smooth_axis_get_u16(const smooth_axis_t *axis) {
-    if (!axis) { return 0; }
-    
-    float max_out = (float)axis->cfg.max_raw;
-    float n       = get_normalized(axis);
-    
-    // Ensure exact 0 and max_raw at endpoints (prevent off-by-one from floating point rounding)
-    if (n <= 1.0f / max_out) { return 0; }
-    if (n >= (max_out - 1.0) / max_out) { return axis->cfg.max_raw; }
-    
-    return (uint16_t)lroundf(n * (float)max_out);
+    SMOOTH_AXIS_GUARD_VAL(axis != NULL, 0);
+    return read_output(axis)._u16;
 }
 
 bool smooth_axis_has_new_value(smooth_axis_t *axis) {
     SMOOTH_AXIS_CHECK_RETURN_VAL(axis != NULL, "axis is NULL", false);
     if (!axis->_has_first_sample) { return false; }
     
-    float current = get_normalized(axis);
-    float diff    = abs_f(current - axis->_last_reported_norm);
-    
-    if (!would_change_output(axis, diff)) { return false; }
-    
-    // When approaching to the edges, we treat each movement (>= epsilon) as 'Always Important'
-    float sticky_ceil   = 1 - axis->cfg.sticky_zone_norm;
-    float sticky_floor  = axis->cfg.sticky_zone_norm;
-    bool in_sticky_zone = (current < sticky_floor) || (current > sticky_ceil);
-    
-    float dynamic_threshold = get_dynamic_threshold(axis);  // Scales 1x-10x with noise
-    
-    if (in_sticky_zone || diff > dynamic_threshold) {
-        axis->_last_reported_norm = current;
-        
-        SMOOTH_DEBUGF("new value: %.3f (diff=%.4f thresh=%.4f %s)",
-                      current,
-                      diff,
-                      dynamic_threshold,
-                      in_sticky_zone ? "sticky" : "normal");
-        return true;
-    }
-    return false;
+#if SMOOTH_AXIS_FIXED_POINT
+    report_kind_t kind = report_decide_q30(&axis->_fx,
+                                           &axis->cfg,
+                                           refresh_output(axis)->_norm,
+                                           axis->_noise_estimate_norm,
+                                           &axis->_last_reported_norm);
+#else
+    report_kind_t kind = report_decide(&axis->cfg,
+                                       refresh_output(axis)->_norm,
+                                       axis->_noise_estimate_norm,
+                                       &axis->_last_reported_norm);
+#endif
+    SMOOTH_AXIS_STAT(stats_report(&axis->_stats, kind));
+    return kind >= REPORT_STICKY;
+}
+
+float smooth_axis_get_auto_dt_sec(const smooth_axis_t *axis) {
+    SMOOTH_AXIS_GUARD_VAL(axis != NULL, 0.0f);
+    return warmup_dt_sec(&axis->_warmup);
+}
+
+bool smooth_axis_is_idle(const smooth_axis_t *axis) {
+    SMOOTH_AXIS_GUARD_VAL(axis != NULL, false);
+    return axis->_idle._active;
 }
 
 // ============================================================================
 // Public API - Introspection / diagnostics
 // ============================================================================
 
+#if SMOOTH_AXIS_ENABLE_DIAGNOSTICS
 float smooth_axis_get_noise_norm(const smooth_axis_t *axis) {
-    return axis ? axis->_noise_estimate_norm : 0.0f;
+    return axis ? value_to_norm(axis->_noise_estimate_norm) : 0.0f;
 }
 
 float smooth_axis_get_effective_thresh_norm(const smooth_axis_t *axis) {
-    return axis ? get_dynamic_threshold(axis) : 0.0f;
+    return axis ? value_to_norm(axis_dynamic_threshold(axis)) : 0.0f;
 }
 
 uint16_t smooth_axis_get_effective_thresh_u16(const smooth_axis_t *axis) {
-    if (!axis || axis->cfg.max_raw == 0) {
+    if (!axis) {
         return 0;
     }
-    float threshold_norm = get_dynamic_threshold(axis);
-    if (threshold_norm <= 0.0f) {
+    uint16_t max_raw = cfg_max_raw(&axis->cfg);
+    smooth_axis_value_t threshold_norm = axis_dynamic_threshold(axis);
+    if (threshold_norm <= 0) {
         return 0;
     }
-    float threshold_scaled = threshold_norm * (float)axis->cfg.max_raw + 0.5f; // Round to nearest
-    threshold_scaled = clamp_f(threshold_scaled, 0.0f, (float)axis->cfg.max_raw);
+#if SMOOTH_AXIS_FIXED_POINT
+    int64_t threshold_scaled = ((int64_t)threshold_norm * max_raw + Q30_HALF) >> 30;
+    return (uint16_t)(threshold_scaled > max_raw ? max_raw : threshold_scaled);
+#else
+    float threshold_scaled = threshold_norm * (float)max_raw + 0.5f; // Round to nearest
+    threshold_scaled = clamp_f(threshold_scaled, 0.0f, (float)max_raw);
     return (uint16_t)threshold_scaled;
+#endif
+}
+#endif // SMOOTH_AXIS_ENABLE_DIAGNOSTICS
+
+
+// ============================================================================
+// Public API - Instrumentation
+// ============================================================================
+
+void smooth_axis_get_stats(const smooth_axis_t *axis, smooth_axis_stats_t *out) {
+    SMOOTH_AXIS_CHECK_RETURN(out != NULL, "stats output is NULL");
+    stats_clear(out);
+#if SMOOTH_AXIS_STATS
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    *out = axis->_stats;
+#else
+    (void)axis;
+#endif
+}
+
+void smooth_axis_reset_stats(smooth_axis_t *axis) {
+#if SMOOTH_AXIS_STATS
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    stats_clear(&axis->_stats);
+#else
+    (void)axis;
+#endif
+}
+
+
+// ============================================================================
+// Public API - Snapshot / restore
+// ============================================================================
+
+enum {
+  SNAPSHOT_FIRST_SAMPLE  = 0x01,
+  SNAPSHOT_RESIDUAL_POS  = 0x02,
+  SNAPSHOT_RESIDUAL_NEG  = 0x04,
+  SNAPSHOT_CHECK_SEED    = 0x5A,
+};
+
+#if !SMOOTH_AXIS_FIXED_POINT
+static const float SNAPSHOT_NOISE_SCALE = 1048576.0f;  // 2^20
+#endif
+
+// Position [0 .. 1] <-> 1/65535 units
+static uint16_t snapshot_pack_pos(smooth_axis_value_t v) {
+#if SMOOTH_AXIS_FIXED_POINT
+    int64_t u = ((int64_t)v * 65535 + Q30_HALF) >> 30;
+#else
+    long u = lroundf(v * 65535.0f);
+#endif
+    return (uint16_t)(u < 0 ? 0 : (u > 65535 ? 65535 : u));
+}
+
+static smooth_axis_value_t snapshot_unpack_pos(uint16_t u) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return (int32_t)((((int64_t)u << 30) + 32767) / 65535);
+#else
+    return (float)u * (1.0f / 65535.0f);
+#endif
+}
+
+static uint8_t snapshot_checksum(const smooth_axis_snapshot_t *snap) {
+    const unsigned char *bytes = (const unsigned char *)snap;
+    uint8_t              sum   = SNAPSHOT_CHECK_SEED;
+    for (size_t i = 0; i < offsetof(smooth_axis_snapshot_t, _check); i++) {
+        sum = (uint8_t)((sum << 1 | sum >> 7) ^ bytes[i]);  // Rotate-xor: catches swapped bytes
+    }
+    return sum;
+}
+
+void smooth_axis_save(const smooth_axis_t *axis, smooth_axis_snapshot_t *snap) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(snap != NULL, "snapshot is NULL");
+    
+#if SMOOTH_AXIS_FIXED_POINT
+    int32_t noise = (axis->_noise_estimate_norm + 512) >> 10;  // Q30 -> 2^-20 units
+#else
+    long noise = lroundf(axis->_noise_estimate_norm * SNAPSHOT_NOISE_SCALE);
+#endif
+    uint8_t flags = axis->_has_first_sample ? SNAPSHOT_FIRST_SAMPLE : 0;
+    if (axis->_last_residual > 0) { flags |= SNAPSHOT_RESIDUAL_POS; }
+    if (axis->_last_residual < 0) { flags |= SNAPSHOT_RESIDUAL_NEG; }
+    
+    snap->_dt_sec   = axis->cfg.mode == SMOOTH_AXIS_MODE_AUTO_DT
+                      ? warmup_dt_sec(&axis->_warmup) : 0.0f;
+    snap->_smoothed = snapshot_pack_pos(axis->_smoothed_norm);
+    snap->_reported = snapshot_pack_pos(axis->_last_reported_norm);
+    snap->_noise    = (uint16_t)(noise > 65535 ? 65535 : noise);
+    snap->_flags    = flags;
+    snap->_check    = snapshot_checksum(snap);
+}
+
+bool smooth_axis_restore(smooth_axis_t *axis, const smooth_axis_snapshot_t *snap) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(axis != NULL, "axis is NULL", false);
+    SMOOTH_AXIS_CHECK_RETURN_VAL(snap != NULL, "snapshot is NULL", false);
+    if (snap->_check != snapshot_checksum(snap)) {
+        SMOOTH_DEBUG("restore: checksum mismatch, state unchanged");
+        return false;
+    }
+    
+    // Only the residual's sign feeds the next sign-flip test
+#if SMOOTH_AXIS_FIXED_POINT
+    const smooth_axis_value_t residual_unit = 1;
+    axis->_noise_estimate_norm = (int32_t)snap->_noise << 10;
+#else
+    const smooth_axis_value_t residual_unit = 1.0f / SNAPSHOT_NOISE_SCALE;
+    axis->_noise_estimate_norm = (float)snap->_noise * (1.0f / SNAPSHOT_NOISE_SCALE);
+#endif
+    axis->_smoothed_norm      = snapshot_unpack_pos(snap->_smoothed);
+    axis->_last_reported_norm = snapshot_unpack_pos(snap->_reported);
+    axis->_has_first_sample   = (snap->_flags & SNAPSHOT_FIRST_SAMPLE) != 0;
+    axis->_last_residual      = (snap->_flags & SNAPSHOT_RESIDUAL_POS) ? residual_unit
+                              : (snap->_flags & SNAPSHOT_RESIDUAL_NEG) ? -residual_unit : 0;
+    idle_init(&axis->_idle);
+    decim_init(&axis->_decim);
+    output_invalidate(axis);
+    
+    if (axis->cfg.mode == SMOOTH_AXIS_MODE_AUTO_DT && snap->_dt_sec > 0.0f) {
+        warmup_restore(&axis->_warmup, &axis->cfg, snap->_dt_sec);
+#if SMOOTH_AXIS_FIXED_POINT
+        axis->_fx._alpha_q30 = q30_from_f(axis->_warmup._auto_alpha);
+#endif
+    }
+    
+    SMOOTH_DEBUGF("restore: norm=%.4f noise=%.5f dt=%.3fms",
+                  value_to_norm(axis->_smoothed_norm),
+                  value_to_norm(axis->_noise_estimate_norm),
+                  snap->_dt_sec * 1000.0f);
+    return true;
 }
@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -67,11 +68,16 @@ typedef enum {
 } smooth_axis_mode_t;
 
 /**
- * @brief Monotonic millisecond timer function (for AUTO_DT mode)
+ * @brief Monotonic timer function (for AUTO_DT mode)
  *
- * @return Current time in milliseconds (must be monotonically increasing)
+ * @return Current time in timer ticks (must be monotonically increasing,
+ *         wrapping at 2^32 is fine). Milliseconds by default; set
+ *         smooth_axis_config_t::timer_hz for a microsecond or cycle counter.
  *
  * @note Required for SMOOTH_AXIS_MODE_AUTO_DT, ignored for LIVE_DT
+ * @note At loop rates near or above 1 kHz a millisecond timer can only measure
+ *       the warmup average to about one tick per 256 frames; prefer micros() or
+ *       a cycle counter there.
  *
  * Example (QMK):
  * @code
@@ -84,9 +90,136 @@ typedef enum {
  * uint32_t arduino_now_ms(void) { return millis(); }
  * smooth_axis_config_auto_dt(&cfg, 1023, 0.25f, arduino_now_ms);
  * @endcode
+ *
+ * Example (Cortex-M cycle counter, 10 kHz loop):
+ * @code
+ * uint32_t dwt_now(void) { return DWT->CYCCNT; }
+ * smooth_axis_config_auto_dt(&cfg, 4095, 0.05f, dwt_now);
+ * cfg.timer_hz = SystemCoreClock;
+ * @endcode
  */
 typedef uint32_t (*smooth_axis_now_ms_fn)(void);
 
+/**
+ * @brief Build profile: feature defaults for a size- or speed-first build (build option)
+ *
+ *   SMOOTH_AXIS_PROFILE_FULL   every feature (default)
+ *   SMOOTH_AXIS_PROFILE_SIZE   minimal flash: the SMOOTH_AXIS_ENABLE_* features
+ *                              below default to 0 and the alpha table to 0 knots
+ *   SMOOTH_AXIS_PROFILE_SPEED  every feature; with NDEBUG the argument guards
+ *                              default to compiled out (SMOOTH_AXIS_CHECK_LEVEL 0)
+ *
+ * A profile only changes defaults: any option defined explicitly wins. Like every
+ * build option, use the same settings for the WHOLE build (they change struct
+ * layouts and which functions exist).
+ */
+#define SMOOTH_AXIS_PROFILE_FULL  0
+#define SMOOTH_AXIS_PROFILE_SIZE  1
+#define SMOOTH_AXIS_PROFILE_SPEED 2
+
+#ifndef SMOOTH_AXIS_PROFILE
+#define SMOOTH_AXIS_PROFILE SMOOTH_AXIS_PROFILE_FULL
+#endif
+
+#if SMOOTH_AXIS_PROFILE == SMOOTH_AXIS_PROFILE_SIZE
+#define SMOOTH_AXIS_FEATURE_DEFAULT_ 0
+#else
+#define SMOOTH_AXIS_FEATURE_DEFAULT_ 1
+#endif
+
+#if SMOOTH_AXIS_PROFILE == SMOOTH_AXIS_PROFILE_SPEED && defined(NDEBUG) && !defined(SMOOTH_AXIS_CHECK_LEVEL)
+#define SMOOTH_AXIS_CHECK_LEVEL 0
+#endif
+
+/**
+ * @brief LIVE_DT updates of smooth_axis_t (build option)
+ *
+ * 0 removes smooth_axis_update_live_dt() and smooth_axis_update_block() and the
+ * per-axis alpha cache; smooth_axis_init() then rejects LIVE_DT configs. The
+ * other front-ends keep their LIVE_DT paths, so smooth_axis_config_live_dt() stays.
+ */
+#ifndef SMOOTH_AXIS_ENABLE_LIVE_DT
+#define SMOOTH_AXIS_ENABLE_LIVE_DT SMOOTH_AXIS_FEATURE_DEFAULT_
+#endif
+
+/**
+ * @brief Dead-zone input mapping (build option)
+ *
+ * 0 ignores full_off_norm / full_on_norm: every input maps as raw / max_raw, and
+ * input_norm() loses its clip and re-stretch.
+ */
+#ifndef SMOOTH_AXIS_ENABLE_DEAD_ZONES
+#define SMOOTH_AXIS_ENABLE_DEAD_ZONES SMOOTH_AXIS_FEATURE_DEFAULT_
+#endif
+
+/**
+ * @brief Sticky zones (build option)
+ *
+ * 0 removes the endpoint snap, the middle-region re-stretch and the "always
+ * report near the edges" rule; sticky_zone_norm defaults to 0 and is ignored.
+ * The output still reaches exactly 0 and max_raw through the 1-LSB end bands.
+ */
+#ifndef SMOOTH_AXIS_ENABLE_STICKY
+#define SMOOTH_AXIS_ENABLE_STICKY SMOOTH_AXIS_FEATURE_DEFAULT_
+#endif
+
+/**
+ * @brief Diagnostics getters of smooth_axis_t (build option)
+ *
+ * 0 removes smooth_axis_get_noise_norm() and smooth_axis_get_effective_thresh_*().
+ */
+#ifndef SMOOTH_AXIS_ENABLE_DIAGNOSTICS
+#define SMOOTH_AXIS_ENABLE_DIAGNOSTICS SMOOTH_AXIS_FEATURE_DEFAULT_
+#endif
+
+/**
+ * @brief Knots in the LIVE_DT alpha table (build option)
+ *
+ * smooth_axis_config_live_dt() tabulates alpha(dt) at this many evenly spaced
+ * dt values over [0 .. 50ms]; smooth_axis_update_live_dt() then replaces the
+ * per-frame expf() with a table read plus a 5th-order correction polynomial.
+ * Costs 4 bytes per knot in smooth_axis_config_t. Set to 0 to drop the table
+ * and always evaluate expf().
+ */
+#ifndef SMOOTH_AXIS_ALPHA_LUT_SIZE
+#if SMOOTH_AXIS_PROFILE == SMOOTH_AXIS_PROFILE_SIZE
+#define SMOOTH_AXIS_ALPHA_LUT_SIZE 0
+#else
+#define SMOOTH_AXIS_ALPHA_LUT_SIZE 16
+#endif
+#endif
+
+/**
+ * @brief Compile-time ADC range (build option)
+ *
+ * Define to the one max_raw value the build uses (e.g. 1023, 4095, 65535) to make
+ * it a literal constant throughout the per-sample path: the max_raw argument of
+ * smooth_axis_config_*() must then match (checked by assertion; the constant wins
+ * in release). Multiplies by 2^n - 1 and 2^n reduce to shifts, which matters in
+ * the fixed-point build and on cores without a single-cycle multiplier.
+ * Leave undefined (or 0) to take max_raw from the config at runtime.
+ */
+#ifndef SMOOTH_AXIS_MAX_RAW
+#define SMOOTH_AXIS_MAX_RAW 0
+#endif
+
+/**
+ * @brief Input/output mapping derived from the feel parameters
+ *
+ * Opaque structure - do not access fields directly.
+ * Refreshed from max_raw / full_off_norm / full_on_norm / sticky_zone_norm by
+ * smooth_axis_config_*() and again by every init (so edits in between apply),
+ * turning the per-sample divisions into one multiply-add plus clamps.
+ */
+typedef struct {
+  float _in_scale;     // norm = clamp01(raw · _in_scale + _in_offset)
+  float _in_offset;
+  float _sticky;       // Clamped sticky zone
+  float _sticky_gain;  // Middle-region re-stretch: pos · (1 + 2z) - z
+  float _lsb_norm;     // One output LSB (1 / max_raw)
+  float _top_norm;     // (max_raw - 1) / max_raw: snaps to max_raw at or above
+} smooth_axis_map_t;
+
 /**
  * @brief Configuration for axis smoothing behavior
  *
@@ -101,6 +234,16 @@ typedef struct {
   /** ADC maximum value (e.g. 1023 for 10-bit, 4095 for 12-bit, 65535 for 16-bit) */
   uint16_t max_raw;
   
+  // --- Optional: input front-end ---
+  /**
+   * Oversampling front-end (default 0 = off, single axis only). With N >= 2, N raw
+   * samples are summed in an integer accumulator and only their mean enters the
+   * EMA and noise estimator, as one sample spanning N·dt. The mean keeps its
+   * fraction, so resolution can exceed max_raw. settle_time_sec is unchanged.
+   * Outputs start after the first N samples.
+   */
+  uint8_t decimation;
+  
   // --- Optional: feel tuning (normalized 0.0 .. 1.0) ---
   /**
    * Dead zone at low end. Clips insensitive/noisy edge region to zero.
@@ -136,19 +279,221 @@ typedef struct {
   
   // --- Time source for AUTO mode ---
   /**
-   * Millisecond timer function (required for AUTO_DT, ignored for LIVE_DT).
+   * Timer function (required for AUTO_DT, ignored for LIVE_DT).
    * Must return monotonically increasing value.
    */
   smooth_axis_now_ms_fn now_ms;
   
+  /**
+   * Tick rate of now_ms in Hz. 1000 (default) for a millisecond timer,
+   * 1000000 for micros(), the core clock for a cycle counter.
+   */
+  uint32_t timer_hz;
+  
+  /**
+   * Keep re-measuring the average loop time after warmup (AUTO_DT, default off).
+   * Costs one timer read per SMOOTH_AXIS_DT_TRACK_FRAMES updates; alpha follows
+   * loop-rate changes gradually instead of staying fixed at the warmup value.
+   */
+  bool auto_dt_tracking;
+  
+  /**
+   * End the AUTO_DT warmup as soon as the measured average dt is known to 1%
+   * (default off: always 256 updates). A steady 50 Hz loop with a millisecond
+   * timer then calibrates in 17 updates (0.3 s) instead of 5 s; jittery loops
+   * and coarse timers automatically take longer, never more than 256.
+   */
+  bool fast_warmup;
+  
+  /**
+   * Idle detection (default 0 = off). After this many consecutive updates whose
+   * residual stays inside the noise band, and whose mean residual is within one
+   * output LSB (converged), the axis goes idle: updates only compare raw against
+   * the range seen meanwhile, and smooth_axis_is_idle() returns true.
+   * The first sample outside that range wakes it and is processed normally.
+   * Use at least settle_time_sec × update rate, so a step has settled before it holds.
+   */
+  uint16_t idle_frames;
+  
   // --- Internal (do not modify directly) ---
   /** @internal EMA decay rate constant derived from settle_time_sec */
   float _ema_decay_rate;
   
   /** @internal Pre-calculated scalar for dynamic threshold based on settle_time_sec */
   float _threshold_attenuation;
+
+  /** @internal Precomputed input/output mapping (see smooth_axis_map_t) */
+  smooth_axis_map_t _map;
+
+#if SMOOTH_AXIS_ALPHA_LUT_SIZE >= 2
+  /** @internal LIVE_DT alpha at the table knots (see SMOOTH_AXIS_ALPHA_LUT_SIZE) */
+  float _alpha_lut[SMOOTH_AXIS_ALPHA_LUT_SIZE];
+#endif
 } smooth_axis_config_t;
 
+// ----------------------------------------------------------------------------
+// Build options
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Integer-only update path for FPU-less MCUs (Cortex-M0+, AVR)
+ *
+ * Define SMOOTH_AXIS_FIXED_POINT=1 for the WHOLE build - library and every file
+ * that includes this header - since it changes the layout of smooth_axis_t.
+ *
+ * - Smoothed value, noise estimate, residual and thresholds are stored as Q30 integers
+ * - Update, has_new_value(), sticky zones and smooth_axis_get_u16() use integer math only
+ * - Float remains at init (coefficients), once at the end of AUTO_DT warmup (alpha),
+ *   in LIVE_DT whenever dt_sec changes (alpha from dt_sec) and in the float-returning getters
+ *
+ * @note Q30 rather than Q15/Q16: at kHz loop rates with long settle times alpha drops
+ *       to ~1e-4, which 16 fractional bits cannot represent to settle-time accuracy.
+ * @note smooth_axis_bank_t is not affected and always uses float state.
+ */
+#ifndef SMOOTH_AXIS_FIXED_POINT
+#define SMOOTH_AXIS_FIXED_POINT 0
+#endif
+
+#if SMOOTH_AXIS_FIXED_POINT
+/** @internal Normalized value in Q30 (1.0 == 1 << 30) */
+typedef int32_t smooth_axis_value_t;
+
+/**
+ * @brief Integer coefficients derived from config at init (fixed-point build)
+ *
+ * Opaque structure - do not access fields directly.
+ */
+typedef struct {
+  int32_t  _in_off_q8;        // full_off in raw units, 8 fractional bits
+  int32_t  _in_on_q8;         // full_on  in raw units, 8 fractional bits
+  uint32_t _in_gain;          // (raw_q8 - off) * gain >> shift == Q30 norm
+  uint8_t  _in_shift;
+  int32_t  _sticky_q30;       // Clamped sticky zone (output mapping)
+  int32_t  _sticky_gain_q30;  // 1 + 2 * sticky zone (output re-stretch)
+  int32_t  _sticky_cmp_q30;   // Unclamped sticky zone (report decision)
+  int32_t  _thresh_gain_q28;  // THRESHOLD_NOISE_MULTIPLIER * _threshold_attenuation
+  int32_t  _alpha_q30;        // Current alpha (AUTO_DT warmup result / LIVE_DT cache)
+} smooth_axis_fixed_t;
+#else
+/** @internal Normalized value [0.0 .. 1.0] */
+typedef float smooth_axis_value_t;
+#endif
+
+/**
+ * @brief Loop-time tracking window of auto_dt_tracking (build option)
+ *
+ * After warmup the timer is read once per this many AUTO_DT updates, and the
+ * window's average dt nudges the tracked average (1/8 per window).
+ */
+#ifndef SMOOTH_AXIS_DT_TRACK_FRAMES
+#define SMOOTH_AXIS_DT_TRACK_FRAMES 256
+#endif
+
+/**
+ * @brief Per-axis / per-bank activity counters (build option, default off)
+ *
+ * Define SMOOTH_AXIS_STATS=1 for the WHOLE build (it changes the layout of
+ * smooth_axis_t and smooth_axis_bank_t). Each update, has_new_value() and alpha
+ * refresh then bumps plain integer counters - no logging, no timer reads - and
+ * smooth_axis_get_stats() returns them as one struct copy for telemetry.
+ * Without it the counters compile out and get_stats() returns zeros.
+ *
+ * @note Counters wrap at 2^32. Read them from the same context that updates
+ *       the axis (or with its interrupt masked) for a consistent snapshot.
+ * @note The bank counts over all of its axes and runs its scalar loop while
+ *       counting, as the SIMD kernels do not expose per-lane sign flips.
+ */
+#ifndef SMOOTH_AXIS_STATS
+#define SMOOTH_AXIS_STATS 0
+#endif
+
+/**
+ * @brief Counter snapshot (see SMOOTH_AXIS_STATS)
+ *
+ * Plain data: read it with smooth_axis_get_stats(), clear with smooth_axis_reset_stats().
+ */
+typedef struct {
+  uint32_t updates;             // Raw samples passed to the update functions
+  uint32_t noise_spikes;        // EMA steps whose residual flipped sign (fed the noise estimate)
+  uint32_t settling_samples;    // EMA steps without a flip (directional movement)
+  uint32_t reports_sticky;      // has_new_value() true inside a sticky zone
+  uint32_t reports_threshold;   // has_new_value() true past the noise threshold
+  uint32_t suppressed_sub_lsb;  // has_new_value() false: change below one output LSB
+  uint32_t suppressed_noise;    // has_new_value() false: above one LSB, within the threshold
+  float    dt_min_sec;          // Smallest / largest dt alpha was derived from
+  float    dt_max_sec;          //   (LIVE_DT dt, AUTO_DT calibrated average; 0 = none yet)
+} smooth_axis_stats_t;
+
+/**
+ * @brief AUTO_DT warmup calibration state
+ *
+ * Opaque structure - do not access fields directly.
+ * Embedded in every AUTO_DT front-end (single axis, bank).
+ */
+typedef struct {
+  float    _dt_accum_sec;        // Warmup: sum of measured dt; after: average dt
+  float    _dt_sq_accum;         // Warmup: sum of squared dt (fast_warmup variance)
+  float    _sec_per_tick;        // 1 / timer_hz
+  uint32_t _last_ticks;          // Timer at last measurement (0 = none yet)
+  uint16_t _warmup_cycles_done;
+  uint16_t _track_frames;        // Updates since _last_ticks (auto_dt_tracking)
+  float    _auto_alpha;
+} smooth_axis_warmup_t;
+
+/**
+ * @brief Last dt → alpha pair seen by a LIVE_DT front-end
+ *
+ * Opaque structure - do not access fields directly.
+ * Steady frame rates pass the same dt_sec every frame and skip the alpha math.
+ */
+typedef struct {
+  float _dt_sec;
+  float _alpha;
+} smooth_axis_alpha_cache_t;
+
+/**
+ * @brief Idle detection state (see smooth_axis_config_t::idle_frames)
+ *
+ * Opaque structure - do not access fields directly.
+ */
+typedef struct {
+  uint16_t _quiet_frames;  // Consecutive updates with the residual inside the noise band
+  uint16_t _raw_lo;        // Raw range seen while quiet; the wake window once idle
+  uint16_t _raw_hi;
+  bool     _active;        // Idle: updates only compare raw against the window
+#if SMOOTH_AXIS_FIXED_POINT
+  int64_t  _residual_sum;  // Signed residuals of the quiet run (Q30)
+#else
+  float    _residual_sum;  // Signed residuals of the quiet run
+#endif
+} smooth_axis_idle_t;
+
+/**
+ * @brief Boxcar decimation accumulator (see smooth_axis_config_t::decimation)
+ *
+ * Opaque structure - do not access fields directly.
+ */
+typedef struct {
+  uint32_t _sum;     // Raw samples of the current block
+  float    _dt_sum;  // LIVE_DT: their dt, the decimated sample's dt
+  uint8_t  _count;
+} smooth_axis_decim_t;
+
+/**
+ * @brief Output cache: post-sticky position and its integer value
+ *
+ * Filled by the first has_new_value() after an update, so get_norm() / get_u16()
+ * after it are plain loads until the next update. The getters take a const axis
+ * and never write it: before has_new_value() they compute the output themselves.
+ *
+ * Opaque structure - do not access fields directly.
+ */
+typedef struct {
+  smooth_axis_value_t _norm;   // apply_sticky_margins() of the smoothed position
+  uint16_t            _u16;    // _norm mapped to [0 .. max_raw]
+  bool                _valid;  // Cleared by every state change
+} smooth_axis_output_t;
+
 /**
  * @brief Runtime state for a single axis
  *
@@ -161,17 +506,36 @@ typedef struct smooth_axis_t {
   smooth_axis_config_t cfg;
   
   // Internal runtime state (do not access directly)
-  float _smoothed_norm;
-  float _noise_estimate_norm;
-  float _last_reported_norm;
+  smooth_axis_value_t _smoothed_norm;
+  smooth_axis_value_t _noise_estimate_norm;
+  smooth_axis_value_t _last_reported_norm;
   bool _has_first_sample;
-  float _last_residual;
+  smooth_axis_value_t _last_residual;
   
   // AUTO_DT internal state
-  float    _dt_accum_sec;
-  uint16_t _warmup_cycles_done;
-  uint32_t _last_time_ms;
-  float    _auto_alpha;
+  smooth_axis_warmup_t _warmup;
+  
+  // LIVE_DT internal state
+#if SMOOTH_AXIS_ENABLE_LIVE_DT
+  smooth_axis_alpha_cache_t _live_alpha;
+#endif
+  
+  // Idle detection state (cfg.idle_frames > 0)
+  smooth_axis_idle_t _idle;
+  
+  // Oversampling front-end state (cfg.decimation >= 2)
+  smooth_axis_decim_t _decim;
+  
+  // Output cache (filled by the first has_new_value() after an update)
+  smooth_axis_output_t _out;
+  
+#if SMOOTH_AXIS_STATS
+  smooth_axis_stats_t _stats;
+#endif
+  
+#if SMOOTH_AXIS_FIXED_POINT
+  smooth_axis_fixed_t _fx;
+#endif
 } smooth_axis_t;
 
 // ----------------------------------------------------------------------------
@@ -188,7 +552,9 @@ typedef struct smooth_axis_t {
  * @param[in]  settle_time_sec Time to ~95% settled after step (seconds)
  * @param[in]  now_ms         Monotonic millisecond timer function (required, non-NULL)
  *
- * @note Warmup takes 256 cycles to calibrate dt. Use fallback alpha until complete.
+ * @note Warmup takes 256 cycles to calibrate dt (fewer with cfg->fast_warmup). Until then
+ *       a 60 Hz fallback alpha is used, or the one from smooth_axis_seed_auto_dt().
+ * @note For a faster timer, set cfg->timer_hz afterwards (before init).
  *
  * Example (QMK):
  * @code
@@ -277,6 +643,40 @@ void smooth_axis_init(smooth_axis_t *axis, const smooth_axis_config_t *cfg);
  */
 void smooth_axis_reset(smooth_axis_t *axis, uint16_t raw_value);
 
+/**
+ * @brief Seed the AUTO_DT warmup with a loop period measured earlier
+ *
+ * Until the warmup ends, updates use the alpha for `dt_sec` instead of the 60 Hz
+ * fallback. Store smooth_axis_get_auto_dt_sec() (e.g. in EEPROM) and pass it back
+ * after the next boot; the warmup still runs and replaces the seed with a fresh
+ * measurement.
+ *
+ * @param[in,out] axis   Axis state (mode must be AUTO_DT), after init
+ * @param[in]     dt_sec Loop period from a previous calibration (ignored if <= 0)
+ *
+ * @note No effect once the warmup has finished.
+ *
+ * @code
+ * smooth_axis_init(&axis, &cfg);
+ * smooth_axis_seed_auto_dt(&axis, eeprom_read_float(DT_ADDR));
+ * ...
+ * if (!saved && smooth_axis_get_auto_dt_sec(&axis) > 0.0f) {
+ *     eeprom_update_float(DT_ADDR, smooth_axis_get_auto_dt_sec(&axis));
+ *     saved = true;
+ * }
+ * @endcode
+ */
+void smooth_axis_seed_auto_dt(smooth_axis_t *axis, float dt_sec);
+
+/**
+ * @brief Get the calibrated AUTO_DT loop period
+ *
+ * @param[in] axis Axis state
+ * @return Average dt in seconds (the tracked value with auto_dt_tracking), or 0.0
+ *         while the warmup is running, in LIVE_DT mode or if axis is NULL
+ */
+float smooth_axis_get_auto_dt_sec(const smooth_axis_t *axis);
+
 // ----------------------------------------------------------------------------
 // Core update API (call one of these each loop)
 // ----------------------------------------------------------------------------
@@ -290,7 +690,7 @@ void smooth_axis_reset(smooth_axis_t *axis, uint16_t raw_value);
  * @param[in,out] axis      Axis state (mode must be AUTO_DT)
  * @param[in]     raw_value Current ADC reading [0 .. max_raw]
  *
- * @note First 256 calls perform warmup to measure average dt.
+ * @note First 256 calls perform warmup to measure average dt (see fast_warmup).
  * @note Wrong mode: Calling this in LIVE_DT mode does nothing (checked by assertion).
  *
  * @code
@@ -306,11 +706,42 @@ void smooth_axis_reset(smooth_axis_t *axis, uint16_t raw_value);
  */
 void smooth_axis_update_auto_dt(smooth_axis_t *axis, uint16_t raw_value);
 
+/**
+ * @brief Update a group of AUTO_DT axes on the same loop with one warmup
+ *
+ * Equivalent to smooth_axis_update_auto_dt() on each of axes[0 .. n-1] with
+ * raw[0 .. n-1], except that only axes[0] reads the timer. When its warmup
+ * finishes (or auto_dt_tracking moves its dt), the calibration is copied to
+ * every other member, so all of them switch to the same alpha on the same
+ * call. A member with a different settle time or decimation gets the alpha
+ * for its own settle time and block period.
+ *
+ * @param[in,out] axes Group members (mode must be AUTO_DT; axes[0] drives the timebase)
+ * @param[in]     raw  One sample per member
+ * @param[in]     n    Number of members
+ *
+ * @note The timer config (now_ms, timer_hz, fast_warmup, auto_dt_tracking) of
+ *       axes[0] applies to the group. Axes on different loops form separate groups.
+ * @note smooth_axis_bank_t already runs one warmup per bank.
+ *
+ * @code
+ * static smooth_axis_t pedals[3];   // Throttle, brake, clutch on one loop
+ * while (1) {
+ *     uint16_t raw[3] = { read_adc(0), read_adc(1), read_adc(2) };
+ *     smooth_axis_update_auto_dt_group(pedals, raw, 3);
+ * }
+ * @endcode
+ */
+void smooth_axis_update_auto_dt_group(smooth_axis_t *axes, const uint16_t *raw, size_t n);
+
+#if SMOOTH_AXIS_ENABLE_LIVE_DT
 /**
  * @brief Update axis with new raw sample and delta time (LIVE_DT mode)
  *
  * Call once per loop with latest ADC reading and elapsed time.
  * Computes alpha dynamically based on actual dt for jitter-free smoothing.
+ * Alpha comes from the config's table (see SMOOTH_AXIS_ALPHA_LUT_SIZE) and is
+ * cached, so repeated identical dt_sec values cost no alpha math at all.
  *
  * @param[in,out] axis      Axis state (mode must be LIVE_DT)
  * @param[in]     raw_value Current ADC reading [0 .. max_raw]
@@ -339,6 +770,36 @@ void smooth_axis_update_live_dt(smooth_axis_t *axis,
                                 uint16_t raw_value,
                                 float dt_sec);
 
+/**
+ * @brief Update axis with a buffer of evenly spaced samples (LIVE_DT mode)
+ *
+ * For DMA / oversampled ADC buffers: consumes `n` readings in one call, with the
+ * argument checks and the alpha lookup done once per block and the filter state
+ * kept in locals for the loop.
+ *
+ * @param[in,out] axis    Axis state (mode must be LIVE_DT)
+ * @param[in]     samples Raw ADC readings in acquisition order [0 .. max_raw]
+ * @param[in]     n       Number of readings (0 = no-op)
+ * @param[in]     dt_sec  Time between consecutive samples (seconds), not the block duration
+ *
+ * @note Bit-exact with n calls to smooth_axis_update_live_dt(axis, samples[i], dt_sec).
+ * @note Call smooth_axis_has_new_value() once after the block: reporting reflects the
+ *       final state, as if it had been polled only after the last sample.
+ * @note There is no closed-form (1-α)^n shortcut: the noise estimate depends on
+ *       every per-sample residual, so all n samples are processed.
+ *
+ * @code
+ * void adc_dma_complete(const uint16_t *buf, size_t n) {
+ *     smooth_axis_update_block(&axis, buf, n, 1.0f / ADC_SAMPLE_RATE_HZ);
+ * }
+ * @endcode
+ */
+void smooth_axis_update_block(smooth_axis_t *axis,
+                              const uint16_t *samples,
+                              size_t n,
+                              float dt_sec);
+#endif // SMOOTH_AXIS_ENABLE_LIVE_DT
+
 // ----------------------------------------------------------------------------
 // Output + change detection
 // ----------------------------------------------------------------------------
@@ -353,6 +814,10 @@ void smooth_axis_update_live_dt(smooth_axis_t *axis,
  *
  * @note Returns 0.0 if axis uninitialized or no samples received.
  * @note Value snaps to exact 0.0 or 1.0 within sticky zones.
+ * @note has_new_value() computes the position once per update and caches it in
+ *       the axis; reads after it are loads. Without has_new_value() each read
+ *       computes it (the getter never writes the axis). Reads must not race
+ *       with updates from another thread; use smooth_axis_spsc_t for that.
  */
 float smooth_axis_get_norm(const smooth_axis_t *axis);
 
@@ -367,6 +832,7 @@ float smooth_axis_get_norm(const smooth_axis_t *axis);
  * @note Returns 0 if axis is NULL or uninitialized.
  * @note Rounds to nearest integer (uses lroundf() internally).
  * @note Guarantees exact 0 and max_raw at endpoints (no off-by-one).
+ * @note Cached by has_new_value(), like smooth_axis_get_norm().
  */
 uint16_t smooth_axis_get_u16(const smooth_axis_t *axis);
 
@@ -406,10 +872,32 @@ uint16_t smooth_axis_get_u16(const smooth_axis_t *axis);
  */
 bool smooth_axis_has_new_value(smooth_axis_t *axis);
 
+/**
+ * @brief Check if the axis is idle (settled, see smooth_axis_config_t::idle_frames)
+ *
+ * While idle, every update is a single compare of raw against the wake window:
+ * EMA, noise estimate and output are held, so has_new_value() stays false.
+ * Use it as a low-power hint - lower the ADC sampling rate or sleep until the
+ * next scan. The first sample outside the window wakes the axis on that update.
+ *
+ * @param[in] axis Axis state
+ * @return true while idle, false if awake, idle detection is off or axis is NULL
+ *
+ * @note Changing the sampling rate needs LIVE_DT (dt_sec follows it); AUTO_DT
+ *       assumes a constant loop rate.
+ *
+ * @code
+ * smooth_axis_update_live_dt(&axis, read_adc(), dt_sec);
+ * scan_period_ms = smooth_axis_is_idle(&axis) ? 20 : 1;
+ * @endcode
+ */
+bool smooth_axis_is_idle(const smooth_axis_t *axis);
+
 // ----------------------------------------------------------------------------
-// Introspection / diagnostics
+// Introspection / diagnostics (SMOOTH_AXIS_ENABLE_DIAGNOSTICS)
 // ----------------------------------------------------------------------------
 
+#if SMOOTH_AXIS_ENABLE_DIAGNOSTICS
 /**
  * @brief Get current noise estimate in normalized units
  *
@@ -448,6 +936,88 @@ float smooth_axis_get_effective_thresh_norm(const smooth_axis_t *axis);
  * @note Useful for debugging: "How many ADC counts must change to trigger update?"
  */
 uint16_t smooth_axis_get_effective_thresh_u16(const smooth_axis_t *axis);
+#endif // SMOOTH_AXIS_ENABLE_DIAGNOSTICS
+
+// ----------------------------------------------------------------------------
+// Instrumentation (SMOOTH_AXIS_STATS)
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Copy the axis' activity counters
+ *
+ * @param[in]  axis Axis state
+ * @param[out] out  Counter snapshot (all zero when built without SMOOTH_AXIS_STATS)
+ *
+ * @code
+ * smooth_axis_stats_t s;
+ * smooth_axis_get_stats(&axis, &s);
+ * telemetry_send(&s, sizeof(s));
+ * smooth_axis_reset_stats(&axis);   // Optional: per-interval counts
+ * @endcode
+ */
+void smooth_axis_get_stats(const smooth_axis_t *axis, smooth_axis_stats_t *out);
+
+/** @brief Zero the axis' counters (no-op without SMOOTH_AXIS_STATS) */
+void smooth_axis_reset_stats(smooth_axis_t *axis);
+
+// ----------------------------------------------------------------------------
+// Snapshot / restore (deep sleep)
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Compact filter state for RTC / backup RAM (12 bytes)
+ *
+ * Opaque structure - do not access fields directly.
+ * Holds what smooth_axis_reset() would otherwise throw away: smoothed and last
+ * reported position, noise estimate and residual sign, and the calibrated AUTO_DT
+ * period. The config is not included - restore into an axis initialized with
+ * the same config.
+ */
+typedef struct {
+  float    _dt_sec;    // Calibrated AUTO_DT period (0 = warmup not finished / LIVE_DT)
+  uint16_t _smoothed;  // Smoothed position, 1/65535 units
+  uint16_t _reported;  // Last reported position, 1/65535 units
+  uint16_t _noise;     // Noise estimate, 2^-20 units (saturates at 1/16)
+  uint8_t  _flags;     // First sample seen, residual sign
+  uint8_t  _check;     // Checksum: rejects cleared or corrupted backup RAM
+} smooth_axis_snapshot_t;
+
+/**
+ * @brief Save axis state before deep sleep
+ *
+ * @param[in]  axis Axis state
+ * @param[out] snap Snapshot to write (e.g. a variable in RTC / backup RAM)
+ *
+ * @note Positions are stored to 1/65535 and the noise estimate to 2^-20
+ *       (below 0.1 LSB of a 16-bit ADC), so the restored filter continues
+ *       from the same state at full accuracy.
+ */
+void smooth_axis_save(const smooth_axis_t *axis, smooth_axis_snapshot_t *snap);
+
+/**
+ * @brief Restore axis state after wake (O(1), instead of smooth_axis_reset())
+ *
+ * The first update after restore continues the filter with the saved position
+ * and noise model. In AUTO_DT mode a saved calibration skips the warmup.
+ *
+ * @param[in,out] axis Axis initialized with the config the snapshot was saved from
+ * @param[in]     snap Snapshot written by smooth_axis_save()
+ * @return true if restored; false if the checksum does not match (cold boot,
+ *         cleared RAM) - the axis is then left unchanged
+ *
+ * @code
+ * RTC_DATA_ATTR static smooth_axis_snapshot_t saved;
+ *
+ * smooth_axis_init(&axis, &cfg);
+ * if (!smooth_axis_restore(&axis, &saved)) {
+ *     smooth_axis_reset(&axis, read_adc());  // Cold boot
+ * }
+ * ...
+ * smooth_axis_save(&axis, &saved);
+ * enter_deep_sleep();
+ * @endcode
+ */
+bool smooth_axis_restore(smooth_axis_t *axis, const smooth_axis_snapshot_t *snap);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,373 @@
+/**
+ * @file smooth_axis_bank.c
+ * @brief Implementation of multi-axis (struct-of-arrays) smoothing
+ * @author Jonatan Vider
+ *
+ * See smooth_axis_bank.h for API documentation.
+ */
+
+#include "smooth_axis_bank.h"
+#include "smooth_axis_internal.h"
+#include "smooth_axis_simd.h"
+
+// ============================================================================
+// Core Update Logic
+// ============================================================================
+
+// Seed every axis from the first scan (skip EMA on frame 0)
+static void bank_initialize_on_first_sample(smooth_axis_bank_t *bank,
+                                            const uint16_t *raw,
+                                            size_t n) {
+    const smooth_axis_config_t cfg = bank->cfg;
+
+    for (size_t i = 0; i < n; i++) {
+        bank->_smoothed_norm[i] = input_norm(&cfg, raw[i]);
+    }
+    bank->_has_first_sample = true;
+
+    SMOOTH_DEBUGF("bank first sample: count=%u", (unsigned)n);
+}
+
+// One axis of update_core() + update_noise_estimate(), written as selects
+// instead of sign_of() branches. Also the tail of the vector loop.
+// Returns true if the residual flipped sign (a noise sample).
+static inline bool bank_lane_update(const smooth_axis_map_t *m,
+                                    float max_raw,
+                                    uint16_t raw,
+                                    float alpha,
+                                    float *smoothed,
+                                    float *noise,
+                                    float *residual) {
+    float x    = (float)raw < max_raw ? (float)raw : max_raw;
+    float norm = clamp_f_0_1(x * m->_in_scale + m->_in_offset);  // == input_norm()
+
+    float diff = norm - *smoothed;
+    *smoothed += alpha * diff; // EMA: x += α·(target - x)
+
+    // No flip = both residuals strictly on the same side of zero
+    float last    = *residual;
+    bool  no_flip = ((diff > 0.0f) & (last > 0.0f)) | ((diff < 0.0f) & (last < 0.0f));
+    float sample  = no_flip ? 0.0f : abs_f(diff);
+
+    *noise    = clamp_f_0_1(ema(*noise, sample, NOISE_SMOOTHING_RATE));
+    *residual = diff;
+    return !no_flip;
+}
+
+// Same math as update_core() + update_noise_estimate(), one pass over all axes.
+// Arrays are restrict-qualified so the loop carries no aliasing hazards; the
+// vector body handles SMOOTH_AXIS_VF_LANES axes per iteration (see smooth_axis_simd.h);
+// SMOOTH_AXIS_STATS builds use the scalar loop, which reports each lane's sign flip.
+static void bank_update_core(smooth_axis_bank_t *bank,
+                             const uint16_t *raw,
+                             size_t n,
+                             float alpha) {
+    if (!bank->_has_first_sample) {
+        bank_initialize_on_first_sample(bank, raw, n);
+        return;
+    }
+
+    const smooth_axis_map_t m       = bank->cfg._map;
+    const float             max_raw = (float)cfg_max_raw(&bank->cfg);
+
+    float *restrict smoothed = bank->_smoothed_norm;
+    float *restrict noise    = bank->_noise_estimate_norm;
+    float *restrict residual = bank->_last_residual;
+
+    size_t i = 0;
+
+#if SMOOTH_AXIS_VF_LANES > 1 && !SMOOTH_AXIS_STATS
+    const sa_vf v_zero  = VF_SET1(0.0f);
+    const sa_vf v_one   = VF_SET1(1.0f);
+    const sa_vf v_max   = VF_SET1(max_raw);
+    const sa_vf v_scale = VF_SET1(m._in_scale);
+    const sa_vf v_off   = VF_SET1(m._in_offset);
+    const sa_vf v_alpha = VF_SET1(alpha);
+    const sa_vf v_keep  = VF_SET1(1.0f - NOISE_SMOOTHING_RATE);
+    const sa_vf v_rate  = VF_SET1(NOISE_SMOOTHING_RATE);
+
+    for (; i + SMOOTH_AXIS_VF_LANES <= n; i += SMOOTH_AXIS_VF_LANES) {
+        sa_vf norm = VF_ADD(VF_MUL(VF_MIN(VF_LOAD_U16(raw + i), v_max), v_scale), v_off);
+        norm = VF_MIN(VF_MAX(norm, v_zero), v_one);
+
+        sa_vf s    = VF_LOAD(smoothed + i);
+        sa_vf diff = VF_SUB(norm, s);
+        VF_STORE(smoothed + i, VF_ADD(s, VF_MUL(v_alpha, diff)));
+
+        sa_vf last    = VF_LOAD(residual + i);
+        sa_vm no_flip = VM_OR(VM_AND(VF_GT(diff, v_zero), VF_GT(last, v_zero)),
+                              VM_AND(VF_LT(diff, v_zero), VF_LT(last, v_zero)));
+        sa_vf sample  = VF_ZERO_WHERE(no_flip, VF_ABS(diff));
+
+        sa_vf nz = VF_ADD(VF_MUL(v_keep, VF_LOAD(noise + i)), VF_MUL(v_rate, sample));
+        VF_STORE(noise + i, VF_MIN(VF_MAX(nz, v_zero), v_one));
+        VF_STORE(residual + i, diff);
+    }
+#endif
+
+    for (; i < n; i++) {
+        bool flipped = bank_lane_update(&m, max_raw, raw[i], alpha,
+                                        &smoothed[i], &noise[i], &residual[i]);
+        SMOOTH_AXIS_STAT(stats_ema_step(&bank->_stats, flipped));
+        (void)flipped;  // Only counted with SMOOTH_AXIS_STATS
+    }
+}
+
+static float bank_get_normalized(const smooth_axis_bank_t *bank, size_t index) {
+    if (!bank->_has_first_sample) {
+        return 0.0f;
+    }
+    return apply_sticky_margins(&bank->cfg, bank->_smoothed_norm[index]);
+}
+
+// Deliver one report to the attached mask and/or queue. The queue clock is read
+// at most once per scan (on its first event).
+static inline void bank_deliver(smooth_axis_bank_t *bank, size_t i, float current,
+                                uint32_t *stamp, bool *stamped) {
+    if (bank->_change_mask) {
+        bank->_change_mask[i >> 5] |= (uint32_t)1 << (i & 31u);
+    }
+    smooth_axis_event_queue_t *events = bank->_events;
+    if (events) {
+        if (!*stamped) {
+            *stamp   = smooth_axis_event_queue_now(events);
+            *stamped = true;
+        }
+        smooth_axis_event_queue_push_at(events, (uint16_t)i, output_u16(&bank->cfg, current), *stamp,
+                                        &bank->_event_slot[i]);
+    }
+}
+
+// report_if_changed() for every axis, with the per-config terms hoisted out of
+// the loop. Delivers one report per reported axis (same decisions, bit-for-bit).
+static void bank_mark_changes(smooth_axis_bank_t *bank) {
+    if (bank->_events) { bank->_events->_ticks++; }  // Clockless timestamps count updates
+    if ((bank->_change_mask == NULL && bank->_events == NULL) || !bank->_has_first_sample) { return; }
+
+    const smooth_axis_config_t *cfg = &bank->cfg;
+
+    const float epsilon      = cfg->_map._lsb_norm;
+    const float sticky_floor = cfg_sticky_zone(cfg);
+    const float sticky_ceil  = 1 - cfg_sticky_zone(cfg);
+    const float max_thresh   = MAX_THRESH_U / CANONICAL_MAX;
+
+    uint32_t stamp   = 0;
+    bool     stamped = false;
+    for (size_t i = 0; i < bank->count; i++) {
+        float current = apply_sticky_margins(cfg, bank->_smoothed_norm[i]);
+        float diff    = abs_f(current - bank->_last_reported_norm[i]);
+        if (!(diff > epsilon)) {  // Sub-LSB: the common case
+            SMOOTH_AXIS_STAT(bank->_stats.suppressed_sub_lsb++);
+            continue;
+        }
+
+        bool  in_sticky_zone = (current < sticky_floor) || (current > sticky_ceil);
+        float threshold      = clamp_f(THRESHOLD_NOISE_MULTIPLIER * bank->_noise_estimate_norm[i]
+                                       * cfg->_threshold_attenuation, 0.0f, max_thresh);
+
+        if (in_sticky_zone || diff > threshold) {
+            bank->_last_reported_norm[i] = current;
+            bank_deliver(bank, i, current, &stamp, &stamped);
+            SMOOTH_AXIS_STAT(stats_report(&bank->_stats, in_sticky_zone ? REPORT_STICKY
+                                                                        : REPORT_THRESHOLD));
+        } else {
+            SMOOTH_AXIS_STAT(bank->_stats.suppressed_noise++);
+        }
+    }
+}
+
+
+// ============================================================================
+// Public API - Init
+// ============================================================================
+
+void smooth_axis_bank_init(smooth_axis_bank_t *bank,
+                           const smooth_axis_config_t *cfg,
+                           size_t count) {
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(cfg != NULL, "config is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(count > 0 && count <= SMOOTH_AXIS_BANK_MAX_AXES,
+                             "bank count out of range (see SMOOTH_AXIS_BANK_MAX_AXES)");
+    SMOOTH_AXIS_CHECK_RETURN(cfg->mode != SMOOTH_AXIS_MODE_AUTO_DT || cfg->now_ms != NULL,
+                             "AUTO mode requires now_ms function");
+
+    bank->cfg   = *cfg;
+    map_coeffs_init(&bank->cfg);  // Pick up feel edits made after smooth_axis_config_*()
+    bank->count = count;
+
+    for (size_t i = 0; i < count; i++) {
+        bank->_smoothed_norm[i]       = 0.0f;
+        bank->_noise_estimate_norm[i] = INITIAL_NOISE_NORM;
+        bank->_last_residual[i]       = 0.0f;
+        bank->_last_reported_norm[i]  = 0.0f;
+        bank->_event_slot[i]          = 0;
+    }
+    bank->_has_first_sample = false;
+    warmup_init(&bank->_warmup, cfg);
+    alpha_cache_init(&bank->_live_alpha);
+    bank->_change_mask = NULL;
+    bank->_events      = NULL;
+    SMOOTH_AXIS_STAT(stats_clear(&bank->_stats));
+
+    SMOOTH_DEBUGF("bank init: mode=%s count=%u max_raw=%u settle_time=%.3fs",
+                  cfg->mode == SMOOTH_AXIS_MODE_AUTO_DT ? "AUTO_DT" : "LIVE_DT",
+                  (unsigned)count,
+                  cfg->max_raw,
+                  cfg->settle_time_sec);
+}
+
+void smooth_axis_bank_seed_auto_dt(smooth_axis_bank_t *bank, float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(bank->cfg.mode == SMOOTH_AXIS_MODE_AUTO_DT,
+                             "seed_auto_dt() requires AUTO_DT mode");
+
+    warmup_seed(&bank->_warmup, &bank->cfg, dt_sec);
+}
+
+
+// ============================================================================
+// Public API - Update
+// ============================================================================
+
+void smooth_axis_bank_update_auto_dt(smooth_axis_bank_t *bank,
+                                     const uint16_t *raw,
+                                     size_t n) {
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(raw != NULL, "raw is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(n == bank->count, "sample count must match bank count");
+    SMOOTH_AXIS_CHECK_RETURN(bank->cfg.mode == SMOOTH_AXIS_MODE_AUTO_DT,
+                             "wrong mode: use bank_update_live_dt() for LIVE_DT mode");
+    SMOOTH_AXIS_STAT(bank->_stats.updates += (uint32_t)n);
+
+    if (auto_dt_step(&bank->_warmup, &bank->cfg)) {  // Warmup end / tracking
+        SMOOTH_AXIS_STAT(stats_dt(&bank->_stats, warmup_dt_sec(&bank->_warmup)));
+    }
+
+    bank_update_core(bank, raw, n, bank->_warmup._auto_alpha);  // Fixed alpha after warmup
+    bank_mark_changes(bank);
+}
+
+void smooth_axis_bank_update_live_dt(smooth_axis_bank_t *bank,
+                                     const uint16_t *raw,
+                                     size_t n,
+                                     float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(raw != NULL, "raw is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(n == bank->count, "sample count must match bank count");
+    SMOOTH_AXIS_CHECK_RETURN(bank->cfg.mode == SMOOTH_AXIS_MODE_LIVE_DT,
+                             "wrong mode: use bank_update_auto_dt() for AUTO_DT mode");
+    SMOOTH_AXIS_STAT(bank->_stats.updates += (uint32_t)n);
+
+    if (alpha_cache_refresh(&bank->_live_alpha, &bank->cfg, dt_sec)) { // Once per scan, all axes
+        SMOOTH_AXIS_STAT(stats_dt(&bank->_stats, dt_sec));
+    }
+    bank_update_core(bank, raw, n, bank->_live_alpha._alpha);
+    bank_mark_changes(bank);
+}
+
+void smooth_axis_bank_update_axis_live_dt(smooth_axis_bank_t *bank,
+                                          size_t index,
+                                          uint16_t raw,
+                                          float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(index < bank->count, "index out of range");
+    SMOOTH_AXIS_CHECK_RETURN(bank->cfg.mode == SMOOTH_AXIS_MODE_LIVE_DT,
+                             "bank_update_axis_live_dt() requires LIVE_DT mode");
+    SMOOTH_AXIS_CHECK_RETURN(bank->_has_first_sample,
+                             "bank needs one full-scan update before per-axis updates");
+
+    float alpha   = get_alpha_from_lut(&bank->cfg, dt_sec);  // No per-axis cache: dt varies per call
+    bool  flipped = bank_lane_update(&bank->cfg._map, (float)cfg_max_raw(&bank->cfg), raw, alpha,
+                                     &bank->_smoothed_norm[index],
+                                     &bank->_noise_estimate_norm[index],
+                                     &bank->_last_residual[index]);
+    SMOOTH_AXIS_STAT(bank->_stats.updates++; stats_ema_step(&bank->_stats, flipped);
+                     stats_dt(&bank->_stats, dt_sec));
+    (void)flipped;
+
+    if (bank->_events) { bank->_events->_ticks++; }
+    if (bank->_change_mask == NULL && bank->_events == NULL) { return; }
+
+    float         current = bank_get_normalized(bank, index);
+    report_kind_t kind    = report_decide(&bank->cfg, current,
+                                          bank->_noise_estimate_norm[index],
+                                          &bank->_last_reported_norm[index]);
+    SMOOTH_AXIS_STAT(stats_report(&bank->_stats, kind));
+    if (kind >= REPORT_STICKY) {
+        uint32_t stamp   = 0;
+        bool     stamped = false;
+        bank_deliver(bank, index, current, &stamp, &stamped);
+    }
+}
+
+
+// ============================================================================
+// Public API - Output & Query
+// ============================================================================
+
+void smooth_axis_bank_set_change_mask(smooth_axis_bank_t *bank, uint32_t *mask) {
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+
+    bank->_change_mask = mask;
+}
+
+void smooth_axis_bank_set_event_queue(smooth_axis_bank_t *bank, smooth_axis_event_queue_t *events) {
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+
+    bank->_events = events;
+}
+
+float smooth_axis_bank_get_norm(const smooth_axis_bank_t *bank, size_t index) {
+    if (!bank || index >= bank->count) { return 0.0f; }
+
+    return bank_get_normalized(bank, index);
+}
+
+uint16_t smooth_axis_bank_get_u16(const smooth_axis_bank_t *bank, size_t index) {
+    if (!bank || index >= bank->count) { return 0; }
+
+    return output_u16(&bank->cfg, bank_get_normalized(bank, index));
+}
+
+bool smooth_axis_bank_has_new_value(smooth_axis_bank_t *bank, size_t index) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(bank != NULL, "bank is NULL", false);
+    SMOOTH_AXIS_CHECK_RETURN_VAL(index < bank->count, "index out of range", false);
+    if (!bank->_has_first_sample) { return false; }
+
+    report_kind_t kind = report_decide(&bank->cfg,
+                                       bank_get_normalized(bank, index),
+                                       bank->_noise_estimate_norm[index],
+                                       &bank->_last_reported_norm[index]);
+    SMOOTH_AXIS_STAT(stats_report(&bank->_stats, kind));
+    return kind >= REPORT_STICKY;
+}
+
+float smooth_axis_bank_get_auto_dt_sec(const smooth_axis_bank_t *bank) {
+    return bank ? warmup_dt_sec(&bank->_warmup) : 0.0f;
+}
+
+float smooth_axis_bank_get_noise_norm(const smooth_axis_bank_t *bank, size_t index) {
+    if (!bank || index >= bank->count) { return 0.0f; }
+
+    return bank->_noise_estimate_norm[index];
+}
+
+void smooth_axis_bank_get_stats(const smooth_axis_bank_t *bank, smooth_axis_stats_t *out) {
+    SMOOTH_AXIS_CHECK_RETURN(out != NULL, "stats output is NULL");
+    stats_clear(out);
+#if SMOOTH_AXIS_STATS
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+    *out = bank->_stats;
+#else
+    (void)bank;
+#endif
+}
+
+void smooth_axis_bank_reset_stats(smooth_axis_bank_t *bank) {
+#if SMOOTH_AXIS_STATS
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+    stats_clear(&bank->_stats);
+#else
+    (void)bank;
+#endif
+}
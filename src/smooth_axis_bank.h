@@ -0,0 +1,243 @@
+/**
+ * @file smooth_axis_bank.h
+ * @brief Multi-axis smoothing with struct-of-arrays state
+ *
+ * @author Jonatan Vider
+ *
+ * A bank runs the same filter as smooth_axis_t on many axes that share one
+ * config (same max_raw, settle time, mode and timer), e.g. a matrix of
+ * Hall-effect keys. State is stored as contiguous per-field arrays so the
+ * per-key update is a tight loop the compiler can vectorize, and the
+ * NULL/mode checks and warmup run once per scan instead of once per axis.
+ *
+ * Typical usage:
+ * @code
+ * smooth_axis_config_t cfg;
+ * static smooth_axis_bank_t keys;   // Large: prefer static storage
+ *
+ * smooth_axis_config_auto_dt(&cfg, 4095, 0.05f, my_timer_fn);
+ * smooth_axis_bank_init(&keys, &cfg, NUM_KEYS);
+ *
+ * while (1) {
+ *     uint16_t raw[NUM_KEYS];
+ *     scan_matrix(raw);
+ *     smooth_axis_bank_update_auto_dt(&keys, raw, NUM_KEYS);
+ *
+ *     for (size_t i = 0; i < NUM_KEYS; i++) {
+ *         if (smooth_axis_bank_has_new_value(&keys, i)) {
+ *             handle_key(i, smooth_axis_bank_get_u16(&keys, i));
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "smooth_axis.h"
+#include "smooth_axis_events.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum number of axes per bank (storage is fixed-size, no heap)
+ *
+ * Override before including this header (or via -D) to trade RAM for capacity.
+ * Each slot costs 18 bytes of state.
+ */
+#ifndef SMOOTH_AXIS_BANK_MAX_AXES
+#define SMOOTH_AXIS_BANK_MAX_AXES 128
+#endif
+
+/**
+ * @brief Runtime state for a bank of axes sharing one config
+ *
+ * Opaque structure - do not access fields directly.
+ * Initialize with smooth_axis_bank_init() after building config.
+ */
+typedef struct {
+  smooth_axis_config_t cfg;
+  size_t               count;
+
+  // Internal runtime state (do not access directly), one slot per axis
+  float _smoothed_norm[SMOOTH_AXIS_BANK_MAX_AXES];
+  float _noise_estimate_norm[SMOOTH_AXIS_BANK_MAX_AXES];
+  float _last_residual[SMOOTH_AXIS_BANK_MAX_AXES];
+  float _last_reported_norm[SMOOTH_AXIS_BANK_MAX_AXES];
+
+  // Every update carries a sample for every axis, so seeding is bank-wide
+  bool _has_first_sample;
+
+  // AUTO_DT internal state (one timebase for the whole bank)
+  smooth_axis_warmup_t _warmup;
+
+  // LIVE_DT internal state (one dt per scan)
+  smooth_axis_alpha_cache_t _live_alpha;
+
+  // Optional caller-owned change bitmask (NULL = poll with has_new_value())
+  uint32_t *_change_mask;
+
+  // Optional caller-owned event queue (NULL = no events)
+  smooth_axis_event_queue_t *_events;
+  uint16_t                   _event_slot[SMOOTH_AXIS_BANK_MAX_AXES];  // Queue slot of each axis' last event
+
+#if SMOOTH_AXIS_STATS
+  smooth_axis_stats_t _stats;  // Summed over all axes
+#endif
+} smooth_axis_bank_t;
+
+/** @brief Number of uint32_t words a change mask needs for `count` axes */
+#define SMOOTH_AXIS_BANK_MASK_WORDS(count) (((count) + 31u) / 32u)
+
+// ----------------------------------------------------------------------------
+// Init
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Initialize a bank of `count` axes from one config
+ *
+ * @param[out] bank  Bank state to initialize
+ * @param[in]  cfg   Config shared by all axes (copied once)
+ * @param[in]  count Number of axes [1 .. SMOOTH_AXIS_BANK_MAX_AXES]
+ *
+ * @note AUTO_DT mode: one warmup calibrates the whole bank (one now_ms() per update).
+ */
+void smooth_axis_bank_init(smooth_axis_bank_t *bank,
+                           const smooth_axis_config_t *cfg,
+                           size_t count);
+
+/** @brief Same as smooth_axis_seed_auto_dt() (one seed for the shared warmup) */
+void smooth_axis_bank_seed_auto_dt(smooth_axis_bank_t *bank, float dt_sec);
+
+/** @brief Same as smooth_axis_get_auto_dt_sec() */
+float smooth_axis_bank_get_auto_dt_sec(const smooth_axis_bank_t *bank);
+
+// ----------------------------------------------------------------------------
+// Core update API (call one of these each scan)
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Update all axes with one scan of raw samples (AUTO_DT mode)
+ *
+ * Equivalent to calling smooth_axis_update_auto_dt() on `n` independent axes,
+ * except that the warmup timer is read once per call.
+ *
+ * @param[in,out] bank Bank state (mode must be AUTO_DT)
+ * @param[in]     raw  Raw ADC readings, raw[i] belongs to axis i
+ * @param[in]     n    Number of readings (must equal bank count)
+ */
+void smooth_axis_bank_update_auto_dt(smooth_axis_bank_t *bank,
+                                     const uint16_t *raw,
+                                     size_t n);
+
+/**
+ * @brief Update all axes with one scan of raw samples (LIVE_DT mode)
+ *
+ * Equivalent to calling smooth_axis_update_live_dt() on `n` independent axes,
+ * except that alpha is computed once per call.
+ *
+ * @param[in,out] bank   Bank state (mode must be LIVE_DT)
+ * @param[in]     raw    Raw ADC readings, raw[i] belongs to axis i
+ * @param[in]     n      Number of readings (must equal bank count)
+ * @param[in]     dt_sec Time elapsed since last scan (seconds)
+ */
+void smooth_axis_bank_update_live_dt(smooth_axis_bank_t *bank,
+                                     const uint16_t *raw,
+                                     size_t n,
+                                     float dt_sec);
+
+/**
+ * @brief Update one axis with its own dt (LIVE_DT mode)
+ *
+ * For callers that convert channels at different rates (see smooth_axis_sched.h).
+ * Same per-axis math as smooth_axis_bank_update_live_dt(), with alpha evaluated
+ * for this axis' dt, and the change mask (if attached) updated for this axis.
+ *
+ * @param[in,out] bank   Bank state (mode must be LIVE_DT)
+ * @param[in]     index  Axis to update [0 .. count-1]
+ * @param[in]     raw    Raw ADC reading for that axis
+ * @param[in]     dt_sec Time elapsed since this axis' previous sample (seconds)
+ *
+ * @note The bank must already have had one full-scan update, which seeds every
+ *       axis (ignored with an error until then).
+ */
+void smooth_axis_bank_update_axis_live_dt(smooth_axis_bank_t *bank,
+                                          size_t index,
+                                          uint16_t raw,
+                                          float dt_sec);
+
+// ----------------------------------------------------------------------------
+// Per-axis output + change detection
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Let the update path report changes into a bitmask instead of polling
+ *
+ * After this call, every bank update runs the has_new_value() decision for all
+ * axes in one fused pass and sets bit (i % 32) of mask[i / 32] for each axis i
+ * that has a new value. Bits are only ever set; the consumer clears the bits
+ * (or words) it has handled. Iterating set bits turns an O(count) poll into
+ * O(changed):
+ *
+ * @code
+ * static uint32_t changed[SMOOTH_AXIS_BANK_MASK_WORDS(NUM_KEYS)];
+ * smooth_axis_bank_set_change_mask(&keys, changed);
+ *
+ * smooth_axis_bank_update_auto_dt(&keys, raw, NUM_KEYS);
+ * for (size_t w = 0; w < SMOOTH_AXIS_BANK_MASK_WORDS(NUM_KEYS); w++) {
+ *     while (changed[w]) {
+ *         size_t i = w * 32 + (size_t)__builtin_ctz(changed[w]);
+ *         changed[w] &= changed[w] - 1;   // Clear lowest set bit
+ *         hid_report_key(i, smooth_axis_bank_get_u16(&keys, i));
+ *     }
+ * }
+ * @endcode
+ *
+ * @param[in,out] bank Bank state
+ * @param[in]     mask SMOOTH_AXIS_BANK_MASK_WORDS(bank count) words, or NULL to disable
+ *
+ * @note While a mask is attached, smooth_axis_bank_has_new_value() would see
+ *       changes that were already reported and returns false for them - use one or the other.
+ */
+void smooth_axis_bank_set_change_mask(smooth_axis_bank_t *bank, uint32_t *mask);
+
+/**
+ * @brief Let the update path push report events into a queue
+ *
+ * Same decisions as the change mask (both can be attached at once): every bank
+ * update pushes one event per reported axis, axis order within a scan, stamped
+ * once per scan from the queue clock. See smooth_axis_events.h for the overflow
+ * policies and the drain loop.
+ *
+ * @param[in,out] bank   Bank state
+ * @param[in]     events Initialized queue (must outlive the attachment), or NULL to detach
+ *
+ * @note Like the change mask, reported changes no longer show up in
+ *       smooth_axis_bank_has_new_value().
+ */
+void smooth_axis_bank_set_event_queue(smooth_axis_bank_t *bank, smooth_axis_event_queue_t *events);
+
+/** @brief Per-axis smooth_axis_get_norm(). Returns 0.0 if index is out of range. */
+float smooth_axis_bank_get_norm(const smooth_axis_bank_t *bank, size_t index);
+
+/** @brief Per-axis smooth_axis_get_u16(). Returns 0 if index is out of range. */
+uint16_t smooth_axis_bank_get_u16(const smooth_axis_bank_t *bank, size_t index);
+
+/** @brief Per-axis smooth_axis_has_new_value(). Returns false if index is out of range. */
+bool smooth_axis_bank_has_new_value(smooth_axis_bank_t *bank, size_t index);
+
+/** @brief Per-axis smooth_axis_get_noise_norm(). Returns 0.0 if index is out of range. */
+float smooth_axis_bank_get_noise_norm(const smooth_axis_bank_t *bank, size_t index);
+
+/** @brief Same as smooth_axis_get_stats(), counted over all axes of the bank */
+void smooth_axis_bank_get_stats(const smooth_axis_bank_t *bank, smooth_axis_stats_t *out);
+
+/** @brief Same as smooth_axis_reset_stats() */
+void smooth_axis_bank_reset_stats(smooth_axis_bank_t *bank);
+
+#ifdef __cplusplus
+}
+#endif
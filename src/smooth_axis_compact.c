@@ -0,0 +1,289 @@
+/**
+ * @file smooth_axis_compact.c
+ * @brief Implementation of packed 8-byte axes
+ * @author Jonatan Vider
+ *
+ * See smooth_axis_compact.h for API documentation.
+ */
+
+#include "smooth_axis_compact.h"
+#include "smooth_axis_internal.h"
+
+// ============================================================================
+// Packing
+// ============================================================================
+
+enum {
+  COMPACT_FIRST_SAMPLE = 0x01,
+  COMPACT_RESIDUAL_POS = 0x02,
+  COMPACT_RESIDUAL_NEG = 0x04,
+};
+
+#define COMPACT_POS_MAX   0xFFFFFFu  // 24-bit position, 1.0 saturates one step below 2^24
+#define COMPACT_NOISE_MAX 0xFFFFu    // Minifloat code just below 1.0
+
+#if !SMOOTH_AXIS_FIXED_POINT
+static const float COMPACT_POS_SCALE = 16777216.0f;  // 2^24
+#endif
+
+// Position [0 .. 1] <-> 24 bits (high 16 in _smoothed, low 8 in _sm_lo)
+static inline smooth_axis_value_t unpack_pos(const smooth_axis_compact_t *axis) {
+    uint32_t q = (uint32_t)axis->_smoothed << 8 | axis->_sm_lo;
+#if SMOOTH_AXIS_FIXED_POINT
+    return (int32_t)(q << 6);  // Q24 -> Q30
+#else
+    return (float)q * (1.0f / COMPACT_POS_SCALE);  // Exact: q has 24 significant bits
+#endif
+}
+
+static inline void pack_pos(smooth_axis_compact_t *axis, smooth_axis_value_t v) {
+#if SMOOTH_AXIS_FIXED_POINT
+    int32_t  r = (v + 32) >> 6;
+    uint32_t q = r <= 0 ? 0u : ((uint32_t)r > COMPACT_POS_MAX ? COMPACT_POS_MAX : (uint32_t)r);
+#else
+    // No "+ 0.5f": above 2^23 the sum itself would round. r - trunc(r) is exact.
+    float    r = v * COMPACT_POS_SCALE;
+    uint32_t q = r <= 0.0f ? 0u : (r >= (float)COMPACT_POS_MAX ? COMPACT_POS_MAX : (uint32_t)r);
+    if (q < COMPACT_POS_MAX && r - (float)q >= 0.5f) { q++; }
+#endif
+    axis->_smoothed = (uint16_t)(q >> 8);
+    axis->_sm_lo    = (uint8_t)q;
+}
+
+// Noise estimate: 16-bit unsigned minifloat (4-bit exponent, 12-bit mantissa).
+// The estimate decays by NOISE_SMOOTHING_RATE per sample on a clean signal, so
+// it needs relative precision: a fixed 2^-18 step rounds every decay step by up
+// to half its size and the packed estimate drifts away from the float one. With
+// 12 mantissa bits each step is rounded by at most 1/8192 of the value.
+//
+//   code <  4096   value = code · 2^-27              (linear below 2^-15)
+//   code >= 4096   value = (4096 + m) · 2^(e - 28)   e = code >> 12, m = code & 4095
+//
+// Both encodings work on the Q30 value, so float and fixed-point builds pack
+// identically. 0xFFFF is just below 1.0, the top of the noise_step() clamp.
+static inline int compact_msb(uint32_t v) {  // v != 0
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(v);
+#else
+    int p = 0;
+    while (v >>= 1) { p++; }
+    return p;
+#endif
+}
+
+static inline uint16_t noise_code_from_q30(int32_t q) {
+    if (q <= 0) { return 0; }
+    if (q < (1 << 15)) { return (uint16_t)((q + 4) >> 3); }  // 4096 at the top
+
+    int      p    = compact_msb((uint32_t)q);  // 15 .. 30
+    uint32_t mant = ((uint32_t)q + (1u << (p - 13))) >> (p - 12);  // 4096 .. 8192 (carry)
+    uint32_t code = ((uint32_t)(p - 15) << 12) + mant;
+    return (uint16_t)(code > COMPACT_NOISE_MAX ? COMPACT_NOISE_MAX : code);
+}
+
+static inline int32_t noise_q30_from_code(uint16_t code) {
+    if (code < 4096) { return (int32_t)code << 3; }
+    return (int32_t)(4096u + (code & 4095u)) << ((code >> 12) + 2);
+}
+
+static inline smooth_axis_value_t unpack_noise(const smooth_axis_compact_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return noise_q30_from_code(axis->_noise);
+#else
+    return (float)noise_q30_from_code(axis->_noise) * (1.0f / 1073741824.0f);  // Exact
+#endif
+}
+
+static inline uint16_t pack_noise(smooth_axis_value_t v) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return noise_code_from_q30(v);
+#else
+    return noise_code_from_q30(v >= 1.0f ? 0x40000000 : (int32_t)(v * 1073741824.0f + 0.5f));
+#endif
+}
+
+// Reported position [0 .. 1] <-> 1/65535 units (exact at both ends)
+static inline smooth_axis_value_t unpack_reported(const smooth_axis_compact_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return (int32_t)((((int64_t)axis->_reported << 30) + 32767) / 65535);
+#else
+    return (float)axis->_reported * (1.0f / 65535.0f);
+#endif
+}
+
+static inline uint16_t pack_reported(smooth_axis_value_t v) {
+#if SMOOTH_AXIS_FIXED_POINT
+    int64_t u = ((int64_t)v * 65535 + Q30_HALF) >> 30;
+#else
+    float u = v * 65535.0f + 0.5f;
+#endif
+    return (uint16_t)(u <= 0 ? 0 : (u >= 65535 ? 65535 : u));
+}
+
+// Only the residual's sign feeds the next sign-flip test
+static inline smooth_axis_value_t unpack_residual(const smooth_axis_compact_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    const smooth_axis_value_t unit = 1;
+#else
+    const smooth_axis_value_t unit = 1.0f / COMPACT_POS_SCALE;
+#endif
+    return (axis->_flags & COMPACT_RESIDUAL_POS) ? unit
+         : (axis->_flags & COMPACT_RESIDUAL_NEG) ? -unit : 0;
+}
+
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static smooth_axis_value_t compact_get_normalized(const smooth_axis_compact_t *axis,
+                                                  const smooth_axis_shared_cfg_t *shared) {
+    if (!(axis->_flags & COMPACT_FIRST_SAMPLE)) {
+        return 0;
+    }
+#if SMOOTH_AXIS_FIXED_POINT
+    return apply_sticky_margins_q30(&shared->_fx, unpack_pos(axis));
+#else
+    return apply_sticky_margins(&shared->cfg, unpack_pos(axis));
+#endif
+}
+
+// Same per-sample math as smooth_axis_shared_update_live_dt(), on unpacked state
+static inline void compact_step(smooth_axis_compact_t *axis,
+                                smooth_axis_value_t norm,
+                                smooth_axis_value_t alpha) {
+    if (!(axis->_flags & COMPACT_FIRST_SAMPLE)) {  // First sample teleports (skip EMA on frame 0)
+        axis->_flags = COMPACT_FIRST_SAMPLE;
+        pack_pos(axis, norm);
+        return;
+    }
+
+    smooth_axis_value_t smoothed = unpack_pos(axis);
+    smooth_axis_value_t diff     = norm - smoothed;
+#if SMOOTH_AXIS_FIXED_POINT
+    smoothed += q30_mul(alpha, diff);
+    smooth_axis_value_t noise = noise_step_q30(unpack_noise(axis), diff, unpack_residual(axis));
+#else
+    smoothed += alpha * diff;
+    smooth_axis_value_t noise = noise_step(unpack_noise(axis), diff, unpack_residual(axis));
+#endif
+    pack_pos(axis, smoothed);
+    axis->_noise = pack_noise(noise);
+    axis->_flags = (uint8_t)(COMPACT_FIRST_SAMPLE
+                             | (diff > 0 ? COMPACT_RESIDUAL_POS : 0)
+                             | (diff < 0 ? COMPACT_RESIDUAL_NEG : 0));
+}
+
+
+// ============================================================================
+// Public API - Init
+// ============================================================================
+
+void smooth_axis_compact_init(smooth_axis_compact_t *axes, size_t count) {
+    SMOOTH_AXIS_CHECK_RETURN(axes != NULL || count == 0, "axes is NULL");
+
+    uint16_t noise = pack_noise(shared_initial_noise());
+    for (size_t i = 0; i < count; i++) {
+        axes[i]._smoothed = 0;
+        axes[i]._sm_lo    = 0;
+        axes[i]._noise    = noise;
+        axes[i]._reported = 0;
+        axes[i]._flags    = 0;
+    }
+}
+
+void smooth_axis_compact_reset(smooth_axis_compact_t *axis,
+                               const smooth_axis_shared_cfg_t *shared,
+                               uint16_t raw_value) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(shared != NULL, "shared config is NULL");
+
+    smooth_axis_value_t norm = raw_value ? shared_input_norm(shared, raw_value) : 0;
+
+    pack_pos(axis, norm);
+    axis->_noise    = pack_noise(shared_initial_noise());
+    axis->_reported = pack_reported(norm);
+    axis->_flags    = raw_value ? COMPACT_FIRST_SAMPLE : 0;
+}
+
+
+// ============================================================================
+// Public API - Update
+// ============================================================================
+
+void smooth_axis_compact_update_live_dt(smooth_axis_compact_t *axis,
+                                        smooth_axis_shared_cfg_t *shared,
+                                        uint16_t raw_value,
+                                        float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(shared != NULL, "shared config is NULL");
+
+    compact_step(axis, shared_input_norm(shared, raw_value), shared_alpha(shared, dt_sec));
+}
+
+void smooth_axis_compact_update_scan(smooth_axis_compact_t *axes,
+                                     smooth_axis_shared_cfg_t *shared,
+                                     const uint16_t *raw,
+                                     size_t n,
+                                     float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN((axes != NULL && raw != NULL) || n == 0, "axes or raw is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(shared != NULL, "shared config is NULL");
+
+    const smooth_axis_value_t alpha = shared_alpha(shared, dt_sec);  // Once per scan
+    for (size_t i = 0; i < n; i++) {
+        compact_step(&axes[i], shared_input_norm(shared, raw[i]), alpha);
+    }
+}
+
+
+// ============================================================================
+// Public API - Output & Query
+// ============================================================================
+
+bool smooth_axis_compact_has_new_value(smooth_axis_compact_t *axis,
+                                       const smooth_axis_shared_cfg_t *shared) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(axis != NULL, "axis is NULL", false);
+    SMOOTH_AXIS_CHECK_RETURN_VAL(shared != NULL, "shared config is NULL", false);
+    if (!(axis->_flags & COMPACT_FIRST_SAMPLE)) { return false; }
+
+    smooth_axis_value_t last = unpack_reported(axis);
+#if SMOOTH_AXIS_FIXED_POINT
+    bool changed = report_if_changed_q30(&shared->_fx, &shared->cfg,
+                                         compact_get_normalized(axis, shared),
+                                         unpack_noise(axis), &last);
+#else
+    bool changed = report_if_changed(&shared->cfg,
+                                     compact_get_normalized(axis, shared),
+                                     unpack_noise(axis), &last);
+#endif
+    if (changed) { axis->_reported = pack_reported(last); }
+    return changed;
+}
+
+float smooth_axis_compact_get_norm(const smooth_axis_compact_t *axis,
+                                   const smooth_axis_shared_cfg_t *shared) {
+    SMOOTH_AXIS_GUARD_VAL(axis != NULL && shared != NULL, 0.0f);
+#if SMOOTH_AXIS_FIXED_POINT
+    return q30_to_f(compact_get_normalized(axis, shared));
+#else
+    return compact_get_normalized(axis, shared);
+#endif
+}
+
+uint16_t smooth_axis_compact_get_u16(const smooth_axis_compact_t *axis,
+                                     const smooth_axis_shared_cfg_t *shared) {
+    SMOOTH_AXIS_GUARD_VAL(axis != NULL && shared != NULL, 0);
+#if SMOOTH_AXIS_FIXED_POINT
+    return output_u16_q30(&shared->cfg, compact_get_normalized(axis, shared));
+#else
+    return output_u16(&shared->cfg, compact_get_normalized(axis, shared));
+#endif
+}
+
+float smooth_axis_compact_get_noise_norm(const smooth_axis_compact_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return axis ? q30_to_f(unpack_noise(axis)) : 0.0f;
+#else
+    return axis ? unpack_noise(axis) : 0.0f;
+#endif
+}
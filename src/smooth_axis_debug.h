@@ -8,6 +8,9 @@
  * 1. ASSERTIONS - Catch bugs during development (debug builds only)
  * 2. LOGGING - Observe behavior at runtime (optional, all builds)
  *
+ * How much checking survives into a build is set by SMOOTH_AXIS_CHECK_LEVEL
+ * (assert / early return / unchecked), see below.
+ *
  * Quick start:
  * @code
  * // Assertions (active in debug builds):
@@ -23,16 +26,45 @@
 
 #include <stddef.h>  // For NULL
 
+// ============================================================================
+// Check Level - How much argument checking the API does
+// ============================================================================
+// SMOOTH_AXIS_CHECK_LEVEL selects what the guards below compile to:
+//   2  Assert:    guards halt on failure (default without NDEBUG)
+//   1  Return:    guards return early and silently (default with NDEBUG)
+//   0  Unchecked: guards compile to nothing - no NULL, mode or range tests
+//                 anywhere on the update path ("unchecked fast" build)
+//
+// Level 0 trades the graceful-degradation contract for the shortest update
+// path: passing NULL, calling the wrong mode's update function or an
+// out-of-range bank index is undefined behavior, and getters no longer
+// return 0 for a NULL axis. Use it once the integration is proven with a
+// checked build. It must be the same for every smooth_axis translation unit.
+//
+// Example: -DNDEBUG -DSMOOTH_AXIS_CHECK_LEVEL=0
+
+#ifndef SMOOTH_AXIS_CHECK_LEVEL
+  #ifdef NDEBUG
+    #define SMOOTH_AXIS_CHECK_LEVEL 1
+  #else
+    #define SMOOTH_AXIS_CHECK_LEVEL 2
+  #endif
+#endif
+
+#if SMOOTH_AXIS_CHECK_LEVEL < 0 || SMOOTH_AXIS_CHECK_LEVEL > 2
+  #error "SMOOTH_AXIS_CHECK_LEVEL must be 0, 1 or 2"
+#endif
+
 // ============================================================================
 // Assertions - Catch programming errors in debug builds
 // ============================================================================
-// Controlled by NDEBUG (standard C):
+// Active at check level 2 only:
 //   Debug:   Assertions halt on failure
 //   Release: Compiled to nothing (zero cost)
 //
 // Use for: NULL checks, mode mismatches, invalid state
 
-#ifndef NDEBUG
+#if SMOOTH_AXIS_CHECK_LEVEL >= 2
 
 #include <assert.h>
 
@@ -46,21 +78,38 @@
 // ============================================================================
 // Smart Guards - Assert in debug, early return in release
 // ============================================================================
-// Debug:   Crash on failure (find bugs fast)
-// Release: Silent early return (graceful degradation)
+// Level 2: Crash on failure (find bugs fast)
+// Level 1: Silent early return (graceful degradation)
+// Level 0: Nothing (caller guarantees valid arguments)
 
-#ifndef NDEBUG
+#if SMOOTH_AXIS_CHECK_LEVEL >= 2
 #define SMOOTH_AXIS_CHECK_RETURN(condition, message) \
     SMOOTH_AXIS_ASSERT(condition, message)
 
 #define SMOOTH_AXIS_CHECK_RETURN_VAL(condition, message, retval) \
     SMOOTH_AXIS_ASSERT(condition, message)
-#else
+#elif SMOOTH_AXIS_CHECK_LEVEL == 1
 #define SMOOTH_AXIS_CHECK_RETURN(condition, message) \
     do { if (!(condition)) { return; } } while(0)
   
 #define SMOOTH_AXIS_CHECK_RETURN_VAL(condition, message, retval) \
     do { if (!(condition)) { return (retval); } } while(0)
+#else
+#define SMOOTH_AXIS_CHECK_RETURN(condition, message) \
+    ((void)0)
+
+#define SMOOTH_AXIS_CHECK_RETURN_VAL(condition, message, retval) \
+    ((void)0)
+#endif
+
+// Quiet guard for getters documented to return a neutral value on NULL:
+// early return at levels 1-2 (never asserts), nothing at level 0.
+#if SMOOTH_AXIS_CHECK_LEVEL >= 1
+#define SMOOTH_AXIS_GUARD_VAL(condition, retval) \
+    do { if (!(condition)) { return (retval); } } while(0)
+#else
+#define SMOOTH_AXIS_GUARD_VAL(condition, retval) \
+    ((void)0)
 #endif
 
 // ============================================================================
@@ -0,0 +1,136 @@
+/**
+ * @file smooth_axis_events.c
+ * @brief Implementation of the report event queue
+ * @author Jonatan Vider
+ *
+ * See smooth_axis_events.h for API documentation.
+ */
+
+#include "smooth_axis_events.h"
+#include "smooth_axis_internal.h"
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline uint16_t queue_slot(const smooth_axis_event_queue_t *q, uint16_t offset) {
+    uint32_t slot = (uint32_t)q->_head + offset;
+    return (uint16_t)(slot >= q->_capacity ? slot - q->_capacity : slot);
+}
+
+// True if buffer slot `slot` holds a queued (not yet drained) event
+static inline bool queue_slot_live(const smooth_axis_event_queue_t *q, uint16_t slot) {
+    if (slot >= q->_capacity) { return false; }
+    uint32_t offset = slot >= q->_head ? (uint32_t)slot - q->_head : (uint32_t)slot + q->_capacity - q->_head;
+    return offset < q->_count;
+}
+
+// COALESCE: the axis' queued event, or NULL if it has none. With a slot hint
+// this is one check: COALESCE queues hold at most one event per axis, so a live
+// slot carrying the axis is that event however the queue moved since.
+// Without one it scans the queue.
+static smooth_axis_event_t *queue_find(smooth_axis_event_queue_t *q, uint16_t axis, const uint16_t *slot) {
+    if (slot) {
+        return queue_slot_live(q, *slot) && q->_buf[*slot].axis == axis ? &q->_buf[*slot] : NULL;
+    }
+    for (uint16_t k = 0; k < q->_count; k++) {
+        smooth_axis_event_t *ev = &q->_buf[queue_slot(q, k)];
+        if (ev->axis == axis) { return ev; }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void smooth_axis_event_queue_init(smooth_axis_event_queue_t *queue,
+                                  smooth_axis_event_t *buf,
+                                  size_t capacity,
+                                  smooth_axis_events_overflow_t overflow,
+                                  smooth_axis_now_ms_fn now_ms) {
+    SMOOTH_AXIS_CHECK_RETURN(queue != NULL, "queue is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(buf != NULL, "event buffer is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(capacity > 0 && capacity <= 0xFFFFu, "event capacity out of range");
+
+    queue->_buf       = buf;
+    queue->_capacity  = (uint16_t)capacity;
+    queue->_head      = 0;
+    queue->_count     = 0;
+    queue->_overflow  = overflow;
+    queue->_now_ms    = now_ms;
+    queue->_ticks     = 0;
+    queue->_dropped   = 0;
+    queue->_coalesced = 0;
+}
+
+void smooth_axis_event_queue_push(smooth_axis_event_queue_t *queue,
+                                  uint16_t axis,
+                                  uint16_t u16,
+                                  uint32_t timestamp) {
+    smooth_axis_event_queue_push_at(queue, axis, u16, timestamp, NULL);
+}
+
+void smooth_axis_event_queue_push_at(smooth_axis_event_queue_t *queue,
+                                     uint16_t axis,
+                                     uint16_t u16,
+                                     uint32_t timestamp,
+                                     uint16_t *slot) {
+    SMOOTH_AXIS_CHECK_RETURN(queue != NULL, "queue is NULL");
+
+    if (queue->_overflow == SMOOTH_AXIS_EVENTS_COALESCE) {
+        smooth_axis_event_t *queued = queue_find(queue, axis, slot);
+        if (queued) {
+            queued->u16       = u16;
+            queued->timestamp = timestamp;
+            queue->_coalesced++;
+            return;
+        }
+    }
+    if (queue->_count == queue->_capacity) {  // Full: drop the oldest event
+        queue->_head = queue_slot(queue, 1);
+        queue->_count--;
+        queue->_dropped++;
+    }
+
+    uint16_t             tail = queue_slot(queue, queue->_count);
+    smooth_axis_event_t *ev   = &queue->_buf[tail];
+    ev->axis      = axis;
+    ev->u16       = u16;
+    ev->timestamp = timestamp;
+    queue->_count++;
+    if (slot) { *slot = tail; }
+}
+
+size_t smooth_axis_event_queue_drain(smooth_axis_event_queue_t *queue,
+                                     smooth_axis_event_t *out,
+                                     size_t max) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(queue != NULL, "queue is NULL", 0);
+    SMOOTH_AXIS_CHECK_RETURN_VAL(out != NULL || max == 0, "out is NULL", 0);
+
+    size_t n = queue->_count < max ? queue->_count : max;
+    for (size_t k = 0; k < n; k++) {
+        out[k]       = queue->_buf[queue->_head];
+        queue->_head = queue_slot(queue, 1);
+    }
+    queue->_count = (uint16_t)(queue->_count - n);
+    return n;
+}
+
+uint32_t smooth_axis_event_queue_now(const smooth_axis_event_queue_t *queue) {
+    if (!queue) { return 0; }
+
+    return queue->_now_ms ? queue->_now_ms() : queue->_ticks;
+}
+
+size_t smooth_axis_event_queue_count(const smooth_axis_event_queue_t *queue) {
+    return queue ? queue->_count : 0;
+}
+
+uint32_t smooth_axis_event_queue_dropped(const smooth_axis_event_queue_t *queue) {
+    return queue ? queue->_dropped : 0;
+}
+
+uint32_t smooth_axis_event_queue_coalesced(const smooth_axis_event_queue_t *queue) {
+    return queue ? queue->_coalesced : 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file smooth_axis_events.h
+ * @brief Report events in a caller-supplied ring buffer (push instead of poll)
+ *
+ * @author Jonatan Vider
+ *
+ * The change mask (smooth_axis_bank_set_change_mask()) tells the consumer which
+ * axes changed, but it still has to read each value and knows nothing about
+ * when. An event queue attached to a bank receives one (axis, u16, timestamp)
+ * event per report, in report order, so a MIDI/HID encoder can drain a whole
+ * batch and build its reports from the events alone.
+ *
+ * The buffer is fixed-size and owned by the caller (no heap). When the update
+ * path produces more events than the consumer drains, the overflow policy
+ * decides what is kept:
+ *
+ *   SMOOTH_AXIS_EVENTS_DROP_OLDEST  every report is queued; a full queue drops
+ *                                   its oldest event (a stream of positions)
+ *   SMOOTH_AXIS_EVENTS_COALESCE     at most one queued event per axis: a new
+ *                                   report updates the queued one in place
+ *                                   (value and timestamp; it keeps its place).
+ *                                   Never drops while capacity >= axis count
+ *
+ * Timestamps come from the queue's clock: now_ms() ticks if one was given,
+ * otherwise the number of producer updates since the queue was attached.
+ *
+ * Typical usage:
+ * @code
+ * static smooth_axis_event_t       ev_buf[NUM_KEYS];
+ * static smooth_axis_event_queue_t events;
+ *
+ * smooth_axis_event_queue_init(&events, ev_buf, NUM_KEYS, SMOOTH_AXIS_EVENTS_COALESCE, my_timer_fn);
+ * smooth_axis_bank_set_event_queue(&keys, &events);
+ *
+ * smooth_axis_bank_update_auto_dt(&keys, raw, NUM_KEYS);
+ * smooth_axis_event_t batch[16];
+ * size_t n;
+ * while ((n = smooth_axis_event_queue_drain(&events, batch, 16)) > 0) {
+ *     hid_send_keys(batch, n);
+ * }
+ * @endcode
+ *
+ * @note Not an ISR-to-main-loop channel: push and drain from the same context
+ *       (see smooth_axis_spsc.h for the ISR split).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "smooth_axis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief One report: which axis, its new output, and when */
+typedef struct {
+  uint16_t axis;       // Axis index (bank slot)
+  uint16_t u16;        // Output at report time (same as get_u16())
+  uint32_t timestamp;  // Queue clock at report time
+} smooth_axis_event_t;
+
+/** @brief What a report does when the queue is full (or already holds its axis) */
+typedef enum {
+  SMOOTH_AXIS_EVENTS_DROP_OLDEST = 0,
+  SMOOTH_AXIS_EVENTS_COALESCE,
+} smooth_axis_events_overflow_t;
+
+/**
+ * @brief Ring buffer of events over caller-owned storage
+ *
+ * Opaque structure - do not access fields directly.
+ * Initialize with smooth_axis_event_queue_init().
+ */
+typedef struct {
+  smooth_axis_event_t          *_buf;
+  uint16_t                      _capacity;
+  uint16_t                      _head;   // Oldest queued event
+  uint16_t                      _count;
+  smooth_axis_events_overflow_t _overflow;
+  smooth_axis_now_ms_fn         _now_ms;  // NULL: timestamps count producer updates
+  uint32_t                      _ticks;   // Producer updates (clockless timestamps)
+  uint32_t                      _dropped;
+  uint32_t                      _coalesced;
+} smooth_axis_event_queue_t;
+
+/**
+ * @brief Initialize an empty queue over `capacity` events of storage
+ *
+ * @param[out] queue    Queue to initialize
+ * @param[in]  buf      Event storage (must outlive the queue)
+ * @param[in]  capacity Number of events in buf [1 .. 65535]
+ * @param[in]  overflow Overflow policy
+ * @param[in]  now_ms   Timestamp clock (may be NULL, see file comment)
+ */
+void smooth_axis_event_queue_init(smooth_axis_event_queue_t *queue,
+                                  smooth_axis_event_t *buf,
+                                  size_t capacity,
+                                  smooth_axis_events_overflow_t overflow,
+                                  smooth_axis_now_ms_fn now_ms);
+
+/**
+ * @brief Queue one report (done by the bank update path; also usable directly)
+ *
+ * @param[in,out] queue     Queue
+ * @param[in]     axis      Axis index
+ * @param[in]     u16       Reported output
+ * @param[in]     timestamp Report time (see smooth_axis_event_queue_now())
+ *
+ * @note COALESCE: scans the queued events for the axis (O(queued events)).
+ *       smooth_axis_event_queue_push_at() does it in constant time.
+ */
+void smooth_axis_event_queue_push(smooth_axis_event_queue_t *queue,
+                                  uint16_t axis,
+                                  uint16_t u16,
+                                  uint32_t timestamp);
+
+/**
+ * @brief smooth_axis_event_queue_push() with a per-axis slot index (what the bank uses)
+ *
+ * The caller keeps one uint16_t per axis and passes the same one with every
+ * push for that axis. The queue records where the axis' event went, so a
+ * COALESCE push checks one slot instead of scanning. Any initial value works,
+ * and drains or drops need no bookkeeping from the caller.
+ *
+ * @param[in,out] queue     Queue
+ * @param[in]     axis      Axis index
+ * @param[in]     u16       Reported output
+ * @param[in]     timestamp Report time (see smooth_axis_event_queue_now())
+ * @param[in,out] slot      This axis' slot index
+ */
+void smooth_axis_event_queue_push_at(smooth_axis_event_queue_t *queue,
+                                     uint16_t axis,
+                                     uint16_t u16,
+                                     uint32_t timestamp,
+                                     uint16_t *slot);
+
+/**
+ * @brief Move up to `max` of the oldest events into `out`
+ *
+ * @return Number of events copied (0 when the queue is empty)
+ */
+size_t smooth_axis_event_queue_drain(smooth_axis_event_queue_t *queue,
+                                     smooth_axis_event_t *out,
+                                     size_t max);
+
+/** @brief Current queue clock: now_ms() if set, else the producer update count */
+uint32_t smooth_axis_event_queue_now(const smooth_axis_event_queue_t *queue);
+
+/** @brief Number of queued events */
+size_t smooth_axis_event_queue_count(const smooth_axis_event_queue_t *queue);
+
+/** @brief Events lost to a full queue since init */
+uint32_t smooth_axis_event_queue_dropped(const smooth_axis_event_queue_t *queue);
+
+/** @brief COALESCE: reports merged into an already queued event since init */
+uint32_t smooth_axis_event_queue_coalesced(const smooth_axis_event_queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,785 @@
+/**
+ * @file smooth_axis_internal.h
+ * @brief Shared filter math for the smooth_axis translation units
+ * @author Jonatan Vider
+ *
+ * Not part of the public API. Holds the tuning constants and the per-sample
+ * math (input mapping, EMA, noise estimate, output mapping) so that the
+ * single-axis and multi-axis front-ends run exactly the same arithmetic.
+ */
+
+#pragma once
+
+#include "smooth_axis.h"
+#include "smooth_axis_debug.h"
+#include "smooth_axis_shared.h"  // smooth_axis_shared_cfg_t, for the shared-config helpers
+#include <math.h>
+
+// ----------------------------------------------------------------------------
+// Internal Constants
+// ----------------------------------------------------------------------------
+static const uint16_t SMOOTH_AXIS_INIT_CALIBRATION_CYCLES = 256;
+
+// Clamp measured dt during AUTO warmup to avoid pathological cases
+static const float SMOOTH_AXIS_AUTO_DT_MIN_MS = 0.02f;  // 50,000 Hz max
+static const float SMOOTH_AXIS_AUTO_DT_MAX_MS = 50.0f;  // 20 Hz min
+static const float FALLBACK_DELTA_TIME        = 0.016f; // 60 Hz assumption before warmup
+
+// auto_dt_tracking: share of each window's measured dt blended into the average
+static const float DT_TRACK_GAIN = 0.125f;
+
+// fast_warmup: stop once the warmup mean is known to 1% (after at least 16 deltas)
+static const uint16_t WARMUP_FAST_MIN_CYCLES = 16;
+static const float    WARMUP_FAST_REL_ERROR  = 0.01f;
+
+
+
+// ----------------------------------------------------------------------------
+// Default "Feel" Parameters (normalized to 1023 ADC range)
+// ----------------------------------------------------------------------------
+
+static const float CANONICAL_MAX = 1023.0f; // Reference resolution scale
+static const float FULL_OFF_U    = 0.0f;    // No dead zone by default
+static const float FULL_ON_U     = 1023.0f; // No dead zone by default
+static const float STICKY_U      = 3.0f;    // ~0.3% magnetic zone
+static const float MAX_THRESH_U  = 30.0f;    // ~2.9% upper threshold limit
+
+// EMA convergence: 5% remaining = "settled" (Reached 95%)
+static const float EMA_CONVERGENCE_THRESHOLD = 0.05f;
+
+// Noise estimation: slow EMA for stable noise floor tracking
+static const float NOISE_SMOOTHING_RATE = 0.005f;
+
+// Noise floor assumed before any samples were seen
+static const float INITIAL_NOISE_NORM = 0.01f;
+
+// Dynamic threshold headroom: threshold = 3.5x noise estimate
+static const float THRESHOLD_NOISE_MULTIPLIER = 3.5f;
+
+// Idle detection: residuals within 8x noise estimate (~3.5 sigma, at least one raw step) are "quiet"
+static const int32_t IDLE_NOISE_MULTIPLIER = 8;
+
+//Prevent floor/ceiling overlap (0.5 =< would be ambiguous)
+static const float MAX_STICKY_ZONE = 0.49f;
+
+
+// ============================================================================
+// Inline Math Utilities
+// ============================================================================
+
+static inline float clamp_f(float x, float lo, float hi) {
+    return x < lo ? lo : (x > hi ? hi : x);
+}
+
+static inline float clamp_f_0_1(float x) {
+    return clamp_f(x, 0.0f, 1.0f);
+}
+
+static inline float abs_f(float x) {
+    return x < 0.0f ? -x : x;
+}
+
+// Exponential Moving Average: out = (1-α)·old + α·new
+static inline float ema(float old, float target, float alpha) {
+    return (1.0f - alpha) * old + alpha * target;
+}
+
+// Linear interpolation: map x from [in_min, in_max] to [out_min, out_max]
+static inline float map_f(float x, float in_min, float in_max, float out_min, float out_max) {
+    if (in_max == in_min) {
+        return out_min;  // Degenerate case: avoid division by zero
+    }
+    float t = (x - in_min) / (in_max - in_min);
+    return out_min + t * (out_max - out_min);
+}
+
+// Scale the threshold inversely with settle_time (longer settle times allows lower threshold)
+static inline float compute_dyn_scale(float settle_time_sec) {
+    const float t_ref = 0.1f;  // Reference settle time (100ms)
+    float       ratio = settle_time_sec / t_ref;
+    if (ratio < 1.0f) { ratio = 1.0f; }
+    return 1.0f / ratio;  // Linear inverse scaling
+}
+
+static inline float sign_of(const float residual) {
+    return (residual > 0.0f) ? 1.0f : (residual < 0.0f) ? -1.0f : 0.0f;
+}
+
+// Noise detection heuristic: true movement has consistent sign, noise flips randomly
+static inline bool has_sign_flipped(const float current, const float previous) {
+    float r_sign    = sign_of(current);
+    float last_sign = sign_of(previous);
+    return r_sign != last_sign || (r_sign == 0.0f && last_sign == 0.0f);
+}
+
+
+// ============================================================================
+// Input / Output Mapping Coefficients
+// ============================================================================
+
+// max_raw as used by the math: compile-time constant if SMOOTH_AXIS_MAX_RAW is set, never 0
+static inline uint16_t cfg_max_raw(const smooth_axis_config_t *cfg) {
+#if SMOOTH_AXIS_MAX_RAW
+    (void)cfg;
+    return (uint16_t)SMOOTH_AXIS_MAX_RAW;
+#else
+    return cfg->max_raw ? cfg->max_raw : 1;  // Safety: avoid division by zero
+#endif
+}
+
+// Dead-zone bounds used by the mapping: full range if degenerate or compiled out
+static inline void cfg_dead_zones(const smooth_axis_config_t *cfg, float *off, float *on) {
+#if SMOOTH_AXIS_ENABLE_DEAD_ZONES
+    *off = cfg->full_off_norm;
+    *on  = cfg->full_on_norm;
+    if (*on > *off) { return; }
+#else
+    (void)cfg;
+#endif
+    *off = 0.0f;
+    *on  = 1.0f;
+}
+
+// Sticky zone used by the mapping and report decision (0 when compiled out)
+static inline float cfg_sticky_zone(const smooth_axis_config_t *cfg) {
+#if SMOOTH_AXIS_ENABLE_STICKY
+    return cfg->sticky_zone_norm;
+#else
+    (void)cfg;
+    return 0.0f;
+#endif
+}
+
+// Derive cfg->_map from the feel parameters (config/init time, never per sample).
+// Dead zones: clip to [off .. on], re-stretch to [0..1] == one affine map + clamp_f_0_1().
+static inline void map_coeffs_init(smooth_axis_config_t *cfg) {
+    smooth_axis_map_t *m       = &cfg->_map;
+    float              max_raw = (float)cfg_max_raw(cfg);
+
+    float off, on;
+    cfg_dead_zones(cfg, &off, &on);
+    float span = on - off;
+
+    m->_in_scale  = 1.0f / (span * max_raw);
+    m->_in_offset = -off / span;
+    // Reciprocal rounding must not keep full_on from reaching exactly 1.0 after the clamp
+    while (on * max_raw * m->_in_scale + m->_in_offset < 1.0f) {
+        m->_in_scale = nextafterf(m->_in_scale, 2.0f * m->_in_scale);
+    }
+
+    m->_sticky      = clamp_f(cfg_sticky_zone(cfg), 0.0f, MAX_STICKY_ZONE);
+    m->_sticky_gain = 1.0f + 2.0f * m->_sticky;
+    m->_lsb_norm    = 1.0f / max_raw;
+    m->_top_norm    = (max_raw - 1.0f) / max_raw;
+}
+
+
+// ============================================================================
+// Input Pipeline
+// ============================================================================
+
+// Normalize raw ADC [0..max_raw] to [0..1], with full_off/full_on dead zone clipping
+// input_norm() of a fractional raw value (decimated mean), already clipped to max_raw
+static inline float input_norm_frac(const smooth_axis_config_t *cfg, float raw) {
+#if SMOOTH_AXIS_ENABLE_DEAD_ZONES
+    return clamp_f_0_1(raw * cfg->_map._in_scale + cfg->_map._in_offset);
+#else
+    float norm = raw * cfg->_map._in_scale;  // raw <= max_raw: only the rounded top can pass 1
+    return norm < 1.0f ? norm : 1.0f;
+#endif
+}
+
+static inline float input_norm(const smooth_axis_config_t *cfg, uint16_t raw_value) {
+    uint16_t max_raw = cfg_max_raw(cfg);
+    uint16_t raw     = raw_value > max_raw ? max_raw : raw_value;
+
+    return input_norm_frac(cfg, (float)raw);
+}
+
+
+// ============================================================================
+// Output Pipeline
+// ============================================================================
+
+// True if normalized delta exceeds 1 LSB in integer output (prevents sub-quantum updates)
+static inline bool would_change_output(const smooth_axis_config_t *cfg, float diff) {
+    return diff > cfg->_map._lsb_norm;  // One LSB in normalized space
+}
+
+// Dynamic threshold: scales with noise level, clamped to [1x .. 10x] of base threshold
+static inline float get_dynamic_threshold(const smooth_axis_config_t *cfg, float noise_norm) {
+    float dynamic_threshold      = THRESHOLD_NOISE_MULTIPLIER * noise_norm;
+    float settle_time_attenuated = dynamic_threshold * cfg->_threshold_attenuation;
+    return clamp_f(settle_time_attenuated, 0.0f, MAX_THRESH_U / CANONICAL_MAX);
+}
+
+// Apply sticky zones: endpoints snap to exact 0.0/1.0, middle region re-stretched to [0..1]
+static inline float apply_sticky_margins(const smooth_axis_config_t *cfg, float axis_position) {
+#if SMOOTH_AXIS_ENABLE_STICKY
+    const smooth_axis_map_t *m = &cfg->_map;
+
+    // Snap to endpoints if inside sticky zones
+    if (axis_position <= m->_sticky) { return 0.0f; }
+    if (axis_position >= 1.0f - m->_sticky) { return 1.0f; }
+
+    // Re-stretch middle region to fill [0..1]: map_f(x, 0, 1, -z, 1+z)
+    return clamp_f_0_1(axis_position * m->_sticky_gain - m->_sticky);
+#else
+    (void)cfg;
+    return axis_position;  // Already in [0..1]
+#endif
+}
+
+// Map a post-sticky normalized position to [0 .. max_raw] with exact endpoints
+static inline uint16_t output_u16(const smooth_axis_config_t *cfg, float n) {
+    uint16_t max_raw = cfg_max_raw(cfg);
+
+    // Ensure exact 0 and max_raw at endpoints (prevent off-by-one from floating point rounding)
+    if (n <= cfg->_map._lsb_norm) { return 0; }
+    if (n >= cfg->_map._top_norm) { return max_raw; }
+
+    return (uint16_t)lroundf(n * (float)max_raw);
+}
+
+// Outcome of one report decision (the split is only kept by SMOOTH_AXIS_STATS)
+typedef enum {
+  REPORT_NONE_SUB_LSB = 0,  // Change below one output LSB
+  REPORT_NONE_NOISE,        // Above one LSB, within the noise threshold
+  REPORT_STICKY,            // Reported: in a sticky zone
+  REPORT_THRESHOLD          // Reported: past the noise threshold
+} report_kind_t;
+
+// Report decision shared by all front-ends: reports (>= REPORT_STICKY) replace `*last_reported`
+static inline report_kind_t report_decide(const smooth_axis_config_t *cfg,
+                                          float current,
+                                          float noise_norm,
+                                          float *last_reported) {
+    float diff = abs_f(current - *last_reported);
+
+    if (!would_change_output(cfg, diff)) { return REPORT_NONE_SUB_LSB; }
+
+    // When approaching to the edges, we treat each movement (>= epsilon) as 'Always Important'
+    float sticky_ceil   = 1 - cfg->sticky_zone_norm;
+    float sticky_floor  = cfg->sticky_zone_norm;
+    bool in_sticky_zone = SMOOTH_AXIS_ENABLE_STICKY && ((current < sticky_floor) || (current > sticky_ceil));
+
+    float dynamic_threshold = get_dynamic_threshold(cfg, noise_norm);  // Scales 1x-10x with noise
+
+    if (in_sticky_zone || diff > dynamic_threshold) {
+        *last_reported = current;
+
+        SMOOTH_DEBUGF("new value: %.3f (diff=%.4f thresh=%.4f %s)",
+                      current,
+                      diff,
+                      dynamic_threshold,
+                      in_sticky_zone ? "sticky" : "normal");
+        return in_sticky_zone ? REPORT_STICKY : REPORT_THRESHOLD;
+    }
+    return REPORT_NONE_NOISE;
+}
+
+static inline bool report_if_changed(const smooth_axis_config_t *cfg,
+                                     float current,
+                                     float noise_norm,
+                                     float *last_reported) {
+    return report_decide(cfg, current, noise_norm, last_reported) >= REPORT_STICKY;
+}
+
+
+// ============================================================================
+// EMA Math
+// ============================================================================
+
+// Compute decay rate k such that: after settle_time_sec, error reduces to 5%
+// Formula: k = ln(0.05) / settle_time  →  alpha(dt) = 1 - exp(k·dt)
+static inline float compute_ema_decay_rate(const float settle_time_sec) {
+    if (settle_time_sec <= 0.0f) {
+        return 0.0f;
+    }
+    // (ln(0) = NAN , ln(1) = 0 (No decay)
+    float residual = clamp_f(EMA_CONVERGENCE_THRESHOLD, 1e-4f, 0.9999f);
+    float ln_r     = logf(residual);  // negative
+    return ln_r / settle_time_sec;
+}
+
+// Convert decay rate k and time step dt into EMA alpha.
+// alpha = 1 - exp(k·dt), clamped for numerical stability
+static inline float get_alpha_from_dt(const float k, const float dt_sec) {
+    if (dt_sec > 0.0f && k != 0.0f) {
+        float ratio = clamp_f(k * dt_sec, -20.0f, 0.0f);  // Prevent overflow
+        return 1.0f - expf(ratio);
+    }
+    // Fallback: instant response (no smoothing)
+    // Legitimate cases: k (settle_time) = 0 , or dt=0 (first frame)
+    // Bug case: negative dt (should assert in debug)
+    SMOOTH_AXIS_ASSERT(dt_sec >= 0.0f || k == 0.0f,
+                       "negative dt is invalid");
+    return 1.0f;
+}
+
+// LIVE_DT alpha table: SMOOTH_AXIS_ALPHA_LUT_SIZE knots dt_i = i·h over [0 .. AUTO_DT_MAX_MS].
+// Between knots: alpha(dt_i + r) = alpha_i - (1 - alpha_i)·expm1(k·r), with expm1 as its
+// 5th-order Taylor polynomial. The table is only used while |k·r| <= ALPHA_LUT_MAX_STEP:
+//   truncation   <= |k·r|^6 / 720                 (absolute, k·r <= 0)
+//   relative     <= |k·r|^5 / 630 <= 1.6e-6       (since alpha >= 0.875·|k·r|)
+// Float rounding adds ~1e-6, so LUT alpha stays within 5e-6 (relative) of exact
+// 1 - exp(k·dt) - tighter than 1 - expf() itself at small alpha. Short settle times
+// (|k·h| > ALPHA_LUT_MAX_STEP, below ~40ms with 16 knots) fall back to expf() for
+// the far part of each interval; dt outside the table always does.
+static const float ALPHA_LUT_MAX_STEP = 0.25f;
+
+#if SMOOTH_AXIS_ALPHA_LUT_SIZE >= 2
+
+static inline float alpha_lut_step_sec(void) {
+    return SMOOTH_AXIS_AUTO_DT_MAX_MS / 1000.0f / (float)(SMOOTH_AXIS_ALPHA_LUT_SIZE - 1);
+}
+
+// Fill cfg->_alpha_lut from cfg->_ema_decay_rate (config time, never per sample)
+static inline void alpha_lut_build(smooth_axis_config_t *cfg) {
+    const float h = alpha_lut_step_sec();
+    for (int i = 0; i < SMOOTH_AXIS_ALPHA_LUT_SIZE; i++) {
+        float ratio = clamp_f(cfg->_ema_decay_rate * h * (float)i, -20.0f, 0.0f);
+        cfg->_alpha_lut[i] = -expm1f(ratio);  // No cancellation at small alpha
+    }
+}
+
+static inline float get_alpha_from_lut(const smooth_axis_config_t *cfg, float dt_sec) {
+    const float k = cfg->_ema_decay_rate;
+    const float h = alpha_lut_step_sec();
+
+    if (dt_sec > 0.0f && dt_sec <= SMOOTH_AXIS_AUTO_DT_MAX_MS / 1000.0f && k != 0.0f) {
+        uint32_t i = (uint32_t)(dt_sec * (1.0f / h));  // floor, dt_sec > 0
+        if (i > SMOOTH_AXIS_ALPHA_LUT_SIZE - 1) { i = SMOOTH_AXIS_ALPHA_LUT_SIZE - 1; }
+
+        float y = k * (dt_sec - (float)i * h);
+        if (y >= -ALPHA_LUT_MAX_STEP) {
+            float a_i  = cfg->_alpha_lut[i];
+            float em1y = y * (1.0f + y * (1.0f / 2.0f + y * (1.0f / 6.0f +
+                         y * (1.0f / 24.0f + y * (1.0f / 120.0f)))));
+            return a_i - (1.0f - a_i) * em1y;
+        }
+    }
+    return get_alpha_from_dt(k, dt_sec);  // Off-table: exact
+}
+
+#else
+
+static inline void alpha_lut_build(smooth_axis_config_t *cfg) {
+    (void)cfg;
+}
+
+static inline float get_alpha_from_lut(const smooth_axis_config_t *cfg, float dt_sec) {
+    return get_alpha_from_dt(cfg->_ema_decay_rate, dt_sec);
+}
+
+#endif // SMOOTH_AXIS_ALPHA_LUT_SIZE
+
+// dt = 0 → alpha = 1 (what get_alpha_from_dt() returns), so a fresh cache is never stale
+static inline void alpha_cache_init(smooth_axis_alpha_cache_t *c) {
+    c->_dt_sec = 0.0f;
+    c->_alpha  = 1.0f;
+}
+
+// LIVE_DT per-frame alpha: re-evaluated only when dt_sec differs from the last frame.
+// Returns true if the cached alpha changed.
+static inline bool alpha_cache_refresh(smooth_axis_alpha_cache_t *c,
+                                       const smooth_axis_config_t *cfg,
+                                       float dt_sec) {
+    if (dt_sec == c->_dt_sec) { return false; }
+
+    c->_dt_sec = dt_sec;
+    c->_alpha  = get_alpha_from_lut(cfg, dt_sec);
+    return true;
+}
+
+// One noise-estimator step: sign flip → likely noise (update estimate),
+// no flip → likely movement (decay estimate). Returns the new estimate.
+static inline float noise_step(float noise_norm, float residual, float last_residual) {
+    bool  is_noise_sample = has_sign_flipped(residual, last_residual);
+    float new_sample      = is_noise_sample ? abs_f(residual) : 0.0f;
+    return clamp_f_0_1(ema(noise_norm, new_sample, NOISE_SMOOTHING_RATE));
+}
+
+
+// ============================================================================
+// Warmup (AUTO_DT Mode)
+// ============================================================================
+
+static inline void warmup_init(smooth_axis_warmup_t *w, const smooth_axis_config_t *cfg) {
+    // 60 Hz assumption until warmup
+    w->_auto_alpha         = get_alpha_from_dt(cfg->_ema_decay_rate, FALLBACK_DELTA_TIME);
+    w->_dt_accum_sec       = 0.0f;
+    w->_dt_sq_accum        = 0.0f;
+    w->_sec_per_tick       = 1.0f / (float)(cfg->timer_hz ? cfg->timer_hz : 1000u);
+    w->_last_ticks         = 0;
+    w->_warmup_cycles_done = 0;
+    w->_track_frames       = 0;
+}
+
+static inline bool is_warmup_finished(const smooth_axis_warmup_t *w) {
+    return w->_warmup_cycles_done >= SMOOTH_AXIS_INIT_CALIBRATION_CYCLES;
+}
+
+// fast_warmup exit test: the mean of n deltas is within WARMUP_FAST_REL_ERROR when
+// two standard errors (4 · var / n <= tol² · mean², ~95%) and the timer quantization
+// (one tick over the whole sum) are both below the tolerance.
+static inline bool warmup_converged(const smooth_axis_warmup_t *w) {
+    uint16_t n = w->_warmup_cycles_done;
+    if (n < WARMUP_FAST_MIN_CYCLES) { return false; }
+
+    const float tol  = WARMUP_FAST_REL_ERROR;
+    float       sum  = w->_dt_accum_sec;
+    float       mean = sum / (float)n;
+    float       var  = w->_dt_sq_accum / (float)n - mean * mean;
+    return w->_sec_per_tick <= tol * sum && 4.0f * var <= tol * tol * (float)n * mean * mean;
+}
+
+// Measure average dt over 256 samples (fewer with fast_warmup), then compute fixed alpha
+static inline void warmup_run_cycle_if_needed(smooth_axis_warmup_t *w,
+                                              const smooth_axis_config_t *cfg) {
+    if (is_warmup_finished(w)) { return; }
+
+    SMOOTH_AXIS_CHECK_RETURN(cfg->now_ms != NULL, "AUTO mode requires now_ms function");
+
+    uint32_t now_ticks = cfg->now_ms();
+    if (w->_last_ticks == 0) {
+        w->_last_ticks = now_ticks;  // First call: just record timestamp
+        return;
+    }
+
+    // Measure dt and accumulate. Only stalls are capped per sample: deltas shorter
+    // than one tick (0) must count too, or coarse timers overestimate fast loops.
+    float dt_sec = (float)(now_ticks - w->_last_ticks) * w->_sec_per_tick;
+    w->_last_ticks = now_ticks;
+    dt_sec = dt_sec < SMOOTH_AXIS_AUTO_DT_MAX_MS / 1000.0f
+             ? dt_sec : SMOOTH_AXIS_AUTO_DT_MAX_MS / 1000.0f;
+    w->_dt_accum_sec += dt_sec;
+    w->_dt_sq_accum  += dt_sec * dt_sec;
+    w->_warmup_cycles_done++;
+
+    uint16_t cycles = w->_warmup_cycles_done;
+    if (cycles < SMOOTH_AXIS_INIT_CALIBRATION_CYCLES && !(cfg->fast_warmup && warmup_converged(w))) {
+        return;
+    }
+
+    // Warmup complete: compute fixed alpha from average dt
+    float dt_avg = clamp_f(w->_dt_accum_sec / (float)cycles,
+                           SMOOTH_AXIS_AUTO_DT_MIN_MS / 1000.0f,
+                           SMOOTH_AXIS_AUTO_DT_MAX_MS / 1000.0f);
+    w->_auto_alpha         = get_alpha_from_dt(cfg->_ema_decay_rate, dt_avg);
+    w->_dt_accum_sec       = dt_avg;  // Seed for auto_dt_tracking
+    w->_track_frames       = 0;
+    w->_warmup_cycles_done = SMOOTH_AXIS_INIT_CALIBRATION_CYCLES;  // Finished
+
+    SMOOTH_DEBUGF("warmup complete: cycles=%u dt_avg=%.3fms alpha=%.6f",
+                  cycles,
+                  dt_avg * 1000.0f,
+                  w->_auto_alpha);
+}
+
+// Pre-warmup alpha from a dt measured earlier (e.g. stored by a previous session)
+static inline void warmup_seed(smooth_axis_warmup_t *w, const smooth_axis_config_t *cfg,
+                               float dt_sec) {
+    if (is_warmup_finished(w) || !(dt_sec > 0.0f)) { return; }
+    w->_auto_alpha = get_alpha_from_dt(cfg->_ema_decay_rate,
+                                       clamp_f(dt_sec,
+                                               SMOOTH_AXIS_AUTO_DT_MIN_MS / 1000.0f,
+                                               SMOOTH_AXIS_AUTO_DT_MAX_MS / 1000.0f));
+}
+
+// Finish the warmup with a dt measured earlier (snapshot restore)
+static inline void warmup_restore(smooth_axis_warmup_t *w, const smooth_axis_config_t *cfg,
+                                  float dt_sec) {
+    float dt_avg = clamp_f(dt_sec,
+                           SMOOTH_AXIS_AUTO_DT_MIN_MS / 1000.0f,
+                           SMOOTH_AXIS_AUTO_DT_MAX_MS / 1000.0f);
+    w->_auto_alpha         = get_alpha_from_dt(cfg->_ema_decay_rate, dt_avg);
+    w->_dt_accum_sec       = dt_avg;
+    w->_last_ticks         = 0;  // Timer may have restarted: first tracking window re-opens
+    w->_track_frames       = 0;
+    w->_warmup_cycles_done = SMOOTH_AXIS_INIT_CALIBRATION_CYCLES;
+}
+
+// Measured average dt (tracked if auto_dt_tracking), 0 while warmup is still running
+static inline float warmup_dt_sec(const smooth_axis_warmup_t *w) {
+    return is_warmup_finished(w) ? w->_dt_accum_sec : 0.0f;
+}
+
+// Background re-estimation after warmup: one timer read per window, the window's
+// average dt moves the tracked average by 1/8. Returns true if alpha changed.
+static inline bool dt_track_step(smooth_axis_warmup_t *w, const smooth_axis_config_t *cfg) {
+    if (++w->_track_frames < SMOOTH_AXIS_DT_TRACK_FRAMES) { return false; }
+
+    uint32_t now_ticks = cfg->now_ms();
+    if (w->_last_ticks == 0) {  // Restored calibration: this window only opens the next one
+        w->_last_ticks   = now_ticks;
+        w->_track_frames = 0;
+        return false;
+    }
+    float    window_dt = (float)(now_ticks - w->_last_ticks) * w->_sec_per_tick
+                         / (float)w->_track_frames;
+    w->_last_ticks   = now_ticks;
+    w->_track_frames = 0;
+
+    // A stall in the window (debugger, USB suspend) says nothing about the loop rate
+    if (window_dt > SMOOTH_AXIS_AUTO_DT_MAX_MS / 1000.0f) { return false; }
+    window_dt = window_dt > SMOOTH_AXIS_AUTO_DT_MIN_MS / 1000.0f
+                ? window_dt : SMOOTH_AXIS_AUTO_DT_MIN_MS / 1000.0f;
+
+    w->_dt_accum_sec += (window_dt - w->_dt_accum_sec) * DT_TRACK_GAIN;
+
+    float alpha = get_alpha_from_dt(cfg->_ema_decay_rate, w->_dt_accum_sec);
+    if (alpha == w->_auto_alpha) { return false; }
+    w->_auto_alpha = alpha;
+    return true;
+}
+
+// Per-update AUTO_DT timebase work (warmup, then optional tracking).
+// Returns true when _auto_alpha changed.
+static inline bool auto_dt_step(smooth_axis_warmup_t *w, const smooth_axis_config_t *cfg) {
+    if (!is_warmup_finished(w)) {
+        warmup_run_cycle_if_needed(w, cfg);
+        return is_warmup_finished(w);
+    }
+    return cfg->auto_dt_tracking && dt_track_step(w, cfg);
+}
+
+
+// ============================================================================
+// Instrumentation (SMOOTH_AXIS_STATS)
+// ============================================================================
+// SMOOTH_AXIS_STAT(statement) runs `statement` only in counting builds, so the
+// hooks on the update path vanish otherwise (like SMOOTH_DEBUGF).
+
+#if SMOOTH_AXIS_STATS
+#define SMOOTH_AXIS_STAT(statement) do { statement; } while (0)
+#else
+#define SMOOTH_AXIS_STAT(statement) ((void)0)
+#endif
+
+static inline void stats_clear(smooth_axis_stats_t *s) {
+    s->updates            = 0;
+    s->noise_spikes       = 0;
+    s->settling_samples   = 0;
+    s->reports_sticky     = 0;
+    s->reports_threshold  = 0;
+    s->suppressed_sub_lsb = 0;
+    s->suppressed_noise   = 0;
+    s->dt_min_sec         = 0.0f;
+    s->dt_max_sec         = 0.0f;
+}
+
+static inline void stats_ema_step(smooth_axis_stats_t *s, bool sign_flipped) {
+    if (sign_flipped) { s->noise_spikes++; } else { s->settling_samples++; }
+}
+
+static inline void stats_report(smooth_axis_stats_t *s, report_kind_t kind) {
+    switch (kind) {
+        case REPORT_NONE_SUB_LSB: s->suppressed_sub_lsb++; break;
+        case REPORT_NONE_NOISE:   s->suppressed_noise++;   break;
+        case REPORT_STICKY:       s->reports_sticky++;     break;
+        case REPORT_THRESHOLD:    s->reports_threshold++;  break;
+    }
+}
+
+// Called whenever alpha is re-derived from a new dt (so at most once per dt change)
+static inline void stats_dt(smooth_axis_stats_t *s, float dt_sec) {
+    if (s->dt_max_sec == 0.0f || dt_sec < s->dt_min_sec) { s->dt_min_sec = dt_sec; }
+    if (dt_sec > s->dt_max_sec) { s->dt_max_sec = dt_sec; }
+}
+
+
+// ============================================================================
+// Fixed-Point Math (SMOOTH_AXIS_FIXED_POINT)
+// ============================================================================
+// Same pipeline as above in Q30 integers. Identities used:
+//   ema(old, new, a)        == old + a·(new - old)
+//   map_f(x, 0, 1, -z, 1+z) == x·(1 + 2z) - z
+
+#if SMOOTH_AXIS_FIXED_POINT
+
+#define Q30_ONE  ((int32_t)1 << 30)
+#define Q30_HALF ((int64_t)1 << 29)
+
+// Init / read-side conversions only (never on the per-sample path)
+static inline int32_t q30_from_f(float x) {
+    return (int32_t)lroundf(x * (float)Q30_ONE);
+}
+
+static inline float q30_to_f(int32_t q) {
+    return (float)q * (1.0f / (float)Q30_ONE);
+}
+
+// Q30 · Q30 → Q30, rounded to nearest
+static inline int32_t q30_mul(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b + Q30_HALF) >> 30);
+}
+
+static inline int32_t clamp_q(int32_t x, int32_t lo, int32_t hi) {
+    return x < lo ? lo : (x > hi ? hi : x);
+}
+
+static inline int32_t abs_q(int32_t x) {
+    return x < 0 ? -x : x;
+}
+
+// Derive all integer coefficients from the (float) config, once per init
+static inline void fixed_coeffs_init(smooth_axis_fixed_t *fx, const smooth_axis_config_t *cfg) {
+    float max_raw = (float)cfg_max_raw(cfg);
+    float off, on;
+    cfg_dead_zones(cfg, &off, &on);
+    fx->_in_off_q8 = (int32_t)lroundf(off * max_raw * 256.0f);
+    fx->_in_on_q8  = (int32_t)lroundf(on * max_raw * 256.0f);
+
+    int64_t span = (int64_t)fx->_in_on_q8 - fx->_in_off_q8;
+    if (span < 1) { span = 1; }
+
+    // Largest shift whose rounded gain still fits in 31 bits
+    uint8_t  shift = 32;
+    uint64_t gain  = (((uint64_t)1 << (30 + shift)) + (uint64_t)span / 2) / (uint64_t)span;
+    while (gain >= ((uint64_t)1 << 31) && shift > 0) {
+        shift--;
+        gain = (((uint64_t)1 << (30 + shift)) + (uint64_t)span / 2) / (uint64_t)span;
+    }
+    fx->_in_gain  = (uint32_t)gain;
+    fx->_in_shift = shift;
+
+    float sticky = clamp_f(cfg_sticky_zone(cfg), 0.0f, MAX_STICKY_ZONE);
+    fx->_sticky_q30      = q30_from_f(sticky);
+    fx->_sticky_gain_q30 = q30_from_f(1.0f + 2.0f * sticky);
+    fx->_sticky_cmp_q30  = q30_from_f(clamp_f_0_1(cfg_sticky_zone(cfg)));
+    fx->_thresh_gain_q28 = (int32_t)lroundf(THRESHOLD_NOISE_MULTIPLIER
+                                            * cfg->_threshold_attenuation
+                                            * (float)(1 << 28));
+}
+
+// input_norm() in integers: clip to dead zones, re-stretch to [0 .. Q30_ONE]
+// Raw value with 8 fractional bits (decimated mean), already clipped to max_raw
+static inline int32_t input_norm_q30_q8(const smooth_axis_fixed_t *fx, int32_t raw_q8) {
+#if SMOOTH_AXIS_ENABLE_DEAD_ZONES
+    int32_t x    = clamp_q(raw_q8, fx->_in_off_q8, fx->_in_on_q8) - fx->_in_off_q8;
+    int32_t norm = (int32_t)(((int64_t)x * fx->_in_gain) >> fx->_in_shift);
+    return clamp_q(norm, 0, Q30_ONE);
+#else
+    int32_t norm = (int32_t)(((int64_t)raw_q8 * fx->_in_gain) >> fx->_in_shift);  // off = 0
+    return norm < Q30_ONE ? norm : Q30_ONE;
+#endif
+}
+
+static inline int32_t input_norm_q30(const smooth_axis_fixed_t *fx,
+                                     const smooth_axis_config_t *cfg,
+                                     uint16_t raw_value) {
+    uint16_t max_raw = cfg_max_raw(cfg);
+    return input_norm_q30_q8(fx, (int32_t)(raw_value > max_raw ? max_raw : raw_value) << 8);
+}
+
+static inline bool has_sign_flipped_q(int32_t current, int32_t previous) {
+    bool same_side = (current > 0 && previous > 0) || (current < 0 && previous < 0);
+    return !same_side;
+}
+
+static inline int32_t noise_step_q30(int32_t noise, int32_t residual, int32_t last_residual) {
+    static const int32_t RATE_Q30 = (int32_t)(0.005 * (1 << 30) + 0.5);  // NOISE_SMOOTHING_RATE
+
+    int32_t new_sample = has_sign_flipped_q(residual, last_residual) ? abs_q(residual) : 0;
+    return clamp_q(noise + q30_mul(RATE_Q30, new_sample - noise), 0, Q30_ONE);
+}
+
+static inline int32_t get_dynamic_threshold_q30(const smooth_axis_fixed_t *fx, int32_t noise) {
+    static const int32_t MAX_THRESH_Q30 = (int32_t)(30.0 / 1023.0 * (1 << 30) + 0.5);
+
+    int32_t threshold = (int32_t)(((int64_t)noise * fx->_thresh_gain_q28) >> 28);
+    return clamp_q(threshold, 0, MAX_THRESH_Q30);
+}
+
+static inline int32_t apply_sticky_margins_q30(const smooth_axis_fixed_t *fx, int32_t position) {
+#if SMOOTH_AXIS_ENABLE_STICKY
+    if (position <= fx->_sticky_q30) { return 0; }
+    if (position >= Q30_ONE - fx->_sticky_q30) { return Q30_ONE; }
+
+    return clamp_q(q30_mul(position, fx->_sticky_gain_q30) - fx->_sticky_q30, 0, Q30_ONE);
+#else
+    (void)fx;
+    return position;
+#endif
+}
+
+static inline uint16_t output_u16_q30(const smooth_axis_config_t *cfg, int32_t n) {
+    uint16_t max_raw = cfg_max_raw(cfg);
+    int64_t  scaled  = (int64_t)n * max_raw;  // Q30 raw units
+
+    // Exact 0 and max_raw at endpoints (same bands as output_u16())
+    if (scaled <= Q30_ONE) { return 0; }
+    if (scaled >= ((int64_t)max_raw - 1) * Q30_ONE) { return max_raw; }
+
+    return (uint16_t)((scaled + Q30_HALF) >> 30);
+}
+
+static inline report_kind_t report_decide_q30(const smooth_axis_fixed_t *fx,
+                                              const smooth_axis_config_t *cfg,
+                                              int32_t current,
+                                              int32_t noise,
+                                              int32_t *last_reported) {
+    int32_t diff = abs_q(current - *last_reported);
+
+    // would_change_output(): diff > 1 LSB  ⇔  diff · max_raw > 1.0
+    if ((int64_t)diff * cfg_max_raw(cfg) <= Q30_ONE) { return REPORT_NONE_SUB_LSB; }
+
+    bool in_sticky_zone = SMOOTH_AXIS_ENABLE_STICKY && ((current < fx->_sticky_cmp_q30) ||
+                                                       (current > Q30_ONE - fx->_sticky_cmp_q30));
+
+    if (in_sticky_zone || diff > get_dynamic_threshold_q30(fx, noise)) {
+        *last_reported = current;
+        return in_sticky_zone ? REPORT_STICKY : REPORT_THRESHOLD;
+    }
+    return REPORT_NONE_NOISE;
+}
+
+static inline bool report_if_changed_q30(const smooth_axis_fixed_t *fx,
+                                         const smooth_axis_config_t *cfg,
+                                         int32_t current,
+                                         int32_t noise,
+                                         int32_t *last_reported) {
+    return report_decide_q30(fx, cfg, current, noise, last_reported) >= REPORT_STICKY;
+}
+
+#endif // SMOOTH_AXIS_FIXED_POINT
+
+
+// ============================================================================
+// Shared-Config Helpers (smooth_axis_shared.c, smooth_axis_compact.c)
+// ============================================================================
+// Both axis types on one smooth_axis_shared_cfg_t use these, so they map input,
+// seed noise and derive alpha in the same domain (float or Q30) from one cache.
+
+static inline smooth_axis_value_t shared_input_norm(const smooth_axis_shared_cfg_t *shared,
+                                                    uint16_t raw_value) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return input_norm_q30(&shared->_fx, &shared->cfg, raw_value);
+#else
+    return input_norm(&shared->cfg, raw_value);
+#endif
+}
+
+// LIVE_DT alpha, re-derived only when dt_sec differs from the last update of any
+// axis on this config (as live_dt_core() in smooth_axis.c, with the cache shared),
+// so steady-rate updates are integer-only in Q30
+static inline smooth_axis_value_t shared_alpha(smooth_axis_shared_cfg_t *shared, float dt_sec) {
+#if SMOOTH_AXIS_FIXED_POINT
+    if (alpha_cache_refresh(&shared->_live_alpha, &shared->cfg, dt_sec)) {
+        shared->_fx._alpha_q30 = q30_from_f(shared->_live_alpha._alpha);  // Only when dt changes
+    }
+    return shared->_fx._alpha_q30;
+#else
+    alpha_cache_refresh(&shared->_live_alpha, &shared->cfg, dt_sec);
+    return shared->_live_alpha._alpha;
+#endif
+}
+
+static inline smooth_axis_value_t shared_initial_noise(void) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return q30_from_f(INITIAL_NOISE_NORM);
+#else
+    return INITIAL_NOISE_NORM;
+#endif
+}
@@ -0,0 +1,147 @@
+/**
+ * @file smooth_axis_sched.c
+ * @brief Implementation of the multiplexed-channel conversion scheduler
+ * @author Jonatan Vider
+ *
+ * See smooth_axis_sched.h for API documentation.
+ */
+
+#include "smooth_axis_sched.h"
+#include "smooth_axis_internal.h"
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t sched_ticks_from_sec(float sec, uint32_t timer_hz) {
+    float ticks = sec * (float)timer_hz + 0.5f;
+    if (ticks < 1.0f) { return 1; }
+    if (ticks > 2147483648.0f) { return 0x80000000u; }  // Half the timer range
+    return (uint32_t)ticks;
+}
+
+// elapsed_a / period_a > elapsed_b / period_b, without dividing
+static inline bool sched_more_overdue(const smooth_axis_sched_t *sched,
+                                      uint32_t now_ticks,
+                                      size_t a,
+                                      size_t b) {
+    uint64_t lhs = (uint64_t)(now_ticks - sched->_last_ticks[a]) * sched->_period[b];
+    uint64_t rhs = (uint64_t)(now_ticks - sched->_last_ticks[b]) * sched->_period[a];
+    return lhs > rhs;
+}
+
+// Moving: residual outside the idle-detection band (8x noise, at least one raw step)
+static inline bool sched_is_moving(const smooth_axis_bank_t *bank, size_t channel) {
+    float band = (float)IDLE_NOISE_MULTIPLIER * bank->_noise_estimate_norm[channel];
+    if (band < bank->cfg._map._lsb_norm) { band = bank->cfg._map._lsb_norm; }
+    return abs_f(bank->_last_residual[channel]) > band;
+}
+
+
+// ============================================================================
+// Public API - Init
+// ============================================================================
+
+void smooth_axis_sched_init(smooth_axis_sched_t *sched,
+                            smooth_axis_bank_t *bank,
+                            uint32_t timer_hz,
+                            float min_period_sec,
+                            float max_period_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(sched != NULL, "scheduler is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(bank != NULL, "bank is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(bank->cfg.mode == SMOOTH_AXIS_MODE_LIVE_DT,
+                             "scheduler requires a LIVE_DT bank");
+    SMOOTH_AXIS_CHECK_RETURN(timer_hz > 0, "timer_hz must be > 0");
+    SMOOTH_AXIS_CHECK_RETURN(min_period_sec > 0.0f && max_period_sec >= min_period_sec,
+                             "need 0 < min_period_sec <= max_period_sec");
+
+    sched->_bank         = bank;
+    sched->_sec_per_tick = 1.0f / (float)timer_hz;
+    sched->_min_period   = sched_ticks_from_sec(min_period_sec, timer_hz);
+    sched->_max_period   = sched_ticks_from_sec(max_period_sec, timer_hz);
+
+    for (size_t i = 0; i < bank->count; i++) {
+        sched->_last_ticks[i] = 0;
+        sched->_period[i]     = sched->_min_period;
+    }
+
+    SMOOTH_DEBUGF("sched init: count=%u period=%u..%u ticks",
+                  (unsigned)bank->count,
+                  (unsigned)sched->_min_period,
+                  (unsigned)sched->_max_period);
+}
+
+void smooth_axis_sched_prime(smooth_axis_sched_t *sched,
+                             const uint16_t *raw,
+                             uint32_t now_ticks) {
+    SMOOTH_AXIS_CHECK_RETURN(sched != NULL && sched->_bank != NULL, "scheduler not initialized");
+    SMOOTH_AXIS_CHECK_RETURN(raw != NULL, "raw is NULL");
+
+    smooth_axis_bank_t *bank = sched->_bank;
+    smooth_axis_bank_update_live_dt(bank, raw, bank->count, 0.0f);  // First scan: dt unused
+
+    for (size_t i = 0; i < bank->count; i++) {
+        sched->_last_ticks[i] = now_ticks;
+        sched->_period[i]     = sched->_min_period;
+    }
+}
+
+
+// ============================================================================
+// Public API - Scheduling
+// ============================================================================
+
+size_t smooth_axis_sched_next(const smooth_axis_sched_t *sched,
+                              uint32_t now_ticks,
+                              size_t *channels,
+                              size_t max_channels) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(sched != NULL && sched->_bank != NULL,
+                                 "scheduler not initialized", 0);
+    SMOOTH_AXIS_CHECK_RETURN_VAL(channels != NULL || max_channels == 0, "channels is NULL", 0);
+
+    size_t picked = 0;
+    for (size_t i = 0; i < sched->_bank->count; i++) {
+        if (now_ticks - sched->_last_ticks[i] < sched->_period[i]) { continue; }  // Not due
+
+        // Insertion into the (short) ranked list; ties keep index order
+        size_t pos = picked;
+        while (pos > 0 && sched_more_overdue(sched, now_ticks, i, channels[pos - 1])) { pos--; }
+        if (pos >= max_channels) { continue; }
+
+        size_t last = picked < max_channels ? picked : max_channels - 1;
+        for (size_t j = last; j > pos; j--) { channels[j] = channels[j - 1]; }
+        channels[pos] = i;
+        if (picked < max_channels) { picked++; }
+    }
+    return picked;
+}
+
+void smooth_axis_sched_submit(smooth_axis_sched_t *sched,
+                              size_t channel,
+                              uint16_t raw,
+                              uint32_t now_ticks) {
+    SMOOTH_AXIS_CHECK_RETURN(sched != NULL && sched->_bank != NULL, "scheduler not initialized");
+    SMOOTH_AXIS_CHECK_RETURN(channel < sched->_bank->count, "channel out of range");
+
+    smooth_axis_bank_t *bank = sched->_bank;
+    float dt_sec = (float)(now_ticks - sched->_last_ticks[channel]) * sched->_sec_per_tick;
+
+    smooth_axis_bank_update_axis_live_dt(bank, channel, raw, dt_sec);
+    sched->_last_ticks[channel] = now_ticks;
+
+    // Multiplicative back-off while quiet, straight back to full rate on movement
+    uint32_t period = sched->_period[channel];
+    if (sched_is_moving(bank, channel)) {
+        period = sched->_min_period;
+    } else {
+        period += period / 4u + 1u;
+        if (period > sched->_max_period) { period = sched->_max_period; }
+    }
+    sched->_period[channel] = period;
+}
+
+float smooth_axis_sched_get_period_sec(const smooth_axis_sched_t *sched, size_t channel) {
+    if (!sched || !sched->_bank || channel >= sched->_bank->count) { return 0.0f; }
+
+    return (float)sched->_period[channel] * sched->_sec_per_tick;
+}
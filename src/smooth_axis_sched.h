@@ -0,0 +1,150 @@
+/**
+ * @file smooth_axis_sched.h
+ * @brief Activity-driven conversion scheduler for a bank of multiplexed channels
+ *
+ * @author Jonatan Vider
+ *
+ * When many channels share one ADC through multiplexers, conversions are the
+ * budget. Most channels sit still most of the time, and converting them at the
+ * full rate only re-confirms what the filter already knows. This scheduler
+ * sits on top of a LIVE_DT smooth_axis_bank_t. It tracks a sampling period
+ * per channel, picks the channels that are most overdue, and feeds each
+ * conversion into its axis with that channel's own dt, so the EMA keeps its
+ * configured settle time at any rate.
+ *
+ *   - Moving channel (residual outside 8x the noise estimate, or one raw step):
+ *     period drops to min_period_sec.
+ *   - Quiet channel: period grows by ~1/4 per conversion, up to max_period_sec
+ *     (about 4 x max_period_sec of quiet to reach it).
+ *
+ * max_period_sec bounds the extra latency of a move from rest. Keep it well
+ * below settle_time_sec.
+ *
+ * Typical usage (1 ms ADC slot with room for 8 conversions, 64 channels):
+ * @code
+ * static smooth_axis_bank_t  pads;
+ * static smooth_axis_sched_t sched;
+ *
+ * smooth_axis_config_live_dt(&cfg, 4095, 0.05f);
+ * smooth_axis_bank_init(&pads, &cfg, 64);
+ * smooth_axis_sched_init(&sched, &pads, 1000000u, 0.001f, 0.010f);  // us timer, 1..10 ms
+ *
+ * read_all_channels(raw);                         // One full scan seeds every axis
+ * smooth_axis_sched_prime(&sched, raw, micros());
+ *
+ * while (1) {
+ *     size_t ch[8];
+ *     size_t n = smooth_axis_sched_next(&sched, micros(), ch, 8);
+ *     for (size_t k = 0; k < n; k++) {
+ *         smooth_axis_sched_submit(&sched, ch[k], adc_read_mux(ch[k]), micros());
+ *     }
+ *     // smooth_axis_bank_has_new_value() / change mask as usual
+ * }
+ * @endcode
+ *
+ * RAM: 8 bytes per slot (SMOOTH_AXIS_BANK_MAX_AXES) on top of the bank.
+ */
+
+#pragma once
+
+#include "smooth_axis_bank.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Scheduler state for one LIVE_DT bank
+ *
+ * Opaque structure - do not access fields directly.
+ * Initialize with smooth_axis_sched_init(), then smooth_axis_sched_prime().
+ */
+typedef struct {
+  smooth_axis_bank_t *_bank;
+  float               _sec_per_tick;  // 1 / timer_hz
+  uint32_t            _min_period;    // Ticks: period of a moving channel
+  uint32_t            _max_period;    // Ticks: period of a settled channel
+
+  // Internal per-channel state (do not access directly)
+  uint32_t _last_ticks[SMOOTH_AXIS_BANK_MAX_AXES];  // Timestamp of the last conversion
+  uint32_t _period[SMOOTH_AXIS_BANK_MAX_AXES];      // Current sampling period (ticks)
+} smooth_axis_sched_t;
+
+// ----------------------------------------------------------------------------
+// Init
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Attach a scheduler to an initialized LIVE_DT bank
+ *
+ * @param[out] sched          Scheduler state to initialize
+ * @param[in]  bank           Bank to drive (LIVE_DT mode; referenced, not copied)
+ * @param[in]  timer_hz       Tick rate of the timestamps passed to next()/submit()
+ * @param[in]  min_period_sec Sampling period of a moving channel (> 0)
+ * @param[in]  max_period_sec Sampling period of a settled channel (>= min_period_sec)
+ */
+void smooth_axis_sched_init(smooth_axis_sched_t *sched,
+                            smooth_axis_bank_t *bank,
+                            uint32_t timer_hz,
+                            float min_period_sec,
+                            float max_period_sec);
+
+/**
+ * @brief Seed every axis from one full scan and start all channels at min_period_sec
+ *
+ * @param[in,out] sched     Scheduler state
+ * @param[in]     raw       Raw readings, raw[i] belongs to channel i (bank count entries)
+ * @param[in]     now_ticks Timestamp of the scan
+ *
+ * @note Call once, right after smooth_axis_bank_init() (the first scan teleports).
+ */
+void smooth_axis_sched_prime(smooth_axis_sched_t *sched,
+                             const uint16_t *raw,
+                             uint32_t now_ticks);
+
+// ----------------------------------------------------------------------------
+// Scheduling
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Pick the channels to convert next
+ *
+ * A channel is due once its period has elapsed. Due channels are ranked by
+ * how overdue they are (elapsed / period), so when the budget is short every
+ * channel slows down in proportion instead of some starving.
+ *
+ * @param[in]  sched        Scheduler state
+ * @param[in]  now_ticks    Current timestamp
+ * @param[out] channels     Channel indices, most overdue first
+ * @param[in]  max_channels Conversion budget for this slot
+ * @return Number of channels written (0 = nothing due)
+ *
+ * @note O(count x max_channels) per call.
+ */
+size_t smooth_axis_sched_next(const smooth_axis_sched_t *sched,
+                              uint32_t now_ticks,
+                              size_t *channels,
+                              size_t max_channels);
+
+/**
+ * @brief Feed one conversion into its axis and adapt that channel's period
+ *
+ * dt is the time since the channel's previous conversion. Channels may be
+ * submitted in any order, not only those returned by next().
+ *
+ * @param[in,out] sched     Scheduler state
+ * @param[in]     channel   Channel index [0 .. bank count-1]
+ * @param[in]     raw       Raw ADC reading
+ * @param[in]     now_ticks Timestamp of the conversion
+ */
+void smooth_axis_sched_submit(smooth_axis_sched_t *sched,
+                              size_t channel,
+                              uint16_t raw,
+                              uint32_t now_ticks);
+
+/** @brief Current sampling period of a channel in seconds (0.0 if out of range) */
+float smooth_axis_sched_get_period_sec(const smooth_axis_sched_t *sched, size_t channel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file smooth_axis_shared.c
+ * @brief Implementation of shared-config axes
+ * @author Jonatan Vider
+ *
+ * See smooth_axis_shared.h for API documentation.
+ */
+
+#include "smooth_axis_shared.h"
+#include "smooth_axis_internal.h"
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static smooth_axis_value_t shared_get_normalized(const smooth_axis_shared_t *axis) {
+    SMOOTH_AXIS_GUARD_VAL(axis != NULL, 0);
+    if (!axis->_has_first_sample) {
+        return 0;
+    }
+#if SMOOTH_AXIS_FIXED_POINT
+    return apply_sticky_margins_q30(&axis->_shared->_fx, axis->_smoothed_norm);
+#else
+    return apply_sticky_margins(&axis->_shared->cfg, axis->_smoothed_norm);
+#endif
+}
+
+
+// ============================================================================
+// Public API - Init
+// ============================================================================
+
+void smooth_axis_shared_cfg_init(smooth_axis_shared_cfg_t *shared,
+                                 const smooth_axis_config_t *cfg) {
+    SMOOTH_AXIS_CHECK_RETURN(shared != NULL, "shared config is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(cfg != NULL, "config is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(cfg->mode == SMOOTH_AXIS_MODE_LIVE_DT,
+                             "shared config supports LIVE_DT mode only");
+
+    shared->cfg = *cfg;
+    map_coeffs_init(&shared->cfg);  // Pick up feel edits made after smooth_axis_config_*()
+    alpha_cache_init(&shared->_live_alpha);
+#if SMOOTH_AXIS_FIXED_POINT
+    fixed_coeffs_init(&shared->_fx, cfg);
+    shared->_fx._alpha_q30 = q30_from_f(shared->_live_alpha._alpha);
+#endif
+}
+
+void smooth_axis_shared_init(smooth_axis_shared_t *axis,
+                             smooth_axis_shared_cfg_t *shared) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(shared != NULL, "shared config is NULL");
+
+    axis->_shared              = shared;
+    axis->_smoothed_norm       = 0;
+    axis->_noise_estimate_norm = shared_initial_noise();
+    axis->_last_residual       = 0;
+    axis->_last_reported_norm  = 0;
+    axis->_has_first_sample    = false;
+}
+
+void smooth_axis_shared_reset(smooth_axis_shared_t *axis, uint16_t raw_value) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL && axis->_shared != NULL, "axis not initialized");
+
+    smooth_axis_value_t norm = raw_value ? shared_input_norm(axis->_shared, raw_value) : 0;
+
+    axis->_smoothed_norm       = norm;
+    axis->_noise_estimate_norm = shared_initial_noise();
+    axis->_last_reported_norm  = norm;
+    axis->_last_residual       = 0;
+    axis->_has_first_sample    = raw_value ? true : false;
+}
+
+
+// ============================================================================
+// Public API - Update
+// ============================================================================
+
+void smooth_axis_shared_update_live_dt(smooth_axis_shared_t *axis,
+                                       uint16_t raw_value,
+                                       float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL && axis->_shared != NULL, "axis not initialized");
+
+    smooth_axis_shared_cfg_t *shared = axis->_shared;
+    smooth_axis_value_t       norm   = shared_input_norm(shared, raw_value);
+
+    if (!axis->_has_first_sample) {  // First sample teleports (skip EMA on frame 0)
+        axis->_has_first_sample = true;
+        axis->_smoothed_norm    = norm;
+        return;
+    }
+
+    // Same per-sample math as update_core() in smooth_axis.c
+    smooth_axis_value_t alpha = shared_alpha(shared, dt_sec);
+    smooth_axis_value_t diff  = norm - axis->_smoothed_norm;
+#if SMOOTH_AXIS_FIXED_POINT
+    axis->_smoothed_norm      += q30_mul(alpha, diff);
+    axis->_noise_estimate_norm = noise_step_q30(axis->_noise_estimate_norm, diff,
+                                                axis->_last_residual);
+#else
+    axis->_smoothed_norm      += alpha * diff;
+    axis->_noise_estimate_norm = noise_step(axis->_noise_estimate_norm, diff,
+                                            axis->_last_residual);
+#endif
+    axis->_last_residual = diff;
+}
+
+
+// ============================================================================
+// Public API - Output & Query
+// ============================================================================
+
+bool smooth_axis_shared_has_new_value(smooth_axis_shared_t *axis) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(axis != NULL, "axis is NULL", false);
+    if (!axis->_has_first_sample) { return false; }
+
+#if SMOOTH_AXIS_FIXED_POINT
+    return report_if_changed_q30(&axis->_shared->_fx,
+                                 &axis->_shared->cfg,
+                                 shared_get_normalized(axis),
+                                 axis->_noise_estimate_norm,
+                                 &axis->_last_reported_norm);
+#else
+    return report_if_changed(&axis->_shared->cfg,
+                             shared_get_normalized(axis),
+                             axis->_noise_estimate_norm,
+                             &axis->_last_reported_norm);
+#endif
+}
+
+float smooth_axis_shared_get_norm(const smooth_axis_shared_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return q30_to_f(shared_get_normalized(axis));
+#else
+    return shared_get_normalized(axis);
+#endif
+}
+
+uint16_t smooth_axis_shared_get_u16(const smooth_axis_shared_t *axis) {
+    SMOOTH_AXIS_GUARD_VAL(axis != NULL, 0);
+
+#if SMOOTH_AXIS_FIXED_POINT
+    return output_u16_q30(&axis->_shared->cfg, shared_get_normalized(axis));
+#else
+    return output_u16(&axis->_shared->cfg, shared_get_normalized(axis));
+#endif
+}
+
+float smooth_axis_shared_get_noise_norm(const smooth_axis_shared_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return axis ? q30_to_f(axis->_noise_estimate_norm) : 0.0f;
+#else
+    return axis ? axis->_noise_estimate_norm : 0.0f;
+#endif
+}
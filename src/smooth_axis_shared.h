@@ -0,0 +1,140 @@
+/**
+ * @file smooth_axis_shared.h
+ * @brief Per-axis state that references one shared, immutable config
+ *
+ * @author Jonatan Vider
+ *
+ * smooth_axis_init() copies the full config into every axis. When hundreds
+ * of axes use identical settings, that copy is most of each axis' RAM and is
+ * dragged through the cache on every update. Here the config is prepared
+ * once in a smooth_axis_shared_cfg_t, and each smooth_axis_shared_t holds
+ * only a pointer to it plus the dynamic filter state.
+ *
+ * RAM on 32-bit MCUs (4-byte pointers, default SMOOTH_AXIS_ALPHA_LUT_SIZE):
+ *
+ *   smooth_axis_t (copied config)   216 bytes per axis  (256 with FIXED_POINT)
+ *   smooth_axis_shared_t             24 bytes per axis
+ *   smooth_axis_shared_cfg_t        140 bytes once      (176 with FIXED_POINT)
+ *
+ *   N axes: 140 + 24·N bytes (e.g. 256 keys: 6.3 KB instead of 55.3 KB)
+ *
+ * LIVE_DT only: AUTO_DT warmup is per-axis mutable state, which this variant
+ * deliberately does not carry (use smooth_axis_bank_t for many AUTO_DT axes).
+ *
+ * Typical usage:
+ * @code
+ * static smooth_axis_shared_cfg_t key_cfg;
+ * static smooth_axis_shared_t     keys[NUM_KEYS];
+ *
+ * smooth_axis_config_t cfg;
+ * smooth_axis_config_live_dt(&cfg, 4095, 0.05f);
+ * smooth_axis_shared_cfg_init(&key_cfg, &cfg);
+ * for (size_t i = 0; i < NUM_KEYS; i++) {
+ *     smooth_axis_shared_init(&keys[i], &key_cfg);
+ * }
+ *
+ * smooth_axis_shared_update_live_dt(&keys[i], raw, dt_sec);
+ * if (smooth_axis_shared_has_new_value(&keys[i])) { ... }
+ * @endcode
+ */
+
+#pragma once
+
+#include "smooth_axis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One config prepared for use by many axes
+ *
+ * Opaque structure - do not access fields directly.
+ * Must outlive every axis that references it and must not change after
+ * smooth_axis_shared_cfg_init() (re-init the axes if it does). The one part
+ * the axes write is the dt → alpha cache, so every axis of one shared config
+ * must be updated from the same context (thread / ISR).
+ */
+typedef struct {
+  smooth_axis_config_t cfg;
+
+  smooth_axis_alpha_cache_t _live_alpha;  // Last dt → alpha of any axis on this config
+
+#if SMOOTH_AXIS_FIXED_POINT
+  smooth_axis_fixed_t _fx;  // Integer coefficients, derived once for all axes (_alpha_q30: cached alpha)
+#endif
+} smooth_axis_shared_cfg_t;
+
+/**
+ * @brief Runtime state for one axis using a shared config
+ *
+ * Opaque structure - do not access fields directly.
+ * Initialize with smooth_axis_shared_init().
+ */
+typedef struct {
+  smooth_axis_shared_cfg_t *_shared;
+
+  // Internal runtime state (do not access directly)
+  smooth_axis_value_t _smoothed_norm;
+  smooth_axis_value_t _noise_estimate_norm;
+  smooth_axis_value_t _last_residual;
+  smooth_axis_value_t _last_reported_norm;
+  bool                _has_first_sample;
+} smooth_axis_shared_t;
+
+// ----------------------------------------------------------------------------
+// Init
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Prepare a shared config from a built config (LIVE_DT mode)
+ *
+ * @param[out] shared Shared config to populate
+ * @param[in]  cfg    Config built with smooth_axis_config_live_dt() (copied once)
+ */
+void smooth_axis_shared_cfg_init(smooth_axis_shared_cfg_t *shared,
+                                 const smooth_axis_config_t *cfg);
+
+/**
+ * @brief Initialize an axis that references `shared`
+ *
+ * @param[out] axis   Axis state to initialize
+ * @param[in]  shared Prepared shared config (referenced, not copied; updates
+ *                    write its alpha cache)
+ */
+void smooth_axis_shared_init(smooth_axis_shared_t *axis,
+                             smooth_axis_shared_cfg_t *shared);
+
+/** @brief Same as smooth_axis_reset() */
+void smooth_axis_shared_reset(smooth_axis_shared_t *axis, uint16_t raw_value);
+
+// ----------------------------------------------------------------------------
+// Update + output (same semantics as the smooth_axis_t functions)
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Same as smooth_axis_update_live_dt()
+ *
+ * @note alpha is cached per dt in the shared config: axes updated with the same
+ *       dt_sec (one frame of a scan) evaluate it once between them, and in the
+ *       FIXED_POINT build the update is then integer-only, as smooth_axis_t.
+ */
+void smooth_axis_shared_update_live_dt(smooth_axis_shared_t *axis,
+                                       uint16_t raw_value,
+                                       float dt_sec);
+
+/** @brief Same as smooth_axis_has_new_value() */
+bool smooth_axis_shared_has_new_value(smooth_axis_shared_t *axis);
+
+/** @brief Same as smooth_axis_get_norm() */
+float smooth_axis_shared_get_norm(const smooth_axis_shared_t *axis);
+
+/** @brief Same as smooth_axis_get_u16() */
+uint16_t smooth_axis_shared_get_u16(const smooth_axis_shared_t *axis);
+
+/** @brief Same as smooth_axis_get_noise_norm() */
+float smooth_axis_shared_get_noise_norm(const smooth_axis_shared_t *axis);
+
+#ifdef __cplusplus
+}
+#endif
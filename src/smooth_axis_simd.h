@@ -0,0 +1,142 @@
+/**
+ * @file smooth_axis_simd.h
+ * @brief Minimal float vector layer for the bank kernels
+ * @author Jonatan Vider
+ *
+ * Not part of the public API. Maps a handful of lane-wise operations onto
+ * the instruction set the compiler targets, so smooth_axis_bank.c can keep a
+ * single kernel body:
+ *
+ *   AVX2          8 lanes   (-mavx2)
+ *   SSE2          4 lanes   (any x86-64)
+ *   Helium / MVE  4 lanes   (Cortex-M55/M85, -mcpu=cortex-m55 with the FP extension)
+ *   NEON          4 lanes   (AArch64, and ARMv7-A with -mfpu=neon)
+ *
+ * The kernels need no vector divide, so every mapping is plain add / mul /
+ * min / max / compare / select. MVE compares produce a lane predicate instead
+ * of a vector mask, so sa_vm is mve_pred16_t there.
+ *
+ * RISC-V V has no mapping: its vector types are sizeless and the lane count is
+ * set at run time (vsetvl), which this fixed-lane layer cannot express. It gets
+ * SMOOTH_AXIS_VF_LANES == 1 and the branchless scalar lane, which GCC/Clang
+ * auto-vectorize with -march=rv64gcv, as on any other target without a mapping.
+ * Build with -DSMOOTH_AXIS_SIMD=0 to force the scalar lane everywhere.
+ *
+ * Results are bit-exact with the scalar path as long as the compiler does
+ * not contract a*b+c into FMA (-ffp-contract=off, default for -std=c99).
+ * ARMv7 NEON flushes denormals to zero, so there a noise estimate that has
+ * decayed below FLT_MIN reads 0 instead of a denormal (no visible effect on
+ * the output). The MVE and ARMv7 NEON mappings follow ACLE and have not been
+ * run on hardware yet; -DSMOOTH_AXIS_SIMD=0 is the fallback if one misbehaves.
+ */
+
+#pragma once
+
+#ifndef SMOOTH_AXIS_SIMD
+#define SMOOTH_AXIS_SIMD 1
+#endif
+
+#if SMOOTH_AXIS_SIMD && defined(__AVX2__)
+
+#include <immintrin.h>
+
+#define SMOOTH_AXIS_VF_LANES 8
+typedef __m256 sa_vf;
+typedef __m256 sa_vm;
+
+#define VF_SET1(x)          _mm256_set1_ps(x)
+#define VF_LOAD(p)          _mm256_loadu_ps(p)
+#define VF_STORE(p, v)      _mm256_storeu_ps((p), (v))
+#define VF_LOAD_U16(p)      _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32( \
+                                _mm_loadu_si128((const __m128i *)(const void *)(p))))
+#define VF_ADD(a, b)        _mm256_add_ps((a), (b))
+#define VF_SUB(a, b)        _mm256_sub_ps((a), (b))
+#define VF_MUL(a, b)        _mm256_mul_ps((a), (b))
+#define VF_MIN(a, b)        _mm256_min_ps((a), (b))
+#define VF_MAX(a, b)        _mm256_max_ps((a), (b))
+#define VF_ABS(a)           _mm256_andnot_ps(_mm256_set1_ps(-0.0f), (a))
+#define VF_GT(a, b)         _mm256_cmp_ps((a), (b), _CMP_GT_OQ)
+#define VF_LT(a, b)         _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+#define VM_AND(a, b)        _mm256_and_ps((a), (b))
+#define VM_OR(a, b)         _mm256_or_ps((a), (b))
+#define VF_ZERO_WHERE(m, a) _mm256_andnot_ps((m), (a))   // m ? 0 : a
+
+#elif SMOOTH_AXIS_SIMD && (defined(__SSE2__) || defined(_M_X64))
+
+#include <emmintrin.h>
+
+#define SMOOTH_AXIS_VF_LANES 4
+typedef __m128 sa_vf;
+typedef __m128 sa_vm;
+
+#define VF_SET1(x)          _mm_set1_ps(x)
+#define VF_LOAD(p)          _mm_loadu_ps(p)
+#define VF_STORE(p, v)      _mm_storeu_ps((p), (v))
+#define VF_LOAD_U16(p)      _mm_cvtepi32_ps(_mm_unpacklo_epi16( \
+                                _mm_loadl_epi64((const __m128i *)(const void *)(p)), \
+                                _mm_setzero_si128()))
+#define VF_ADD(a, b)        _mm_add_ps((a), (b))
+#define VF_SUB(a, b)        _mm_sub_ps((a), (b))
+#define VF_MUL(a, b)        _mm_mul_ps((a), (b))
+#define VF_MIN(a, b)        _mm_min_ps((a), (b))
+#define VF_MAX(a, b)        _mm_max_ps((a), (b))
+#define VF_ABS(a)           _mm_andnot_ps(_mm_set1_ps(-0.0f), (a))
+#define VF_GT(a, b)         _mm_cmpgt_ps((a), (b))
+#define VF_LT(a, b)         _mm_cmplt_ps((a), (b))
+#define VM_AND(a, b)        _mm_and_ps((a), (b))
+#define VM_OR(a, b)         _mm_or_ps((a), (b))
+#define VF_ZERO_WHERE(m, a) _mm_andnot_ps((m), (a))      // m ? 0 : a
+
+#elif SMOOTH_AXIS_SIMD && defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+
+#include <arm_mve.h>
+
+#define SMOOTH_AXIS_VF_LANES 4
+typedef float32x4_t  sa_vf;
+typedef mve_pred16_t sa_vm;  // Lane predicate (4 bits per 32-bit lane)
+
+#define VF_SET1(x)          vdupq_n_f32(x)
+#define VF_LOAD(p)          vld1q_f32(p)
+#define VF_STORE(p, v)      vst1q_f32((p), (v))
+#define VF_LOAD_U16(p)      vcvtq_f32_u32(vldrhq_u32(p))    // Widening load
+#define VF_ADD(a, b)        vaddq_f32((a), (b))
+#define VF_SUB(a, b)        vsubq_f32((a), (b))
+#define VF_MUL(a, b)        vmulq_f32((a), (b))
+#define VF_MIN(a, b)        vminnmq_f32((a), (b))           // No NaNs in the kernels
+#define VF_MAX(a, b)        vmaxnmq_f32((a), (b))
+#define VF_ABS(a)           vabsq_f32(a)
+#define VF_GT(a, b)         vcmpgtq_f32((a), (b))
+#define VF_LT(a, b)         vcmpltq_f32((a), (b))
+#define VM_AND(a, b)        ((mve_pred16_t)((a) & (b)))
+#define VM_OR(a, b)         ((mve_pred16_t)((a) | (b)))
+#define VF_ZERO_WHERE(m, a) vpselq_f32(vdupq_n_f32(0.0f), (a), (m))
+
+#elif SMOOTH_AXIS_SIMD && defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+#define SMOOTH_AXIS_VF_LANES 4
+typedef float32x4_t sa_vf;
+typedef uint32x4_t  sa_vm;
+
+#define VF_SET1(x)          vdupq_n_f32(x)
+#define VF_LOAD(p)          vld1q_f32(p)
+#define VF_STORE(p, v)      vst1q_f32((p), (v))
+#define VF_LOAD_U16(p)      vcvtq_f32_u32(vmovl_u16(vld1_u16(p)))
+#define VF_ADD(a, b)        vaddq_f32((a), (b))
+#define VF_SUB(a, b)        vsubq_f32((a), (b))
+#define VF_MUL(a, b)        vmulq_f32((a), (b))
+#define VF_MIN(a, b)        vminq_f32((a), (b))
+#define VF_MAX(a, b)        vmaxq_f32((a), (b))
+#define VF_ABS(a)           vabsq_f32(a)
+#define VF_GT(a, b)         vcgtq_f32((a), (b))
+#define VF_LT(a, b)         vcltq_f32((a), (b))
+#define VM_AND(a, b)        vandq_u32((a), (b))
+#define VM_OR(a, b)         vorrq_u32((a), (b))
+#define VF_ZERO_WHERE(m, a) vbslq_f32((m), vdupq_n_f32(0.0f), (a))
+
+#else
+
+#define SMOOTH_AXIS_VF_LANES 1
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file smooth_axis_spsc.c
+ * @brief Implementation of the seqlock producer/consumer channel
+ * @author Jonatan Vider
+ *
+ * See smooth_axis_spsc.h for API documentation.
+ */
+
+#include "smooth_axis_spsc.h"
+#include "smooth_axis_internal.h"
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Same as smooth_axis_get_norm() before the float conversion
+static smooth_axis_value_t spsc_axis_position(const smooth_axis_t *axis) {
+#if SMOOTH_AXIS_FIXED_POINT
+    return apply_sticky_margins_q30(&axis->_fx, axis->_smoothed_norm);
+#else
+    return apply_sticky_margins(&axis->cfg, axis->_smoothed_norm);
+#endif
+}
+
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void smooth_axis_spsc_init(smooth_axis_spsc_t *chan, const smooth_axis_t *axis) {
+    SMOOTH_AXIS_CHECK_RETURN(chan != NULL, "channel is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+
+    chan->_seq                = 0;  // 0 = nothing published yet
+    chan->_norm               = 0;
+    chan->_noise              = 0;
+    chan->_axis               = axis;
+    chan->_last_reported_norm = 0;
+}
+
+void smooth_axis_spsc_publish(smooth_axis_spsc_t *chan) {
+    SMOOTH_AXIS_CHECK_RETURN(chan != NULL && chan->_axis != NULL, "channel not initialized");
+
+    const smooth_axis_t *axis = chan->_axis;
+    if (!axis->_has_first_sample) { return; }
+
+    uint32_t seq = chan->_seq;
+
+    chan->_seq = seq + 1u;  // Odd: write in progress
+    SMOOTH_AXIS_SPSC_BARRIER();
+    chan->_norm  = spsc_axis_position(axis);
+    chan->_noise = axis->_noise_estimate_norm;
+    SMOOTH_AXIS_SPSC_BARRIER();
+    chan->_seq = (seq + 2u) ? seq + 2u : 2u;  // Even again, never back to 0 on wrap
+}
+
+bool smooth_axis_spsc_read(smooth_axis_spsc_t *chan, smooth_axis_reading_t *out) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(out != NULL, "out is NULL", false);
+    out->norm    = 0.0f;
+    out->u16     = 0;
+    out->has_new = false;
+    SMOOTH_AXIS_CHECK_RETURN_VAL(chan != NULL && chan->_axis != NULL,
+                                 "channel not initialized", false);
+
+    uint32_t            seq_begin, seq_end;
+    smooth_axis_value_t norm, noise;
+    do {
+        seq_begin = chan->_seq;
+        SMOOTH_AXIS_SPSC_BARRIER();
+        norm  = chan->_norm;
+        noise = chan->_noise;
+        SMOOTH_AXIS_SPSC_BARRIER();
+        seq_end = chan->_seq;
+    } while ((seq_begin & 1u) || seq_begin != seq_end);  // Producer wrote meanwhile: retry
+
+    if (seq_begin == 0) { return false; }
+
+    // Report decision runs here, against the consumer's own last-reported value
+    const smooth_axis_t *axis = chan->_axis;
+#if SMOOTH_AXIS_FIXED_POINT
+    out->norm    = q30_to_f(norm);
+    out->u16     = output_u16_q30(&axis->cfg, norm);
+    out->has_new = report_if_changed_q30(&axis->_fx, &axis->cfg, norm, noise,
+                                         &chan->_last_reported_norm);
+#else
+    out->norm    = norm;
+    out->u16     = output_u16(&axis->cfg, norm);
+    out->has_new = report_if_changed(&axis->cfg, norm, noise, &chan->_last_reported_norm);
+#endif
+    return true;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file smooth_axis_spsc.h
+ * @brief Lock-free single-producer/single-consumer split for ISR sampling
+ *
+ * @author Jonatan Vider
+ *
+ * Lets a timer ISR own smooth_axis_update_*() while the main loop reads results,
+ * without disabling interrupts. The ISR publishes the filter output into a
+ * channel guarded by a sequence counter (seqlock); the main loop copies it out
+ * torn-free and runs the change detection on its own side.
+ *
+ * Only aligned 32-bit loads/stores are required (no LDREX/STREX, no CAS), so it
+ * works on Cortex-M0+, AVR-class cores with 32-bit aligned words, etc. The
+ * writer never waits; the reader retries if the ISR fired mid-copy.
+ *
+ * Typical usage:
+ * @code
+ * static smooth_axis_t      axis;
+ * static smooth_axis_spsc_t chan;
+ *
+ * smooth_axis_init(&axis, &cfg);
+ * smooth_axis_spsc_init(&chan, &axis);
+ *
+ * void adc_timer_isr(void) {                       // Producer
+ *     smooth_axis_update_live_dt(&axis, read_adc(), ADC_DT_SEC);
+ *     smooth_axis_spsc_publish(&chan);
+ * }
+ *
+ * while (1) {                                      // Consumer
+ *     smooth_axis_reading_t r;
+ *     if (smooth_axis_spsc_read(&chan, &r) && r.has_new) {
+ *         handle_change(r.u16);
+ *     }
+ * }
+ * @endcode
+ *
+ * @note The consumer must not call smooth_axis_has_new_value() or any other
+ *       function on the axis itself - the channel replaces those calls.
+ */
+
+#pragma once
+
+#include "smooth_axis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Ordering barrier between the sequence counter and the payload
+ *
+ * Default is a compiler barrier, which is sufficient when producer and consumer
+ * run on the same core (ISR vs main loop). For a producer on another core
+ * (e.g. RP2040 core 1) define it to a hardware fence before including this
+ * header, e.g. -DSMOOTH_AXIS_SPSC_BARRIER()=__sync_synchronize().
+ */
+#ifndef SMOOTH_AXIS_SPSC_BARRIER
+#if defined(__GNUC__) || defined(__clang__)
+#define SMOOTH_AXIS_SPSC_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define SMOOTH_AXIS_SPSC_BARRIER() ((void)0)  // volatile accesses keep program order
+#endif
+#endif
+
+/**
+ * @brief One consistent view of the axis output, as seen by the consumer
+ */
+typedef struct {
+  float    norm;     // smooth_axis_get_norm() at publish time
+  uint16_t u16;      // smooth_axis_get_u16() at publish time
+  bool     has_new;  // smooth_axis_has_new_value(), evaluated on the consumer side
+} smooth_axis_reading_t;
+
+/**
+ * @brief Channel between an updating producer and a reading consumer
+ *
+ * Opaque structure - do not access fields directly.
+ * Initialize with smooth_axis_spsc_init() after smooth_axis_init().
+ */
+typedef struct {
+  // Producer-written (seqlock: odd = write in progress)
+  volatile uint32_t            _seq;
+  volatile smooth_axis_value_t _norm;   // Post-sticky position
+  volatile smooth_axis_value_t _noise;  // Noise estimate for the report threshold
+
+  // Consumer-owned
+  const smooth_axis_t *_axis;  // Only config/coefficients are read (constant after init)
+  smooth_axis_value_t  _last_reported_norm;
+} smooth_axis_spsc_t;
+
+/**
+ * @brief Attach a channel to an initialized axis
+ *
+ * @param[out] chan Channel to initialize
+ * @param[in]  axis Axis updated by the producer (must outlive the channel)
+ *
+ * @note Call before the producer starts publishing (e.g. before enabling the ISR).
+ */
+void smooth_axis_spsc_init(smooth_axis_spsc_t *chan, const smooth_axis_t *axis);
+
+/**
+ * @brief Publish the axis' current output (producer side, e.g. ISR)
+ *
+ * Call after smooth_axis_update_*(). Wait-free: a handful of 32-bit stores.
+ * Does nothing until the axis has received its first sample.
+ */
+void smooth_axis_spsc_publish(smooth_axis_spsc_t *chan);
+
+/**
+ * @brief Copy out the latest published output (consumer side, e.g. main loop)
+ *
+ * @param[in,out] chan Channel (updates the consumer's last-reported value when has_new)
+ * @param[out]    out  Torn-free (norm, u16, has_new) triple
+ * @return false if nothing has been published yet (out is zeroed)
+ *
+ * @note Retries internally if the producer published during the copy.
+ */
+bool smooth_axis_spsc_read(smooth_axis_spsc_t *chan, smooth_axis_reading_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,384 @@
+/**
+ * @file smooth_axis_static.h
+ * @brief Header-only axes with mode, max_raw, settle time and sticky zone fixed at compile time
+ *
+ * @author Jonatan Vider
+ *
+ * smooth_axis_t reads every setting from its copied config and re-checks the
+ * mode on every call. When those settings are known at build time, this header
+ * generates an axis type whose config is a compile-time constant: the compiler
+ * folds the coefficients, inlines the whole per-sample path and drops the NULL,
+ * mode and dead-zone branches. No smooth_axis.c is needed.
+ *
+ * Same filter and report decision as smooth_axis_t (the math comes from the same
+ * inline helpers): AUTO_DT results are bit-exact. LIVE_DT evaluates 1 - expf(k·dt)
+ * whenever dt_sec changes instead of the config's alpha table, so it agrees with
+ * smooth_axis_t to within the table error (5e-6 relative); steady dt is free.
+ *
+ * Restrictions (by design - these are what make the constants foldable):
+ * - Full input range (no full_off / full_on dead zones), max_raw >= 1
+ * - Float math, regardless of SMOOTH_AXIS_FIXED_POINT (like smooth_axis_bank_t)
+ * - No argument checks: pass a valid, initialized axis
+ * - If SMOOTH_AXIS_MAX_RAW is defined, max_raw must equal it
+ *
+ * RAM per axis on 32-bit MCUs: 44 bytes (vs 216 for smooth_axis_t); the config
+ * lives in flash, or is folded away entirely.
+ *
+ * C usage (one line per axis type, at file scope):
+ * @code
+ * SMOOTH_AXIS_STATIC_DEFINE(throttle, 4095, 50, SMOOTH_AXIS_MODE_LIVE_DT, NULL)
+ *
+ * static throttle_t thr;
+ * throttle_init(&thr);
+ *
+ * throttle_update_dt(&thr, read_adc(), dt_sec);
+ * if (throttle_has_new_value(&thr)) { send(throttle_get_u16(&thr)); }
+ * @endcode
+ *
+ * C++ usage:
+ * @code
+ * SmoothAxis<1023, 100, SMOOTH_AXIS_MODE_AUTO_DT, my_now_ms> knob;
+ *
+ * knob.update(analogRead(A0));
+ * if (knob.has_new_value()) { use(knob.get_u16()); }
+ * @endcode
+ */
+
+#pragma once
+
+#include <float.h>
+#include <stddef.h>  // offsetof
+#include "smooth_axis.h"
+#include "smooth_axis_internal.h"
+
+// ----------------------------------------------------------------------------
+// Compile-time config
+// ----------------------------------------------------------------------------
+
+/** @brief Default sticky zone in 1/1023 units (same as smooth_axis_config_*()) */
+#define SMOOTH_AXIS_STATIC_STICKY_U 3
+
+/** @internal logf(EMA_CONVERGENCE_THRESHOLD) as a literal (constant expression) */
+#define SMOOTH_AXIS_STATIC_LN_RESIDUAL_ (-2.99573231f)
+
+/** @internal Unnudged 1 / max_raw */
+#define SMOOTH_AXIS_STATIC_SCALE0_(max_raw) (1.0f / (1.0f * (float)(max_raw)))
+
+/**
+ * @internal Input scale as map_coeffs_init() computes it for full range: one ulp up
+ * when the reciprocal rounds low (one step always suffices for max_raw <= 65535).
+ */
+#define SMOOTH_AXIS_STATIC_SCALE_(max_raw)                                          \
+    (1.0f * (float)(max_raw) * SMOOTH_AXIS_STATIC_SCALE0_(max_raw) + -0.0f < 1.0f   \
+     ? SMOOTH_AXIS_STATIC_SCALE0_(max_raw)                                          \
+       + SMOOTH_AXIS_STATIC_SCALE0_(max_raw) * (FLT_EPSILON / 2.0f)                 \
+     : SMOOTH_AXIS_STATIC_SCALE0_(max_raw))
+
+/** @internal Clamped sticky zone from 1/1023 units */
+#define SMOOTH_AXIS_STATIC_STICKY_(sticky_u)                                         \
+    ((float)(sticky_u) / 1023.0f < 0.49f ? (float)(sticky_u) / 1023.0f : 0.49f)
+
+/** @internal compute_ema_decay_rate() and compute_dyn_scale() on a literal settle time */
+#define SMOOTH_AXIS_STATIC_SEC_(settle_ms) ((float)(settle_ms) / 1000.0f)
+#define SMOOTH_AXIS_STATIC_DECAY_(settle_ms)                                         \
+    ((settle_ms) > 0 ? SMOOTH_AXIS_STATIC_LN_RESIDUAL_ / SMOOTH_AXIS_STATIC_SEC_(settle_ms) : 0.0f)
+#define SMOOTH_AXIS_STATIC_ATTEN_(settle_ms)                                         \
+    (SMOOTH_AXIS_STATIC_SEC_(settle_ms) / 0.1f < 1.0f                                \
+     ? 1.0f : 1.0f / (SMOOTH_AXIS_STATIC_SEC_(settle_ms) / 0.1f))
+
+#if SMOOTH_AXIS_ALPHA_LUT_SIZE >= 2
+#define SMOOTH_AXIS_STATIC_LUT_INIT_ , { 0.0f }  // Unused: LIVE_DT alpha comes from expf()
+#else
+#define SMOOTH_AXIS_STATIC_LUT_INIT_
+#endif
+
+/**
+ * @brief Constant initializer for a smooth_axis_config_t (C99 and C++11 constexpr)
+ *
+ * Positional: must follow the member order of smooth_axis_config_t. The layout
+ * checks below fail the build when that order changes.
+ */
+#define SMOOTH_AXIS_STATIC_CONFIG(max_raw, settle_ms, mode, now_fn, timer_hz, sticky_u) \
+    {                                                                                   \
+        (uint16_t)(max_raw), 0,                        /* no decimation */             \
+        0.0f, 1.0f,                                    /* full_off / full_on */        \
+        SMOOTH_AXIS_STATIC_STICKY_(sticky_u),                                           \
+        (mode),                                                                         \
+        SMOOTH_AXIS_STATIC_SEC_(settle_ms),                                             \
+        (now_fn), (timer_hz), false, false,            /* timer, no tracking/fast */   \
+        0,                                             /* no idle detection */         \
+        SMOOTH_AXIS_STATIC_DECAY_(settle_ms),                                           \
+        SMOOTH_AXIS_STATIC_ATTEN_(settle_ms),                                           \
+        { SMOOTH_AXIS_STATIC_SCALE_(max_raw), -0.0f,   /* _map */                      \
+          SMOOTH_AXIS_STATIC_STICKY_(sticky_u),                                         \
+          1.0f + 2.0f * SMOOTH_AXIS_STATIC_STICKY_(sticky_u),                           \
+          1.0f / (float)(max_raw),                                                      \
+          ((float)(max_raw) - 1.0f) / (float)(max_raw) }                                \
+        SMOOTH_AXIS_STATIC_LUT_INIT_                                                    \
+    }
+
+/** @internal Compile-time check: static_assert in C++, a negative array size in C99 */
+#ifdef __cplusplus
+#define SMOOTH_AXIS_STATIC_ASSERT_(cond, tag) static_assert(cond, "SMOOTH_AXIS_STATIC_CONFIG: " #tag)
+#else
+#define SMOOTH_AXIS_STATIC_ASSERT_(cond, tag) typedef char smooth_axis_static_check_##tag##_[(cond) ? 1 : -1]
+#endif
+
+/**
+ * @internal The smooth_axis_config_t member list SMOOTH_AXIS_STATIC_CONFIG is
+ * written against. Adding, removing or reordering a config member changes the
+ * size or an offset and trips a check (except a 1-byte member in the padding
+ * after decimation): update this list and the initializer together.
+ */
+typedef struct {
+  uint16_t              max_raw;
+  uint8_t               decimation;
+  float                 full_off_norm;
+  float                 full_on_norm;
+  float                 sticky_zone_norm;
+  smooth_axis_mode_t    mode;
+  float                 settle_time_sec;
+  smooth_axis_now_ms_fn now_ms;
+  uint32_t              timer_hz;
+  bool                  auto_dt_tracking;
+  bool                  fast_warmup;
+  uint16_t              idle_frames;
+  float                 _ema_decay_rate;
+  float                 _threshold_attenuation;
+  smooth_axis_map_t     _map;
+#if SMOOTH_AXIS_ALPHA_LUT_SIZE >= 2
+  float                 _alpha_lut[SMOOTH_AXIS_ALPHA_LUT_SIZE];
+#endif
+} smooth_axis_static_layout_t_;
+
+#define SMOOTH_AXIS_STATIC_AT_(member)                                                 \
+    SMOOTH_AXIS_STATIC_ASSERT_(offsetof(smooth_axis_config_t, member)                 \
+                               == offsetof(smooth_axis_static_layout_t_, member), member)
+
+SMOOTH_AXIS_STATIC_ASSERT_(sizeof(smooth_axis_config_t) == sizeof(smooth_axis_static_layout_t_), size);
+SMOOTH_AXIS_STATIC_AT_(max_raw);
+SMOOTH_AXIS_STATIC_AT_(decimation);
+SMOOTH_AXIS_STATIC_AT_(full_off_norm);
+SMOOTH_AXIS_STATIC_AT_(full_on_norm);
+SMOOTH_AXIS_STATIC_AT_(sticky_zone_norm);
+SMOOTH_AXIS_STATIC_AT_(mode);
+SMOOTH_AXIS_STATIC_AT_(settle_time_sec);
+SMOOTH_AXIS_STATIC_AT_(now_ms);
+SMOOTH_AXIS_STATIC_AT_(timer_hz);
+SMOOTH_AXIS_STATIC_AT_(auto_dt_tracking);
+SMOOTH_AXIS_STATIC_AT_(fast_warmup);
+SMOOTH_AXIS_STATIC_AT_(idle_frames);
+SMOOTH_AXIS_STATIC_AT_(_ema_decay_rate);
+SMOOTH_AXIS_STATIC_AT_(_threshold_attenuation);
+SMOOTH_AXIS_STATIC_AT_(_map);
+
+// ----------------------------------------------------------------------------
+// Shared implementation (called with a constant config, then inlined)
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Runtime state of a compile-time configured axis
+ *
+ * Opaque structure - do not access fields directly.
+ */
+typedef struct {
+  float _smoothed_norm;
+  float _noise_estimate_norm;
+  float _last_residual;
+  float _last_reported_norm;
+  bool  _has_first_sample;
+
+  // Mode is fixed per type, so only one timebase is ever live
+  union {
+    smooth_axis_warmup_t      _warmup;      // AUTO_DT
+    smooth_axis_alpha_cache_t _live_alpha;  // LIVE_DT
+  } _dt;
+} smooth_axis_static_t;
+
+static inline void smooth_axis_static_init_(smooth_axis_static_t *s,
+                                            const smooth_axis_config_t *cfg) {
+    SMOOTH_AXIS_ASSERT(SMOOTH_AXIS_MAX_RAW == 0 || cfg->max_raw == SMOOTH_AXIS_MAX_RAW,
+                       "max_raw must match the compile-time SMOOTH_AXIS_MAX_RAW");
+    s->_smoothed_norm       = 0.0f;
+    s->_noise_estimate_norm = INITIAL_NOISE_NORM;
+    s->_last_residual       = 0.0f;
+    s->_last_reported_norm  = 0.0f;
+    s->_has_first_sample    = false;
+    if (cfg->mode == SMOOTH_AXIS_MODE_AUTO_DT) {
+        warmup_init(&s->_dt._warmup, cfg);
+    } else {
+        alpha_cache_init(&s->_dt._live_alpha);
+    }
+}
+
+static inline void smooth_axis_static_reset_(smooth_axis_static_t *s,
+                                             const smooth_axis_config_t *cfg,
+                                             uint16_t raw_value) {
+    float norm = raw_value ? input_norm(cfg, raw_value) : 0.0f;
+
+    s->_smoothed_norm       = norm;
+    s->_noise_estimate_norm = INITIAL_NOISE_NORM;
+    s->_last_reported_norm  = norm;
+    s->_last_residual       = 0.0f;
+    s->_has_first_sample    = raw_value ? true : false;
+}
+
+// Same as update_core() in smooth_axis.c
+static inline void smooth_axis_static_step_(smooth_axis_static_t *s,
+                                            const smooth_axis_config_t *cfg,
+                                            uint16_t raw_value,
+                                            float alpha) {
+    float norm = input_norm(cfg, raw_value);
+    if (!s->_has_first_sample) {  // First sample teleports (skip EMA on frame 0)
+        s->_has_first_sample = true;
+        s->_smoothed_norm    = norm;
+        return;
+    }
+
+    float diff = norm - s->_smoothed_norm;
+    s->_smoothed_norm      += alpha * diff;
+    s->_noise_estimate_norm = noise_step(s->_noise_estimate_norm, diff, s->_last_residual);
+    s->_last_residual       = diff;
+}
+
+static inline void smooth_axis_static_update_auto_(smooth_axis_static_t *s,
+                                                   const smooth_axis_config_t *cfg,
+                                                   uint16_t raw_value) {
+    SMOOTH_AXIS_ASSERT(cfg->mode == SMOOTH_AXIS_MODE_AUTO_DT, "wrong mode: use update_dt()");
+    auto_dt_step(&s->_dt._warmup, cfg);
+    smooth_axis_static_step_(s, cfg, raw_value, s->_dt._warmup._auto_alpha);
+}
+
+static inline void smooth_axis_static_update_live_(smooth_axis_static_t *s,
+                                                   const smooth_axis_config_t *cfg,
+                                                   uint16_t raw_value,
+                                                   float dt_sec) {
+    SMOOTH_AXIS_ASSERT(cfg->mode == SMOOTH_AXIS_MODE_LIVE_DT, "wrong mode: use update()");
+    smooth_axis_alpha_cache_t *c = &s->_dt._live_alpha;
+    if (dt_sec != c->_dt_sec) {  // Skipped at steady dt
+        c->_dt_sec = dt_sec;
+        c->_alpha  = get_alpha_from_dt(cfg->_ema_decay_rate, dt_sec);
+    }
+    smooth_axis_static_step_(s, cfg, raw_value, c->_alpha);
+}
+
+static inline float smooth_axis_static_position_(const smooth_axis_static_t *s,
+                                                 const smooth_axis_config_t *cfg) {
+    return s->_has_first_sample ? apply_sticky_margins(cfg, s->_smoothed_norm) : 0.0f;
+}
+
+static inline bool smooth_axis_static_has_new_(smooth_axis_static_t *s,
+                                               const smooth_axis_config_t *cfg) {
+    if (!s->_has_first_sample) { return false; }
+    return report_if_changed(cfg, smooth_axis_static_position_(s, cfg),
+                             s->_noise_estimate_norm, &s->_last_reported_norm);
+}
+
+static inline uint16_t smooth_axis_static_get_u16_(const smooth_axis_static_t *s,
+                                                   const smooth_axis_config_t *cfg) {
+    return output_u16(cfg, smooth_axis_static_position_(s, cfg));
+}
+
+// ----------------------------------------------------------------------------
+// C: generate an axis type
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Define axis type `name_t` and its functions, fully specified
+ *
+ * @param name      Prefix for the generated type and functions
+ * @param max_raw   ADC maximum (literal, >= 1)
+ * @param settle_ms Settle time in milliseconds (literal)
+ * @param mode      SMOOTH_AXIS_MODE_AUTO_DT or SMOOTH_AXIS_MODE_LIVE_DT
+ * @param now_fn    Timer function for AUTO_DT (NULL for LIVE_DT)
+ * @param timer_hz  Tick rate of now_fn (1000 for milliseconds)
+ * @param sticky_u  Sticky zone in 1/1023 units (SMOOTH_AXIS_STATIC_STICKY_U = default)
+ *
+ * Generates name_init(), name_reset(), name_update() (AUTO_DT), name_update_dt()
+ * (LIVE_DT), name_has_new_value(), name_get_norm(), name_get_u16() and
+ * name_get_noise_norm(), with the same semantics as the smooth_axis_* functions.
+ */
+#define SMOOTH_AXIS_STATIC_DEFINE_EX(name, max_raw, settle_ms, mode, now_fn, timer_hz, sticky_u) \
+    typedef struct { smooth_axis_static_t _s; } name##_t;                                        \
+    static const smooth_axis_config_t name##_cfg_ =                                              \
+        SMOOTH_AXIS_STATIC_CONFIG(max_raw, settle_ms, mode, now_fn, timer_hz, sticky_u);         \
+    static inline void name##_init(name##_t *a) {                                                \
+        smooth_axis_static_init_(&a->_s, &name##_cfg_);                                          \
+    }                                                                                            \
+    static inline void name##_reset(name##_t *a, uint16_t raw_value) {                           \
+        smooth_axis_static_reset_(&a->_s, &name##_cfg_, raw_value);                              \
+    }                                                                                            \
+    static inline void name##_update(name##_t *a, uint16_t raw_value) {                          \
+        smooth_axis_static_update_auto_(&a->_s, &name##_cfg_, raw_value);                        \
+    }                                                                                            \
+    static inline void name##_update_dt(name##_t *a, uint16_t raw_value, float dt_sec) {         \
+        smooth_axis_static_update_live_(&a->_s, &name##_cfg_, raw_value, dt_sec);                \
+    }                                                                                            \
+    static inline bool name##_has_new_value(name##_t *a) {                                       \
+        return smooth_axis_static_has_new_(&a->_s, &name##_cfg_);                                \
+    }                                                                                            \
+    static inline float name##_get_norm(const name##_t *a) {                                     \
+        return smooth_axis_static_position_(&a->_s, &name##_cfg_);                               \
+    }                                                                                            \
+    static inline uint16_t name##_get_u16(const name##_t *a) {                                   \
+        return smooth_axis_static_get_u16_(&a->_s, &name##_cfg_);                                \
+    }                                                                                            \
+    static inline float name##_get_noise_norm(const name##_t *a) {                               \
+        return a->_s._noise_estimate_norm;                                                       \
+    }
+
+/** @brief SMOOTH_AXIS_STATIC_DEFINE_EX() with a millisecond timer and the default sticky zone */
+#define SMOOTH_AXIS_STATIC_DEFINE(name, max_raw, settle_ms, mode, now_fn) \
+    SMOOTH_AXIS_STATIC_DEFINE_EX(name, max_raw, settle_ms, mode, now_fn, 1000u, SMOOTH_AXIS_STATIC_STICKY_U)
+
+// ----------------------------------------------------------------------------
+// C++: template wrapper
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+/**
+ * @brief Compile-time configured axis (C++11)
+ *
+ * Same parameters as SMOOTH_AXIS_STATIC_DEFINE_EX(). Calling update() on a
+ * LIVE_DT type, or update(raw, dt) on an AUTO_DT type, fails to compile.
+ */
+template <uint16_t MaxRaw, uint32_t SettleMs, smooth_axis_mode_t Mode,
+          smooth_axis_now_ms_fn Now = nullptr, uint32_t TimerHz = 1000,
+          uint16_t StickyU = SMOOTH_AXIS_STATIC_STICKY_U>
+class SmoothAxis {
+  static_assert(MaxRaw >= 1, "MaxRaw must be at least 1");
+  static_assert(Mode != SMOOTH_AXIS_MODE_AUTO_DT || Now != nullptr, "AUTO_DT needs a timer");
+
+public:
+  SmoothAxis() { smooth_axis_static_init_(&s_, &cfg_); }
+
+  void reset(uint16_t raw_value) { smooth_axis_static_reset_(&s_, &cfg_, raw_value); }
+
+  void update(uint16_t raw_value) {
+      static_assert(Mode == SMOOTH_AXIS_MODE_AUTO_DT, "LIVE_DT axis: use update(raw, dt_sec)");
+      smooth_axis_static_update_auto_(&s_, &cfg_, raw_value);
+  }
+
+  void update(uint16_t raw_value, float dt_sec) {
+      static_assert(Mode == SMOOTH_AXIS_MODE_LIVE_DT, "AUTO_DT axis: use update(raw)");
+      smooth_axis_static_update_live_(&s_, &cfg_, raw_value, dt_sec);
+  }
+
+  bool     has_new_value() { return smooth_axis_static_has_new_(&s_, &cfg_); }
+  float    get_norm() const { return smooth_axis_static_position_(&s_, &cfg_); }
+  uint16_t get_u16() const { return smooth_axis_static_get_u16_(&s_, &cfg_); }
+  float    get_noise_norm() const { return s_._noise_estimate_norm; }
+
+private:
+  static constexpr smooth_axis_config_t cfg_ =
+      SMOOTH_AXIS_STATIC_CONFIG(MaxRaw, SettleMs, Mode, Now, TimerHz, StickyU);
+
+  smooth_axis_static_t s_;
+};
+
+template <uint16_t MaxRaw, uint32_t SettleMs, smooth_axis_mode_t Mode,
+          smooth_axis_now_ms_fn Now, uint32_t TimerHz, uint16_t StickyU>
+constexpr smooth_axis_config_t SmoothAxis<MaxRaw, SettleMs, Mode, Now, TimerHz, StickyU>::cfg_;
+
+#endif
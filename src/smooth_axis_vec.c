@@ -0,0 +1,180 @@
+/**
+ * @file smooth_axis_vec.c
+ * @brief Implementation of vector (2D/3D/4D) axes
+ * @author Jonatan Vider
+ *
+ * See smooth_axis_vec.h for API documentation.
+ */
+
+#include "smooth_axis_vec.h"
+#include "smooth_axis_internal.h"
+
+// ============================================================================
+// Core Update Logic
+// ============================================================================
+
+// raw[0 .. dims-1] normalized (unused lanes are never read)
+static inline void vec_load_norm(const smooth_axis_vec_t *vec, const uint16_t *raw,
+                                 float norm[SMOOTH_AXIS_VEC_LANES]) {
+    for (size_t k = 0; k < vec->dims; k++) { norm[k] = input_norm(&vec->cfg, raw[k]); }
+}
+
+// Post-sticky output of every component, once per update (the scalar axis output cache)
+static void vec_output_refresh(smooth_axis_vec_t *vec) {
+    for (size_t k = 0; k < vec->dims; k++) {
+        vec->_out_norm[k] = vec->_has_first_sample ? apply_sticky_margins(&vec->cfg, vec->_smoothed_norm[k]) : 0.0f;
+    }
+}
+
+// update_core() + update_noise_estimate() on every component, written as selects
+// (no per-component branches). SHARED feeds one estimate the mean noise sample.
+static void vec_update_core(smooth_axis_vec_t *vec, const uint16_t *raw, float alpha) {
+    float norm[SMOOTH_AXIS_VEC_LANES];
+    vec_load_norm(vec, raw, norm);
+
+    if (!vec->_has_first_sample) {  // Seed every component (skip EMA on frame 0)
+        for (size_t k = 0; k < vec->dims; k++) { vec->_smoothed_norm[k] = norm[k]; }
+        vec->_has_first_sample = true;
+        vec_output_refresh(vec);
+        return;
+    }
+
+    float sample[SMOOTH_AXIS_VEC_LANES];
+    for (size_t k = 0; k < vec->dims; k++) {
+        float diff = norm[k] - vec->_smoothed_norm[k];
+        vec->_smoothed_norm[k] += alpha * diff;  // EMA: x += α·(target - x)
+
+        // No flip = both residuals strictly on the same side of zero
+        float last    = vec->_last_residual[k];
+        bool  no_flip = ((diff > 0.0f) & (last > 0.0f)) | ((diff < 0.0f) & (last < 0.0f));
+        sample[k]              = no_flip ? 0.0f : abs_f(diff);
+        vec->_last_residual[k] = diff;
+    }
+
+    if (vec->noise_model == SMOOTH_AXIS_VEC_NOISE_SHARED) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < vec->dims; k++) { sum += sample[k]; }
+        float shared = clamp_f_0_1(ema(vec->_noise_estimate_norm[0], sum / (float)vec->dims,
+                                       NOISE_SMOOTHING_RATE));
+        for (size_t k = 0; k < vec->dims; k++) { vec->_noise_estimate_norm[k] = shared; }
+    } else {
+        for (size_t k = 0; k < vec->dims; k++) {
+            vec->_noise_estimate_norm[k] = clamp_f_0_1(ema(vec->_noise_estimate_norm[k], sample[k],
+                                                           NOISE_SMOOTHING_RATE));
+        }
+    }
+    vec_output_refresh(vec);
+}
+
+
+
+// ============================================================================
+// Public API - Init
+// ============================================================================
+
+void smooth_axis_vec_init(smooth_axis_vec_t *vec,
+                          const smooth_axis_config_t *cfg,
+                          size_t dims,
+                          smooth_axis_vec_noise_t noise_model) {
+    SMOOTH_AXIS_CHECK_RETURN(vec != NULL, "vec is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(cfg != NULL, "config is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(dims > 0 && dims <= SMOOTH_AXIS_VEC_LANES,
+                             "vector dims out of range (see SMOOTH_AXIS_VEC_LANES)");
+    SMOOTH_AXIS_CHECK_RETURN(cfg->mode != SMOOTH_AXIS_MODE_AUTO_DT || cfg->now_ms != NULL,
+                             "AUTO mode requires now_ms function");
+
+    vec->cfg         = *cfg;
+    map_coeffs_init(&vec->cfg);  // Pick up feel edits made after smooth_axis_config_*()
+    vec->dims        = (uint8_t)dims;
+    vec->noise_model = noise_model;
+
+    smooth_axis_vec_reset(vec, NULL);
+    warmup_init(&vec->_warmup, cfg);
+    alpha_cache_init(&vec->_live_alpha);
+
+    SMOOTH_DEBUGF("vec init: mode=%s dims=%u noise=%s max_raw=%u settle_time=%.3fs",
+                  cfg->mode == SMOOTH_AXIS_MODE_AUTO_DT ? "AUTO_DT" : "LIVE_DT",
+                  (unsigned)dims,
+                  noise_model == SMOOTH_AXIS_VEC_NOISE_SHARED ? "shared" : "per-axis",
+                  cfg->max_raw,
+                  cfg->settle_time_sec);
+}
+
+void smooth_axis_vec_reset(smooth_axis_vec_t *vec, const uint16_t *raw) {
+    SMOOTH_AXIS_CHECK_RETURN(vec != NULL, "vec is NULL");
+
+    float norm[SMOOTH_AXIS_VEC_LANES] = { 0.0f };
+    if (raw) { vec_load_norm(vec, raw, norm); }
+
+    for (size_t k = 0; k < vec->dims && k < SMOOTH_AXIS_VEC_LANES; k++) {  // Lane bound for -O3 -Warray-bounds
+        vec->_smoothed_norm[k]       = norm[k];
+        vec->_noise_estimate_norm[k] = INITIAL_NOISE_NORM;
+        vec->_last_residual[k]       = 0.0f;
+        vec->_last_reported_norm[k]  = norm[k];
+    }
+    vec->_has_first_sample = raw != NULL;
+    vec_output_refresh(vec);
+}
+
+
+// ============================================================================
+// Public API - Update
+// ============================================================================
+
+void smooth_axis_vec_update_auto_dt(smooth_axis_vec_t *vec, const uint16_t *raw) {
+    SMOOTH_AXIS_CHECK_RETURN(vec != NULL, "vec is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(raw != NULL, "raw is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(vec->cfg.mode == SMOOTH_AXIS_MODE_AUTO_DT,
+                             "wrong mode: use vec_update_live_dt() for LIVE_DT mode");
+
+    (void)auto_dt_step(&vec->_warmup, &vec->cfg);  // One timebase for all components
+    vec_update_core(vec, raw, vec->_warmup._auto_alpha);
+}
+
+void smooth_axis_vec_update_live_dt(smooth_axis_vec_t *vec, const uint16_t *raw, float dt_sec) {
+    SMOOTH_AXIS_CHECK_RETURN(vec != NULL, "vec is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(raw != NULL, "raw is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(vec->cfg.mode == SMOOTH_AXIS_MODE_LIVE_DT,
+                             "wrong mode: use vec_update_auto_dt() for AUTO_DT mode");
+
+    (void)alpha_cache_refresh(&vec->_live_alpha, &vec->cfg, dt_sec);  // Once for all components
+    vec_update_core(vec, raw, vec->_live_alpha._alpha);
+}
+
+
+// ============================================================================
+// Public API - Output & Query
+// ============================================================================
+
+bool smooth_axis_vec_has_new_value(smooth_axis_vec_t *vec) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(vec != NULL, "vec is NULL", false);
+    if (!vec->_has_first_sample) { return false; }
+
+    bool any = false;
+    for (size_t k = 0; k < vec->dims; k++) {
+        float last = vec->_last_reported_norm[k];  // Decide on a copy: all or none are marked
+        any |= report_decide(&vec->cfg, vec->_out_norm[k], vec->_noise_estimate_norm[k], &last) >= REPORT_STICKY;
+    }
+    if (!any) { return false; }
+
+    for (size_t k = 0; k < vec->dims; k++) { vec->_last_reported_norm[k] = vec->_out_norm[k]; }
+    return true;
+}
+
+float smooth_axis_vec_get_norm(const smooth_axis_vec_t *vec, size_t k) {
+    if (!vec || k >= vec->dims) { return 0.0f; }
+
+    return vec->_out_norm[k];
+}
+
+uint16_t smooth_axis_vec_get_u16(const smooth_axis_vec_t *vec, size_t k) {
+    if (!vec || k >= vec->dims) { return 0; }
+
+    return output_u16(&vec->cfg, vec->_out_norm[k]);  // Mapped when read: updates skip the lroundf
+}
+
+float smooth_axis_vec_get_noise_norm(const smooth_axis_vec_t *vec, size_t k) {
+    if (!vec || k >= vec->dims) { return 0.0f; }
+
+    return vec->_noise_estimate_norm[k];
+}
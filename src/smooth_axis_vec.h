@@ -0,0 +1,142 @@
+/**
+ * @file smooth_axis_vec.h
+ * @brief 2D/3D/4D axes updated together with one report decision per vector
+ *
+ * @author Jonatan Vider
+ *
+ * A joystick or a 3-axis sensor read through two or three independent
+ * smooth_axis_t instances reports each component on its own, so one diagonal
+ * move arrives as two or three staggered reports. A vector axis smooths all
+ * components in one call and decides "new value" once per vector: when any
+ * component passes its report test, all components are reported together.
+ *
+ * Components share one config (max_raw, settle time, sticky zones, mode) and
+ * one timebase, so alpha and the AUTO_DT clock are computed once per vector.
+ * State is stored as component arrays (structure of arrays) and the
+ * per-component math has no branches, so the loops are vectorizer-friendly.
+ *
+ * Noise model (chosen at init):
+ *
+ *   SMOOTH_AXIS_VEC_NOISE_PER_AXIS  each component tracks its own noise and
+ *                                   threshold (same estimates as smooth_axis_t)
+ *   SMOOTH_AXIS_VEC_NOISE_SHARED    one estimate for the whole vector, fed the
+ *                                   mean of the component noise samples. For
+ *                                   channels that share an ADC and supply it is
+ *                                   steadier, and all components use one threshold
+ *
+ * Typical usage:
+ * @code
+ * smooth_axis_config_t cfg;
+ * smooth_axis_vec_t    stick;
+ *
+ * smooth_axis_config_live_dt(&cfg, 4095, 0.05f);
+ * smooth_axis_vec_init(&stick, &cfg, 2, SMOOTH_AXIS_VEC_NOISE_SHARED);
+ *
+ * uint16_t raw[2] = { read_adc(X_CH), read_adc(Y_CH) };
+ * smooth_axis_vec_update_live_dt(&stick, raw, dt_sec);
+ * if (smooth_axis_vec_has_new_value(&stick)) {
+ *     hid_report_stick(smooth_axis_vec_get_u16(&stick, 0), smooth_axis_vec_get_u16(&stick, 1));
+ * }
+ * @endcode
+ *
+ * @note Float arithmetic in every build (like smooth_axis_bank_t).
+ * @note cfg.idle_frames and cfg.decimation are smooth_axis_t features and are
+ *       ignored here.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "smooth_axis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Lane count of the vector state (components 0 .. dims-1 are used) */
+#define SMOOTH_AXIS_VEC_LANES 4
+
+/** @brief Noise/threshold model of a vector axis */
+typedef enum {
+  SMOOTH_AXIS_VEC_NOISE_PER_AXIS = 0,
+  SMOOTH_AXIS_VEC_NOISE_SHARED,
+} smooth_axis_vec_noise_t;
+
+/**
+ * @brief Runtime state for one vector axis
+ *
+ * Opaque structure - do not access fields directly.
+ * Initialize with smooth_axis_vec_init() after building config.
+ */
+typedef struct {
+  smooth_axis_config_t    cfg;
+  uint8_t                 dims;
+  smooth_axis_vec_noise_t noise_model;
+
+  // Internal runtime state (do not access directly), one lane per component
+  float    _smoothed_norm[SMOOTH_AXIS_VEC_LANES];
+  float    _noise_estimate_norm[SMOOTH_AXIS_VEC_LANES];  // SHARED: every component holds the estimate
+  float    _last_residual[SMOOTH_AXIS_VEC_LANES];
+  float    _last_reported_norm[SMOOTH_AXIS_VEC_LANES];
+  float    _out_norm[SMOOTH_AXIS_VEC_LANES];  // Post-sticky position, set by every update
+  bool     _has_first_sample;
+
+  smooth_axis_warmup_t      _warmup;      // AUTO_DT (one timebase per vector)
+  smooth_axis_alpha_cache_t _live_alpha;  // LIVE_DT
+} smooth_axis_vec_t;
+
+// ----------------------------------------------------------------------------
+// Init
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Initialize a vector axis of `dims` components from one config
+ *
+ * @param[out] vec         Vector state to initialize
+ * @param[in]  cfg         Config shared by all components (copied)
+ * @param[in]  dims        Number of components [1 .. SMOOTH_AXIS_VEC_LANES]
+ * @param[in]  noise_model Per-component or shared noise estimate
+ */
+void smooth_axis_vec_init(smooth_axis_vec_t *vec,
+                          const smooth_axis_config_t *cfg,
+                          size_t dims,
+                          smooth_axis_vec_noise_t noise_model);
+
+/** @brief Same as smooth_axis_reset(), raw[0 .. dims-1] (NULL = wait for the next sample) */
+void smooth_axis_vec_reset(smooth_axis_vec_t *vec, const uint16_t *raw);
+
+// ----------------------------------------------------------------------------
+// Update (raw[k] is component k, dims values)
+// ----------------------------------------------------------------------------
+
+/** @brief Same as smooth_axis_update_auto_dt() for all components */
+void smooth_axis_vec_update_auto_dt(smooth_axis_vec_t *vec, const uint16_t *raw);
+
+/** @brief Same as smooth_axis_update_live_dt() for all components */
+void smooth_axis_vec_update_live_dt(smooth_axis_vec_t *vec, const uint16_t *raw, float dt_sec);
+
+// ----------------------------------------------------------------------------
+// Output + change detection
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief One report decision for the whole vector
+ *
+ * True when any component passes the smooth_axis_has_new_value() test (outside
+ * the sub-LSB band, and in a sticky zone or above its noise threshold). All
+ * components are then marked reported, so read every component after a true.
+ */
+bool smooth_axis_vec_has_new_value(smooth_axis_vec_t *vec);
+
+/** @brief Component k as smooth_axis_get_norm(). Returns 0.0 if k is out of range. */
+float smooth_axis_vec_get_norm(const smooth_axis_vec_t *vec, size_t k);
+
+/** @brief Component k as smooth_axis_get_u16(). Returns 0 if k is out of range. */
+uint16_t smooth_axis_vec_get_u16(const smooth_axis_vec_t *vec, size_t k);
+
+/** @brief Noise estimate of component k (the shared estimate for every k when SHARED) */
+float smooth_axis_vec_get_noise_norm(const smooth_axis_vec_t *vec, size_t k);
+
+#ifdef __cplusplus
+}
+#endif
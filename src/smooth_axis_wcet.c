@@ -0,0 +1,171 @@
+/**
+ * @file smooth_axis_wcet.c
+ * @brief Implementation of the fixed-period constant-time axis
+ * @author Jonatan Vider
+ *
+ * See smooth_axis_wcet.h for API documentation.
+ */
+
+#include "smooth_axis_wcet.h"
+#include "smooth_axis_internal.h"
+#include <string.h>
+
+// ============================================================================
+// Branch-Free Pipeline
+// ============================================================================
+//
+// Each helper is its smooth_axis_internal.h counterpart with the early returns
+// turned into selects, so both sides of every decision are evaluated on every
+// sample. Selects go through bit masks rather than ?: because compilers are
+// free to (and on x86 do) turn a float ?: back into a branch.
+
+static inline uint32_t f_bits(float x) {
+    uint32_t u;
+    memcpy(&u, &x, sizeof u);
+    return u;
+}
+
+static inline float f_from_bits(uint32_t u) {
+    float x;
+    memcpy(&x, &u, sizeof x);
+    return x;
+}
+
+// c ? a : b
+static inline float select_f(bool c, float a, float b) {
+    uint32_t mask = 0u - (uint32_t)c;
+    return f_from_bits((f_bits(a) & mask) | (f_bits(b) & ~mask));
+}
+
+static inline uint32_t select_u32(bool c, uint32_t a, uint32_t b) {
+    uint32_t mask = 0u - (uint32_t)c;
+    return (a & mask) | (b & ~mask);
+}
+
+static inline float wcet_abs(float x) {
+    return f_from_bits(f_bits(x) & 0x7FFFFFFFu);
+}
+
+static inline float wcet_clamp(float x, float lo, float hi) {
+    return select_f(x < lo, lo, select_f(x > hi, hi, x));
+}
+
+// input_norm(): integer clip to max_raw, then the dead-zone map
+static inline float wcet_input_norm(const smooth_axis_config_t *cfg, uint16_t raw_value) {
+    uint16_t max_raw = cfg_max_raw(cfg);
+    uint16_t raw     = (uint16_t)select_u32(raw_value > max_raw, max_raw, raw_value);
+    return wcet_clamp((float)raw * cfg->_map._in_scale + cfg->_map._in_offset, 0.0f, 1.0f);
+}
+
+// apply_sticky_margins()
+static inline float wcet_sticky(const smooth_axis_config_t *cfg, float position) {
+    const smooth_axis_map_t *m = &cfg->_map;
+
+    float stretched = wcet_clamp(position * m->_sticky_gain - m->_sticky, 0.0f, 1.0f);
+    stretched       = select_f(position <= m->_sticky, 0.0f, stretched);
+    return select_f(position >= 1.0f - m->_sticky, 1.0f, stretched);
+}
+
+// output_u16(): round half up (n >= 0, so the cast truncates toward floor)
+static inline uint16_t wcet_u16(const smooth_axis_config_t *cfg, float n) {
+    uint16_t max_raw = cfg_max_raw(cfg);
+
+    uint32_t u16 = (uint32_t)(n * (float)max_raw + 0.5f);
+    u16          = select_u32(n <= cfg->_map._lsb_norm, 0, u16);
+    return (uint16_t)select_u32(n >= cfg->_map._top_norm, max_raw, u16);
+}
+
+// report_decide(): true when `current` is reported
+static inline bool wcet_report(const smooth_axis_config_t *cfg, float current, float noise_norm,
+                               float last_reported) {
+    float diff      = wcet_abs(current - last_reported);
+    float zone      = cfg_sticky_zone(cfg);
+    bool  in_sticky = (current < zone) | (current > 1 - zone);
+    float threshold = THRESHOLD_NOISE_MULTIPLIER * noise_norm * cfg->_threshold_attenuation;
+    bool  past      = diff > wcet_clamp(threshold, 0.0f, MAX_THRESH_U / CANONICAL_MAX);  // get_dynamic_threshold()
+    return would_change_output(cfg, diff) & (in_sticky | past);
+}
+
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void smooth_axis_wcet_init(smooth_axis_wcet_t *axis,
+                           const smooth_axis_config_t *cfg,
+                           float dt_sec,
+                           uint16_t raw_value) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(cfg != NULL, "config is NULL");
+    SMOOTH_AXIS_CHECK_RETURN(dt_sec > 0.0f, "wcet period must be > 0");
+
+    axis->cfg = *cfg;
+    map_coeffs_init(&axis->cfg);  // Pick up feel edits made after smooth_axis_config_*()
+    axis->_alpha = get_alpha_from_lut(&axis->cfg, dt_sec);  // Same alpha as LIVE_DT at this dt
+
+    smooth_axis_wcet_reset(axis, raw_value);
+
+    SMOOTH_DEBUGF("wcet init: max_raw=%u settle_time=%.3fs dt=%.6fs alpha=%.6f",
+                  cfg->max_raw,
+                  cfg->settle_time_sec,
+                  dt_sec,
+                  axis->_alpha);
+}
+
+void smooth_axis_wcet_reset(smooth_axis_wcet_t *axis, uint16_t raw_value) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+
+    float norm = wcet_input_norm(&axis->cfg, raw_value);
+
+    axis->_smoothed_norm       = norm;
+    axis->_noise_estimate_norm = INITIAL_NOISE_NORM;
+    axis->_last_residual       = 0.0f;
+    axis->_last_reported_norm  = norm;  // As smooth_axis_reset()
+    axis->_out_norm            = wcet_sticky(&axis->cfg, norm);
+    axis->_out_u16             = wcet_u16(&axis->cfg, axis->_out_norm);
+    axis->_pending             = false;
+}
+
+void smooth_axis_wcet_update(smooth_axis_wcet_t *axis, uint16_t raw_value) {
+    SMOOTH_AXIS_CHECK_RETURN(axis != NULL, "axis is NULL");
+    const smooth_axis_config_t *cfg = &axis->cfg;
+
+    // EMA: x += α·(target - x)
+    float diff = wcet_input_norm(cfg, raw_value) - axis->_smoothed_norm;
+    axis->_smoothed_norm += axis->_alpha * diff;
+
+    // noise_step(): no flip = both residuals strictly on the same side of zero
+    float last    = axis->_last_residual;
+    bool  no_flip = ((diff > 0.0f) & (last > 0.0f)) | ((diff < 0.0f) & (last < 0.0f));
+    float sample  = select_f(no_flip, 0.0f, wcet_abs(diff));
+    axis->_noise_estimate_norm = wcet_clamp(ema(axis->_noise_estimate_norm, sample, NOISE_SMOOTHING_RATE), 0.0f, 1.0f);
+    axis->_last_residual       = diff;
+
+    // Output + report decision (what has_new_value() would decide right now)
+    float out    = wcet_sticky(cfg, axis->_smoothed_norm);
+    bool  report = wcet_report(cfg, out, axis->_noise_estimate_norm, axis->_last_reported_norm);
+    axis->_out_norm           = out;
+    axis->_out_u16            = wcet_u16(cfg, out);
+    axis->_last_reported_norm = select_f(report, out, axis->_last_reported_norm);
+    axis->_pending           |= report;
+}
+
+bool smooth_axis_wcet_has_new_value(smooth_axis_wcet_t *axis) {
+    SMOOTH_AXIS_CHECK_RETURN_VAL(axis != NULL, "axis is NULL", false);
+
+    bool pending   = axis->_pending;
+    axis->_pending = false;
+    return pending;
+}
+
+float smooth_axis_wcet_get_norm(const smooth_axis_wcet_t *axis) {
+    return axis ? axis->_out_norm : 0.0f;
+}
+
+uint16_t smooth_axis_wcet_get_u16(const smooth_axis_wcet_t *axis) {
+    return axis ? axis->_out_u16 : 0;
+}
+
+float smooth_axis_wcet_get_noise_norm(const smooth_axis_wcet_t *axis) {
+    return axis ? axis->_noise_estimate_norm : 0.0f;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file smooth_axis_wcet.h
+ * @brief Fixed-period axis with a constant-time update (hard real-time loops)
+ *
+ * @author Jonatan Vider
+ *
+ * smooth_axis_t spends a data-dependent number of cycles per update: LIVE_DT
+ * re-derives alpha when dt changes (expf() outside the alpha table), AUTO_DT
+ * reads the timer and branches on warmup, the first sample takes its own path,
+ * and the output and report decision are computed on the first read after an
+ * update. That is fine for a UI loop, not for a motion-control loop budgeted by
+ * its worst case.
+ *
+ * A WCET axis fixes the loop period at init:
+ * - alpha is computed once in init (the only libm call); update() has no libm
+ *   calls and never reads a timer
+ * - the axis is seeded with a first sample in init, so update() never needs
+ *   the first-sample branch
+ * - every update runs the whole pipeline (EMA, noise estimate, sticky zones,
+ *   u16 mapping, report decision) with selects instead of branches, so after
+ *   init an update always executes the same instruction sequence; the getters
+ *   are plain loads
+ *
+ * Same filter and report decision as a LIVE_DT smooth_axis_t called at the same
+ * dt every frame: positions and noise are bit-exact. get_u16() rounds with
+ * +0.5 instead of lroundf(), which can differ by 1 LSB only on an exact .5 tie.
+ *
+ * Typical usage (1 kHz control loop):
+ * @code
+ * smooth_axis_config_t cfg;
+ * smooth_axis_wcet_t   pedal;
+ *
+ * smooth_axis_config_live_dt(&cfg, 4095, 0.02f);
+ * smooth_axis_wcet_init(&pedal, &cfg, 0.001f, read_adc());
+ *
+ * void control_isr(void) {
+ *     smooth_axis_wcet_update(&pedal, read_adc());
+ *     set_torque(smooth_axis_wcet_get_u16(&pedal));
+ * }
+ * @endcode
+ *
+ * @note Float arithmetic in every build (like smooth_axis_bank_t). The cycle
+ *       count is only constant on an FPU core (Cortex-M4F/M7, host): soft-float
+ *       routines take data-dependent paths.
+ * @note cfg.mode, now_ms, idle_frames and decimation are ignored: the period
+ *       given to init is the timebase.
+ */
+
+#pragma once
+
+#include "smooth_axis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Runtime state for one fixed-period axis
+ *
+ * Opaque structure - do not access fields directly.
+ * Initialize with smooth_axis_wcet_init() after building config.
+ */
+typedef struct {
+  smooth_axis_config_t cfg;
+
+  // Internal runtime state (do not access directly)
+  float    _alpha;               // EMA alpha at the init period
+  float    _smoothed_norm;
+  float    _noise_estimate_norm;
+  float    _last_residual;
+  float    _last_reported_norm;
+  float    _out_norm;            // Post-sticky position, set by every update
+  uint16_t _out_u16;             // _out_norm mapped to [0 .. max_raw]
+  bool     _pending;             // A report since the last has_new_value()
+} smooth_axis_wcet_t;
+
+/**
+ * @brief Initialize a fixed-period axis, seeded at a first sample
+ *
+ * @param[out] axis      Axis state to initialize
+ * @param[in]  cfg       Axis config (copied)
+ * @param[in]  dt_sec    Loop period in seconds (> 0), used by every update
+ * @param[in]  raw_value First raw sample: the axis starts settled here
+ */
+void smooth_axis_wcet_init(smooth_axis_wcet_t *axis,
+                           const smooth_axis_config_t *cfg,
+                           float dt_sec,
+                           uint16_t raw_value);
+
+/** @brief Re-seed at raw_value: clears the noise estimate and any pending report */
+void smooth_axis_wcet_reset(smooth_axis_wcet_t *axis, uint16_t raw_value);
+
+/**
+ * @brief One sample at the init period (constant time, no libm calls)
+ *
+ * Also makes the report decision: a report marks this position reported and
+ * latches has_new_value() until it is read.
+ */
+void smooth_axis_wcet_update(smooth_axis_wcet_t *axis, uint16_t raw_value);
+
+/** @brief True if any update since the last call reported (clears the latch) */
+bool smooth_axis_wcet_has_new_value(smooth_axis_wcet_t *axis);
+
+/** @brief Same as smooth_axis_get_norm() */
+float smooth_axis_wcet_get_norm(const smooth_axis_wcet_t *axis);
+
+/** @brief Same as smooth_axis_get_u16() */
+uint16_t smooth_axis_wcet_get_u16(const smooth_axis_wcet_t *axis);
+
+/** @brief Same as smooth_axis_get_noise_norm() */
+float smooth_axis_wcet_get_noise_norm(const smooth_axis_wcet_t *axis);
+
+#ifdef __cplusplus
+}
+#endif
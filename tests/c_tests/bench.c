@@ -0,0 +1,638 @@
+/**
+ * @file bench.c
+ * @brief Micro-benchmark for the smooth_axis update and query paths
+ *
+ * Measures cost per call of the hot-path functions (update_auto_dt,
+ * update_live_dt, has_new_value, get_u16, bank, shared-config, compile-time,
+ * vector and fixed-period WCET variants)
+ * for a single axis and for many axes, on clean and noisy input.
+ *
+ * Output is CSV on stdout (lines starting with '#' are comments):
+ *
+ *   build,case,input,axes,ops,ns_per_op,cycles_per_op
+ *
+ * `build` encodes checks (debug = asserts on, release = NDEBUG early-return
+ * guards, unchecked = SMOOTH_AXIS_CHECK_LEVEL 0) and math (float / q30), so
+ * runs of bench, bench_debug, bench_unchecked and bench_fixed can be
+ * concatenated and diffed between releases. Each row is the best of
+ * BENCH_REPEATS timed runs. cycles_per_op is -1 when no counter exists.
+ *
+ * Timebase:
+ *   - Host: clock_gettime(CLOCK_MONOTONIC) for ns, rdtsc for cycles (x86).
+ *     rdtsc ticks at the nominal TSC rate, not the boosted core clock.
+ *   - Cortex-M3/M4/M7/M33: DWT->CYCCNT for cycles, ns derived from
+ *     BENCH_CPU_HZ (define it to the core clock). Retarget printf first.
+ *   - Anything else: define BENCH_CYCLES() (and BENCH_CPU_HZ) yourself.
+ *
+ * A second block (comment lines "# spread,...") gives the per-call cycle
+ * min/max over one input pass for the scalar paths and the WCET axis.
+ *
+ * Usage:
+ *   ./build/bench            # Full run
+ *   ./build/bench --quick    # Short run (smoke test, noisy numbers)
+ */
+#if !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 199309L  // clock_gettime() under strict C99
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "smooth_axis.h"
+#include "smooth_axis_bank.h"
+#include "smooth_axis_shared.h"
+#include "smooth_axis_static.h"
+#include "smooth_axis_vec.h"
+#include "smooth_axis_wcet.h"
+#include "bench_timebase.h"
+
+// -----------------------------------------------------------------------------
+// Configuration
+// -----------------------------------------------------------------------------
+
+#define MAX_RAW        4095       // 12-bit ADC
+#define SETTLE_SEC     0.05f
+#define SETTLE_MS      50         // Same, for the compile-time axis
+#define DT_SEC         0.001f     // 1 kHz scan
+#define NUM_AXES       SMOOTH_AXIS_BANK_MAX_AXES
+#define NUM_SAMPLES    4096       // Pre-generated input stream (power of two)
+#define NOISE_LSB      12         // Peak noise amplitude on the noisy stream
+#define BENCH_REPEATS  5
+#define WARMUP_SCANS   512        // Twice the AUTO_DT warmup length
+
+#if SMOOTH_AXIS_CHECK_LEVEL == 0
+#define BUILD_CHECKS "unchecked"
+#elif SMOOTH_AXIS_CHECK_LEVEL == 1
+#define BUILD_CHECKS "release"
+#else
+#define BUILD_CHECKS "debug"
+#endif
+
+#if SMOOTH_AXIS_FIXED_POINT
+#define BUILD_MATH "q30"
+#else
+#define BUILD_MATH "float"
+#endif
+
+typedef enum {
+  INPUT_CLEAN,   // Slow triangle, no noise
+  INPUT_NOISY    // Same triangle + uniform noise (+/- NOISE_LSB)
+} input_kind_t;
+
+static const char *const INPUT_NAMES[] = { "clean", "noisy" };
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+
+static uint16_t samples[2][NUM_SAMPLES];
+static float    jitter_dt[NUM_SAMPLES];
+
+static smooth_axis_config_t     cfg_auto;
+static smooth_axis_config_t     cfg_live;
+static smooth_axis_t            axes[NUM_AXES];
+static smooth_axis_bank_t       bank;
+static smooth_axis_shared_cfg_t shared_cfg;
+static smooth_axis_shared_t     shared_axes[NUM_AXES];
+static uint16_t                 frame[NUM_AXES];
+
+SMOOTH_AXIS_STATIC_DEFINE(static_axis, MAX_RAW, SETTLE_MS, SMOOTH_AXIS_MODE_LIVE_DT, NULL)
+static static_axis_t static_ax;
+static smooth_axis_vec_t stick;
+static smooth_axis_wcet_t wcet_ax;
+
+static uint32_t fake_ms;            // AUTO_DT timer: advanced 1 ms per warmup scan
+static volatile uint32_t sink;      // Keeps query results observable
+static unsigned          iterations;
+
+static uint32_t bench_now_ms(void) {
+    return fake_ms;
+}
+
+static uint32_t lcg_next(uint32_t *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+static void generate_inputs(void) {
+    uint32_t rng = 12345u;
+    for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+        // Triangle between 10% and 90% of range, one period per buffer
+        uint32_t phase = i < NUM_SAMPLES / 2 ? i : NUM_SAMPLES - i;
+        int32_t  base  = (int32_t)(MAX_RAW / 10) + (int32_t)(phase * (MAX_RAW * 8 / 10) / (NUM_SAMPLES / 2));
+        int32_t  noisy = base + (int32_t)(lcg_next(&rng) % (2 * NOISE_LSB + 1)) - NOISE_LSB;
+
+        samples[INPUT_CLEAN][i] = (uint16_t)base;
+        samples[INPUT_NOISY][i] = (uint16_t)noisy;
+        jitter_dt[i]            = DT_SEC * (0.9f + 0.2f * (float)(lcg_next(&rng) & 0xFFFF) / 65535.0f);
+    }
+}
+
+// Per-axis phase offset so the axes of one frame are not identical
+static inline uint16_t sample_at(input_kind_t in, uint32_t t, size_t axis) {
+    return samples[in][(t + (uint32_t)axis * 97u) & (NUM_SAMPLES - 1)];
+}
+
+static void fill_frame(input_kind_t in, uint32_t t) {
+    for (size_t a = 0; a < NUM_AXES; a++) {
+        frame[a] = sample_at(in, t, a);
+    }
+}
+
+// Prime every filter (AUTO_DT warmup done) so only steady state is timed
+static void prepare_state(input_kind_t in) {
+    for (size_t a = 0; a < NUM_AXES; a++) {
+        smooth_axis_init(&axes[a], &cfg_auto);
+        smooth_axis_shared_init(&shared_axes[a], &shared_cfg);
+    }
+    smooth_axis_bank_init(&bank, &cfg_auto, NUM_AXES);
+
+    for (uint32_t t = 0; t < WARMUP_SCANS; t++) {
+        fake_ms = t + 1;  // 0 reads as "no timestamp yet"
+        fill_frame(in, t);
+        for (size_t a = 0; a < NUM_AXES; a++) {
+            smooth_axis_update_auto_dt(&axes[a], frame[a]);
+        }
+        smooth_axis_bank_update_auto_dt(&bank, frame, NUM_AXES);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Reporting
+// -----------------------------------------------------------------------------
+
+static void print_header(void) {
+    printf("# smooth_axis bench: %u iterations, best of %d\n", iterations, BENCH_REPEATS);
+    printf("build,case,input,axes,ops,ns_per_op,cycles_per_op\n");
+}
+
+static void report(const char *name, input_kind_t in, size_t n_axes,
+                   uint64_t ops, bench_stamp_t best) {
+    double ns_per_op     = (double)best.ns / (double)ops;
+    double cycles_per_op = BENCH_HAS_CYCLES ? (double)best.cycles / (double)ops : -1.0;
+    printf("%s-%s,%s,%s,%u,%llu,%.2f,%.2f\n",
+           BUILD_CHECKS, BUILD_MATH, name, INPUT_NAMES[in], (unsigned)n_axes,
+           (unsigned long long)ops, ns_per_op, cycles_per_op);
+}
+
+static void keep_best(bench_stamp_t *best, bench_stamp_t run, int rep) {
+    if (rep == 0 || run.ns < best->ns) { best->ns = run.ns; }
+    if (rep == 0 || run.cycles < best->cycles) { best->cycles = run.cycles; }
+}
+
+// -----------------------------------------------------------------------------
+// Single-axis cases (one axis, sequential samples)
+// -----------------------------------------------------------------------------
+
+static void bench_single(input_kind_t in) {
+    const uint16_t *s   = samples[in];
+    uint32_t        ops = iterations * NUM_SAMPLES;
+    bench_stamp_t   best = { 0, 0 }, run;
+
+    // update_auto_dt (post-warmup: fixed alpha)
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        prepare_state(in);
+        bench_stamp_t t0 = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                smooth_axis_update_auto_dt(&axes[0], s[i]);
+            }
+        }
+        run = bench_elapsed(t0);
+        keep_best(&best, run, rep);
+    }
+    sink += smooth_axis_get_u16(&axes[0]);
+    report("update_auto_dt", in, 1, ops, best);
+
+    // update_live_dt, constant dt (alpha cache hit)
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_init(&axes[0], &cfg_live);
+        bench_stamp_t t0 = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                smooth_axis_update_live_dt(&axes[0], s[i], DT_SEC);
+            }
+        }
+        run = bench_elapsed(t0);
+        keep_best(&best, run, rep);
+    }
+    sink += smooth_axis_get_u16(&axes[0]);
+    report("update_live_dt", in, 1, ops, best);
+
+    // update_live_dt, jittered dt (alpha recomputed every call)
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_init(&axes[0], &cfg_live);
+        bench_stamp_t t0 = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                smooth_axis_update_live_dt(&axes[0], s[i], jitter_dt[i]);
+            }
+        }
+        run = bench_elapsed(t0);
+        keep_best(&best, run, rep);
+    }
+    sink += smooth_axis_get_u16(&axes[0]);
+    report("update_live_dt_jitter", in, 1, ops, best);
+
+    // update_block over the whole buffer at a constant dt
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_init(&axes[0], &cfg_live);
+        bench_stamp_t t0 = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            smooth_axis_update_block(&axes[0], s, NUM_SAMPLES, DT_SEC);
+        }
+        run = bench_elapsed(t0);
+        keep_best(&best, run, rep);
+    }
+    sink += smooth_axis_get_u16(&axes[0]);
+    report("update_block", in, 1, ops, best);
+
+    // update_live_dt with the 32x oversampling front-end (ops = raw samples)
+    smooth_axis_config_t cfg_decim = cfg_live;
+    cfg_decim.decimation = 32;
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_init(&axes[0], &cfg_decim);
+        bench_stamp_t t0 = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                smooth_axis_update_live_dt(&axes[0], s[i], DT_SEC);
+            }
+        }
+        run = bench_elapsed(t0);
+        keep_best(&best, run, rep);
+    }
+    sink += smooth_axis_get_u16(&axes[0]);
+    report("update_live_dt_decim32", in, 1, ops, best);
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_init(&axes[0], &cfg_decim);
+        bench_stamp_t t0 = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            smooth_axis_update_block(&axes[0], s, NUM_SAMPLES, DT_SEC);
+        }
+        run = bench_elapsed(t0);
+        keep_best(&best, run, rep);
+    }
+    sink += smooth_axis_get_u16(&axes[0]);
+    report("update_block_decim32", in, 1, ops, best);
+
+    // Compile-time configured axis (smooth_axis_static.h), constant dt
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        static_axis_init(&static_ax);
+        bench_stamp_t t0 = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                static_axis_update_dt(&static_ax, s[i], DT_SEC);
+            }
+        }
+        run = bench_elapsed(t0);
+        keep_best(&best, run, rep);
+    }
+    sink += static_axis_get_u16(&static_ax);
+    report("static_update_dt", in, 1, ops, best);
+
+    // Typical poll loop: update + has_new_value + get_u16 on change
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_init(&axes[0], &cfg_live);
+        uint32_t      acc = 0;
+        bench_stamp_t t0  = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                smooth_axis_update_live_dt(&axes[0], s[i], DT_SEC);
+                if (smooth_axis_has_new_value(&axes[0])) {
+                    acc += smooth_axis_get_u16(&axes[0]);
+                }
+            }
+        }
+        run  = bench_elapsed(t0);
+        sink += acc;
+        keep_best(&best, run, rep);
+    }
+    report("poll_loop_live_dt", in, 1, ops, best);
+
+    // HID report: has_new_value + get_norm + get_u16 every update (output cache)
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_init(&axes[0], &cfg_live);
+        uint32_t      acc = 0;
+        float         pos = 0.0f;
+        bench_stamp_t t0  = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                smooth_axis_update_live_dt(&axes[0], s[i], DT_SEC);
+                acc += smooth_axis_has_new_value(&axes[0]);
+                pos += smooth_axis_get_norm(&axes[0]);
+                acc += smooth_axis_get_u16(&axes[0]);
+            }
+        }
+        run  = bench_elapsed(t0);
+        sink += acc + (uint32_t)pos;
+        keep_best(&best, run, rep);
+    }
+    report("hid_report_live_dt", in, 1, ops, best);
+
+    // Same loop on the fixed-period axis (output + decision made in update)
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_wcet_init(&wcet_ax, &cfg_live, DT_SEC, s[0]);
+        uint32_t      acc = 0;
+        float         pos = 0.0f;
+        bench_stamp_t t0  = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                smooth_axis_wcet_update(&wcet_ax, s[i]);
+                acc += smooth_axis_wcet_has_new_value(&wcet_ax);
+                pos += smooth_axis_wcet_get_norm(&wcet_ax);
+                acc += smooth_axis_wcet_get_u16(&wcet_ax);
+            }
+        }
+        run  = bench_elapsed(t0);
+        sink += acc + (uint32_t)pos;
+        keep_best(&best, run, rep);
+    }
+    report("hid_report_wcet", in, 1, ops, best);
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        static_axis_init(&static_ax);
+        uint32_t      acc = 0;
+        bench_stamp_t t0  = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                static_axis_update_dt(&static_ax, s[i], DT_SEC);
+                if (static_axis_has_new_value(&static_ax)) {
+                    acc += static_axis_get_u16(&static_ax);
+                }
+            }
+        }
+        run  = bench_elapsed(t0);
+        sink += acc;
+        keep_best(&best, run, rep);
+    }
+    report("static_poll_loop", in, 1, ops, best);
+
+    // 2D stick, one op = one (x, y) sample read out on report: two scalar
+    // axes vs one vector axis (y reads the buffer 97 samples later)
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_init(&axes[0], &cfg_live);
+        smooth_axis_init(&axes[1], &cfg_live);
+        uint32_t      acc = 0;
+        bench_stamp_t t0  = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                for (size_t k = 0; k < 2; k++) {
+                    smooth_axis_update_live_dt(&axes[k], sample_at(in, i, k), DT_SEC);
+                    if (smooth_axis_has_new_value(&axes[k])) {
+                        acc += smooth_axis_get_u16(&axes[k]);
+                    }
+                }
+            }
+        }
+        run  = bench_elapsed(t0);
+        sink += acc;
+        keep_best(&best, run, rep);
+    }
+    report("stick_2x_scalar", in, 2, ops, best);
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        smooth_axis_vec_init(&stick, &cfg_live, 2, SMOOTH_AXIS_VEC_NOISE_SHARED);
+        uint32_t      acc = 0;
+        bench_stamp_t t0  = bench_start();
+        for (unsigned it = 0; it < iterations; it++) {
+            for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+                uint16_t xy[2] = { sample_at(in, i, 0), sample_at(in, i, 1) };
+                smooth_axis_vec_update_live_dt(&stick, xy, DT_SEC);
+                if (smooth_axis_vec_has_new_value(&stick)) {
+                    acc += smooth_axis_vec_get_u16(&stick, 0) + smooth_axis_vec_get_u16(&stick, 1);
+                }
+            }
+        }
+        run  = bench_elapsed(t0);
+        sink += acc;
+        keep_best(&best, run, rep);
+    }
+    report("stick_vec2_shared", in, 2, ops, best);
+}
+
+// -----------------------------------------------------------------------------
+// Many-axis cases (one frame across NUM_AXES axes per scan)
+// -----------------------------------------------------------------------------
+
+static void bench_many(input_kind_t in) {
+    uint32_t      scans = iterations * 32u;
+    uint64_t      ops   = (uint64_t)scans * NUM_AXES;
+    bench_stamp_t best_auto = { 0, 0 }, best_live = { 0, 0 }, best_has_new = { 0, 0 };
+    bench_stamp_t best_u16 = { 0, 0 }, best_bank = { 0, 0 }, best_bank_u16 = { 0, 0 };
+    bench_stamp_t best_shared = { 0, 0 }, run;
+
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        bench_stamp_t acc_auto = { 0, 0 }, acc_has_new = { 0, 0 }, acc_u16 = { 0, 0 };
+        bench_stamp_t acc_bank = { 0, 0 }, acc_bank_u16 = { 0, 0 };
+        uint32_t      acc      = 0;
+
+        prepare_state(in);
+        for (uint32_t t = 0; t < scans; t++) {
+            fill_frame(in, t);  // Untimed: stands in for the ADC scan
+
+            bench_stamp_t t0 = bench_start();
+            for (size_t a = 0; a < NUM_AXES; a++) {
+                smooth_axis_update_auto_dt(&axes[a], frame[a]);
+            }
+            run = bench_elapsed(t0);
+            acc_auto.ns += run.ns;
+            acc_auto.cycles += run.cycles;
+
+            t0 = bench_start();
+            for (size_t a = 0; a < NUM_AXES; a++) {
+                acc += smooth_axis_has_new_value(&axes[a]) ? 1u : 0u;
+            }
+            run = bench_elapsed(t0);
+            acc_has_new.ns += run.ns;
+            acc_has_new.cycles += run.cycles;
+
+            t0 = bench_start();
+            for (size_t a = 0; a < NUM_AXES; a++) {
+                acc += smooth_axis_get_u16(&axes[a]);
+            }
+            run = bench_elapsed(t0);
+            acc_u16.ns += run.ns;
+            acc_u16.cycles += run.cycles;
+
+            t0 = bench_start();
+            smooth_axis_bank_update_auto_dt(&bank, frame, NUM_AXES);
+            run = bench_elapsed(t0);
+            acc_bank.ns += run.ns;
+            acc_bank.cycles += run.cycles;
+
+            t0 = bench_start();
+            for (size_t a = 0; a < NUM_AXES; a++) {
+                acc += smooth_axis_bank_get_u16(&bank, a);
+            }
+            run = bench_elapsed(t0);
+            acc_bank_u16.ns += run.ns;
+            acc_bank_u16.cycles += run.cycles;
+        }
+        sink += acc;
+        keep_best(&best_auto, acc_auto, rep);
+        keep_best(&best_has_new, acc_has_new, rep);
+        keep_best(&best_u16, acc_u16, rep);
+        keep_best(&best_bank, acc_bank, rep);
+        keep_best(&best_bank_u16, acc_bank_u16, rep);
+    }
+    report("update_auto_dt", in, NUM_AXES, ops, best_auto);
+    report("has_new_value", in, NUM_AXES, ops, best_has_new);
+    report("get_u16", in, NUM_AXES, ops, best_u16);
+    report("bank_update_auto_dt", in, NUM_AXES, ops, best_bank);
+    report("bank_get_u16", in, NUM_AXES, ops, best_bank_u16);
+
+    // LIVE_DT: copied config vs shared config
+    for (int rep = 0; rep < BENCH_REPEATS; rep++) {
+        bench_stamp_t acc_live = { 0, 0 }, acc_shared = { 0, 0 };
+
+        for (size_t a = 0; a < NUM_AXES; a++) {
+            smooth_axis_init(&axes[a], &cfg_live);
+            smooth_axis_shared_init(&shared_axes[a], &shared_cfg);
+        }
+        for (uint32_t t = 0; t < scans; t++) {
+            fill_frame(in, t);
+
+            bench_stamp_t t0 = bench_start();
+            for (size_t a = 0; a < NUM_AXES; a++) {
+                smooth_axis_update_live_dt(&axes[a], frame[a], DT_SEC);
+            }
+            run = bench_elapsed(t0);
+            acc_live.ns += run.ns;
+            acc_live.cycles += run.cycles;
+
+            t0 = bench_start();
+            for (size_t a = 0; a < NUM_AXES; a++) {
+                smooth_axis_shared_update_live_dt(&shared_axes[a], frame[a], DT_SEC);
+            }
+            run = bench_elapsed(t0);
+            acc_shared.ns += run.ns;
+            acc_shared.cycles += run.cycles;
+        }
+        sink += smooth_axis_get_u16(&axes[0]) + smooth_axis_shared_get_u16(&shared_axes[0]);
+        keep_best(&best_live, acc_live, rep);
+        keep_best(&best_shared, acc_shared, rep);
+    }
+    report("update_live_dt", in, NUM_AXES, ops, best_live);
+    report("shared_update_live_dt", in, NUM_AXES, ops, best_shared);
+}
+
+// -----------------------------------------------------------------------------
+// Per-call cycle spread (WCET)
+// -----------------------------------------------------------------------------
+//
+// Times every call of one pass over the input on its own and keeps, per sample,
+// the fastest of `iterations` identical passes (same state at every sample), so
+// interrupts and cache misses drop out and what is left is data-dependent cost.
+// The spread (max - min over the pass) is the number a WCET budget cares about.
+// The counter read pair's own cost is subtracted. Host numbers include out-of-
+// order noise; on Cortex-M4/M7 DWT->CYCCNT gives the exact figures.
+
+typedef enum {
+  SPREAD_LIVE_DT,  // smooth_axis_t, jittered dt: alpha re-derived per call
+  SPREAD_AUTO_DT,  // smooth_axis_t from init: first sample, warmup, timer reads
+  SPREAD_WCET,     // smooth_axis_wcet_t at the fixed period
+} spread_case_t;
+
+static const char *const SPREAD_NAMES[] = { "live_dt_jitter+poll", "auto_dt_from_init+poll", "wcet_update+poll" };
+
+static uint32_t call_cycles[NUM_SAMPLES];
+
+static uint32_t cycles_between(uint64_t c0, uint64_t c1) {
+#if defined(BENCH_CYCLES_WRAP32)
+    return (uint32_t)c1 - (uint32_t)c0;
+#else
+    return (uint32_t)(c1 - c0);
+#endif
+}
+
+static uint32_t counter_overhead(void) {
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t c0 = BENCH_CYCLES_SERIAL();
+        uint64_t c1 = BENCH_CYCLES_SERIAL();
+        uint32_t d  = cycles_between(c0, c1);
+        best        = d < best ? d : best;
+    }
+    return best;
+}
+
+static void bench_spread_case(spread_case_t sc, input_kind_t in, uint32_t overhead) {
+    const uint16_t *s   = samples[in];
+    uint32_t        acc = 0;
+
+    for (unsigned pass = 0; pass < iterations; pass++) {
+        fake_ms = 0;
+        smooth_axis_init(&axes[0], sc == SPREAD_AUTO_DT ? &cfg_auto : &cfg_live);
+        smooth_axis_wcet_init(&wcet_ax, &cfg_live, DT_SEC, s[0]);
+
+        for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+            fake_ms++;
+            uint64_t c0 = BENCH_CYCLES_SERIAL();
+            if (sc == SPREAD_WCET) {
+                smooth_axis_wcet_update(&wcet_ax, s[i]);
+                if (smooth_axis_wcet_has_new_value(&wcet_ax)) { acc += smooth_axis_wcet_get_u16(&wcet_ax); }
+            } else {
+                if (sc == SPREAD_AUTO_DT) {
+                    smooth_axis_update_auto_dt(&axes[0], s[i]);
+                } else {
+                    smooth_axis_update_live_dt(&axes[0], s[i], jitter_dt[i]);
+                }
+                if (smooth_axis_has_new_value(&axes[0])) { acc += smooth_axis_get_u16(&axes[0]); }
+            }
+            uint32_t d = cycles_between(c0, BENCH_CYCLES_SERIAL());
+            d          = d > overhead ? d - overhead : 0;
+            if (pass == 0 || d < call_cycles[i]) { call_cycles[i] = d; }
+        }
+    }
+    sink += acc;
+
+    uint32_t lo = UINT32_MAX, hi = 0;
+    for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+        lo = call_cycles[i] < lo ? call_cycles[i] : lo;
+        hi = call_cycles[i] > hi ? call_cycles[i] : hi;
+    }
+    printf("# spread,%s-%s,%s,%s,%u,%u,%u\n", BUILD_CHECKS, BUILD_MATH, SPREAD_NAMES[sc], INPUT_NAMES[in],
+           (unsigned)lo, (unsigned)hi, (unsigned)(hi - lo));
+}
+
+static void bench_spread(void) {
+    if (!BENCH_HAS_CYCLES) {
+        printf("# spread: no cycle counter\n");
+        return;
+    }
+    uint32_t overhead = counter_overhead();
+    printf("# spread,build,case,input,min_cycles,max_cycles,spread_cycles (counter overhead %u)\n",
+           (unsigned)overhead);
+    for (int in = INPUT_CLEAN; in <= INPUT_NOISY; in++) {
+        for (int sc = SPREAD_LIVE_DT; sc <= SPREAD_WCET; sc++) {
+            bench_spread_case((spread_case_t)sc, (input_kind_t)in, overhead);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Main
+// -----------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    iterations = (argc > 1 && strcmp(argv[1], "--quick") == 0) ? 2u : 64u;
+
+    bench_cycles_init();
+    generate_inputs();
+
+    smooth_axis_config_auto_dt(&cfg_auto, MAX_RAW, SETTLE_SEC, bench_now_ms);
+    smooth_axis_config_live_dt(&cfg_live, MAX_RAW, SETTLE_SEC);
+    smooth_axis_shared_cfg_init(&shared_cfg, &cfg_live);
+
+    print_header();
+    for (int in = INPUT_CLEAN; in <= INPUT_NOISY; in++) {
+        bench_single((input_kind_t)in);
+        bench_many((input_kind_t)in);
+    }
+    bench_spread();
+    printf("# sink=%u\n", (unsigned)sink);  // Defeats dead-code elimination
+
+    return 0;
+}
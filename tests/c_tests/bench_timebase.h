@@ -0,0 +1,104 @@
+/**
+ * @file bench_timebase.h
+ * @brief Cycle counter and clock shared by the benchmark programs
+ * @author Jonatan Vider
+ *
+ * Used by bench.c and footprint.c (see bench.c for the platform list):
+ *   - bench_cycles_init() once, then bench_start() / bench_elapsed() around a
+ *     timed run for wall-clock ns and cycles
+ *   - BENCH_CYCLES_SERIAL() for single-call timing (fenced on x86)
+ *
+ * Define BENCH_CYCLES() (and BENCH_CPU_HZ) before including to target a core
+ * the header does not know.
+ */
+#pragma once
+
+#if !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 199309L  // clock_gettime() under strict C99 (include first)
+#endif
+
+#include <stdint.h>
+
+
+#if defined(BENCH_CYCLES)
+// User-supplied cycle counter
+#define BENCH_HAS_CYCLES 1
+static void bench_cycles_init(void) {}
+
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+// Cortex-M with DWT: enable trace (DEMCR.TRCENA), then the cycle counter
+#define BENCH_DEMCR      (*(volatile uint32_t *)0xE000EDFCu)
+#define BENCH_DWT_CTRL   (*(volatile uint32_t *)0xE0001000u)
+#define BENCH_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004u)
+#define BENCH_CYCLES()   ((uint64_t)BENCH_DWT_CYCCNT)
+#define BENCH_HAS_CYCLES 1
+#define BENCH_CYCLES_WRAP32 1  // 32-bit counter: timed runs must stay below 2^32 cycles
+
+static void bench_cycles_init(void) {
+    BENCH_DEMCR     |= (1u << 24);
+    BENCH_DWT_CYCCNT = 0;
+    BENCH_DWT_CTRL  |= 1u;
+}
+
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES()   ((uint64_t)__rdtsc())
+#define BENCH_HAS_CYCLES 1
+// lfence on both sides: single calls are timed without out-of-order overlap
+#define BENCH_CYCLES_SERIAL() (_mm_lfence(), bench_rdtsc_fenced())
+static inline uint64_t bench_rdtsc_fenced(void) {
+    uint64_t c = (uint64_t)__rdtsc();
+    _mm_lfence();
+    return c;
+}
+static void bench_cycles_init(void) {}
+
+#else
+#define BENCH_CYCLES()   ((uint64_t)0)
+#define BENCH_HAS_CYCLES 0
+static void bench_cycles_init(void) {}
+#endif
+
+#if !defined(BENCH_CYCLES_SERIAL)
+#define BENCH_CYCLES_SERIAL() BENCH_CYCLES()  // In-order cores: plain counter reads
+#endif
+
+#if defined(BENCH_CPU_HZ)
+// ns from the cycle counter (bare metal, no OS clock)
+static uint64_t bench_now_ns(void) {
+    return (uint64_t)((double)BENCH_CYCLES() * 1e9 / (double)BENCH_CPU_HZ);
+}
+#elif defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#else
+#error "bench: no clock - define BENCH_CYCLES() and BENCH_CPU_HZ"
+#endif
+
+typedef struct {
+  uint64_t ns;
+  uint64_t cycles;
+} bench_stamp_t;
+
+static inline bench_stamp_t bench_start(void) {
+    bench_stamp_t s;
+    s.ns     = bench_now_ns();
+    s.cycles = BENCH_CYCLES();
+    return s;
+}
+
+static inline bench_stamp_t bench_elapsed(bench_stamp_t start) {
+    bench_stamp_t e;
+    e.cycles = BENCH_CYCLES();
+    e.ns     = bench_now_ns() - start.ns;
+#if defined(BENCH_CYCLES_WRAP32)
+    e.cycles = (uint32_t)((uint32_t)e.cycles - (uint32_t)start.cycles);
+#else
+    e.cycles = e.cycles - start.cycles;
+#endif
+    return e;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file footprint.c
+ * @brief Per-function cycle cost of one build profile (see SMOOTH_AXIS_PROFILE)
+ *
+ * Built once per profile against the library compiled the same way (CMake
+ * footprint_full / footprint_size / footprint_speed, `make footprint`). The
+ * footprint target prints `size` (.text/.data/.bss) of each profile's library
+ * objects next to this program's output, so flash and speed are read off
+ * one report.
+ *
+ * Output is CSV on stdout (lines starting with '#' are comments):
+ *
+ *   profile,function,ns_per_call,cycles_per_call
+ *
+ * Functions the profile compiles out are listed as comments instead of rows.
+ * Each row is the best of FOOTPRINT_REPEATS timed runs over a noisy triangle;
+ * timebase as in bench.c (bench_timebase.h).
+ *
+ * Usage:
+ *   ./build/footprint_size            # Full run
+ *   ./build/footprint_size --quick    # Short run (smoke test, noisy numbers)
+ */
+#include "bench_timebase.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "smooth_axis.h"
+#include "smooth_axis_debug.h"  // SMOOTH_AXIS_CHECK_LEVEL, for the header line
+
+// -----------------------------------------------------------------------------
+// Configuration
+// -----------------------------------------------------------------------------
+
+#define MAX_RAW           4095
+#define SETTLE_SEC        0.05f
+#define DT_SEC            0.001f
+#define NUM_SAMPLES       4096   // Power of two
+#define NOISE_LSB         12
+#define FOOTPRINT_REPEATS 5
+#define WARMUP_UPDATES    512    // Past the AUTO_DT warmup
+
+#if SMOOTH_AXIS_PROFILE == SMOOTH_AXIS_PROFILE_SIZE
+#define PROFILE_NAME "size"
+#elif SMOOTH_AXIS_PROFILE == SMOOTH_AXIS_PROFILE_SPEED
+#define PROFILE_NAME "speed"
+#else
+#define PROFILE_NAME "full"
+#endif
+
+#if SMOOTH_AXIS_FIXED_POINT
+#define PROFILE_MATH "q30"
+#else
+#define PROFILE_MATH "float"
+#endif
+
+typedef enum {
+  FN_UPDATE_AUTO_DT,
+  FN_POLL_AUTO_DT,     // update + has_new_value + get_u16 (the usual loop body)
+  FN_UPDATE_LIVE_DT,
+  FN_POLL_LIVE_DT,
+  FN_GET_NOISE_NORM,
+} fn_t;
+
+static const char *const FN_NAMES[] = {
+  "update_auto_dt", "update_auto_dt+poll", "update_live_dt", "update_live_dt+poll", "get_noise_norm",
+};
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+
+static uint16_t          samples[NUM_SAMPLES];
+static smooth_axis_t     axis;
+static uint32_t          fake_ms;
+static volatile uint32_t sink;
+static unsigned          iterations;
+
+static uint32_t footprint_now_ms(void) {
+    return fake_ms;
+}
+
+static void generate_inputs(void) {
+    uint32_t rng = 12345u;
+    for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+        rng            = rng * 1664525u + 1013904223u;
+        uint32_t phase = i < NUM_SAMPLES / 2 ? i : NUM_SAMPLES - i;
+        int32_t  base  = (int32_t)(MAX_RAW / 10) + (int32_t)(phase * (MAX_RAW * 8 / 10) / (NUM_SAMPLES / 2));
+        samples[i]     = (uint16_t)(base + (int32_t)((rng >> 8) % (2 * NOISE_LSB + 1)) - NOISE_LSB);
+    }
+}
+
+// Fresh axis in the function's mode, past warmup
+static void prepare_axis(fn_t fn) {
+    smooth_axis_config_t cfg;
+#if SMOOTH_AXIS_ENABLE_LIVE_DT
+    if (fn == FN_UPDATE_LIVE_DT || fn == FN_POLL_LIVE_DT) {
+        smooth_axis_config_live_dt(&cfg, MAX_RAW, SETTLE_SEC);
+        smooth_axis_init(&axis, &cfg);
+        for (uint32_t i = 0; i < WARMUP_UPDATES; i++) { smooth_axis_update_live_dt(&axis, samples[i], DT_SEC); }
+        return;
+    }
+#endif
+    (void)fn;
+    smooth_axis_config_auto_dt(&cfg, MAX_RAW, SETTLE_SEC, footprint_now_ms);
+    smooth_axis_init(&axis, &cfg);
+    for (uint32_t i = 0; i < WARMUP_UPDATES; i++) {
+        fake_ms++;
+        smooth_axis_update_auto_dt(&axis, samples[i]);
+    }
+}
+
+// One timed run: `iterations` passes over the input
+static bench_stamp_t run_fn(fn_t fn) {
+    uint32_t      acc = 0;
+    float         pos = 0.0f;
+    bench_stamp_t t0  = bench_start();
+    for (unsigned it = 0; it < iterations; it++) {
+        for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+            switch (fn) {
+            case FN_UPDATE_AUTO_DT:
+                smooth_axis_update_auto_dt(&axis, samples[i]);
+                break;
+            case FN_POLL_AUTO_DT:
+                smooth_axis_update_auto_dt(&axis, samples[i]);
+                if (smooth_axis_has_new_value(&axis)) { acc += smooth_axis_get_u16(&axis); }
+                break;
+#if SMOOTH_AXIS_ENABLE_LIVE_DT
+            case FN_UPDATE_LIVE_DT:
+                smooth_axis_update_live_dt(&axis, samples[i], DT_SEC);
+                break;
+            case FN_POLL_LIVE_DT:
+                smooth_axis_update_live_dt(&axis, samples[i], DT_SEC);
+                if (smooth_axis_has_new_value(&axis)) { acc += smooth_axis_get_u16(&axis); }
+                break;
+#endif
+#if SMOOTH_AXIS_ENABLE_DIAGNOSTICS
+            case FN_GET_NOISE_NORM:
+                pos += smooth_axis_get_noise_norm(&axis);
+                break;
+#endif
+            default:
+                break;
+            }
+        }
+    }
+    bench_stamp_t run = bench_elapsed(t0);
+    sink += acc + (uint32_t)pos + smooth_axis_get_u16(&axis);
+    return run;
+}
+
+static bool fn_compiled(fn_t fn) {
+    switch (fn) {
+    case FN_UPDATE_LIVE_DT:
+    case FN_POLL_LIVE_DT:   return SMOOTH_AXIS_ENABLE_LIVE_DT;
+    case FN_GET_NOISE_NORM: return SMOOTH_AXIS_ENABLE_DIAGNOSTICS;
+    default:                return true;
+    }
+}
+
+static void report_fn(fn_t fn) {
+    if (!fn_compiled(fn)) {
+        printf("# %s-%s,%s compiled out\n", PROFILE_NAME, PROFILE_MATH, FN_NAMES[fn]);
+        return;
+    }
+    bench_stamp_t best = { 0, 0 };
+    for (int rep = 0; rep < FOOTPRINT_REPEATS; rep++) {
+        prepare_axis(fn);
+        bench_stamp_t run = run_fn(fn);
+        if (rep == 0 || run.ns < best.ns) { best.ns = run.ns; }
+        if (rep == 0 || run.cycles < best.cycles) { best.cycles = run.cycles; }
+    }
+    double calls = (double)iterations * NUM_SAMPLES;
+    printf("%s-%s,%s,%.2f,%.2f\n", PROFILE_NAME, PROFILE_MATH, FN_NAMES[fn], (double)best.ns / calls,
+           BENCH_HAS_CYCLES ? (double)best.cycles / calls : -1.0);
+}
+
+int main(int argc, char **argv) {
+    iterations = (argc > 1 && strcmp(argv[1], "--quick") == 0) ? 2u : 64u;
+
+    bench_cycles_init();
+    generate_inputs();
+
+    printf("# smooth_axis footprint: profile=%s live_dt=%d dead_zones=%d sticky=%d diagnostics=%d "
+           "alpha_lut=%d checks=%d\n",
+           PROFILE_NAME, SMOOTH_AXIS_ENABLE_LIVE_DT, SMOOTH_AXIS_ENABLE_DEAD_ZONES, SMOOTH_AXIS_ENABLE_STICKY,
+           SMOOTH_AXIS_ENABLE_DIAGNOSTICS, SMOOTH_AXIS_ALPHA_LUT_SIZE, SMOOTH_AXIS_CHECK_LEVEL);
+    printf("profile,function,ns_per_call,cycles_per_call\n");
+    for (int fn = FN_UPDATE_AUTO_DT; fn <= FN_GET_NOISE_NORM; fn++) {
+        report_fn((fn_t)fn);
+    }
+    printf("# sink=%u\n", (unsigned)sink);  // Defeats dead-code elimination
+
+    return 0;
+}
@@ -6,6 +6,12 @@
 #include <sys/stat.h>
 
 #include "smooth_axis.h"
+#include "smooth_axis_compact.h"
+#include "trace_writer.h"
+
+#ifndef M_PI  // Not provided by strict C99 <math.h>
+#define M_PI 3.14159265358979323846
+#endif
 
 
 // -----------------------------------------------------------------------------
@@ -36,6 +42,28 @@ static const env_profile_t ENV_PROFILES[] = {
 
 static const float SETTLE_TIMES[] = { 0.05f, 0.10f, 0.20f, 0.50f, 1.00f };
 
+// One record per update (22 bytes; see trace_writer.h for the file layout)
+static const trace_column_t TRACE_COLUMNS[] = {
+        { "t_sec",       TRACE_F32, "%.6f" },
+        { "dt_sec",      TRACE_F32, "%.6f" },
+        { "raw_base",    TRACE_U16, "%u"   },
+        { "raw_noisy",   TRACE_U16, "%u"   },
+        { "has_new",     TRACE_U8,  "%u"   },
+        { "out_u16",     TRACE_U16, "%u"   },
+        { "noise_norm",  TRACE_F32, "%.6f" },
+        { "thresh_norm", TRACE_F32, "%.6f" },
+};
+#define NUM_TRACE_COLUMNS (sizeof(TRACE_COLUMNS) / sizeof(TRACE_COLUMNS[0]))
+
+static trace_writer_t trace;  // 64 KB write buffer, reused for every run
+
+// Compact-state shadow axis vs the float axis, same samples (not traced)
+typedef struct {
+  uint16_t max_u16_diff;      // Max |get_u16()| difference
+  uint32_t updates[2];        // has_new_value() events: float, compact
+  uint32_t false_updates[2];  // Declared value moving down (the ramp only rises)
+} compact_stats_t;
+
 
 
 // Check if running from project root
@@ -108,14 +136,23 @@ static uint16_t get_clean_raw(float t) {
 // Core Logic: Run & Dump
 // -----------------------------------------------------------------------------
 
-void run_test_and_dump(const env_profile_t *env, float settle_time, uint32_t seed) {
-    char filename[256];
-    snprintf(filename, sizeof(filename),
-             "%s/smooth_axis_%ubit_settle_time_%.4f_dt=%.4f_jit=%.4f_noise=%.4f_ramp_102_to_921.csv",
+compact_stats_t run_test_and_dump(const env_profile_t *env, float settle_time, uint32_t seed, bool csv) {
+    compact_stats_t stats = { 0 };
+
+    char stem[256];
+    snprintf(stem, sizeof(stem),
+             "%s/smooth_axis_%ubit_settle_time_%.4f_dt=%.4f_jit=%.4f_noise=%.4f_ramp_102_to_921",
              OUTPUT_DIR, MAX_RAW, settle_time, BASE_DT_SEC, env->jitter_frac, env->noise_frac);
-    
-    FILE *f = fopen(filename, "w");
-    if (!f) { perror("Failed to open file"); return; }
+
+    char bin_path[272];
+    char csv_path[272];
+    snprintf(bin_path, sizeof(bin_path), "%s.bin", stem);
+    snprintf(csv_path, sizeof(csv_path), "%s.csv", stem);
+
+    if (!trace_open(&trace, bin_path, csv ? csv_path : NULL, TRACE_COLUMNS, NUM_TRACE_COLUMNS)) {
+        perror("Failed to open trace file");
+        return stats;
+    }
     
     smooth_axis_config_t cfg;
     smooth_axis_config_live_dt(&cfg, MAX_RAW, settle_time);
@@ -123,10 +160,14 @@ void run_test_and_dump(const env_profile_t *env, float settle_time, uint32_t see
     smooth_axis_t axis;
     smooth_axis_init(&axis, &cfg);
     
-    fprintf(f, "t_sec,dt_sec,raw_base,raw_noisy,has_new,out_u16,noise_norm,thresh_norm\n");
+    smooth_axis_shared_cfg_t shared;
+    smooth_axis_compact_t    compact;
+    smooth_axis_shared_cfg_init(&shared, &cfg);
+    smooth_axis_compact_init(&compact, 1);
     
     float t = 0.0f;
     uint16_t last_out = 0;
+    uint16_t compact_out = 0;
     int steps = (int)(TOTAL_DURATION_SEC / BASE_DT_SEC);
     
     for (int i = 0; i < steps; ++i) {
@@ -152,29 +193,63 @@ void run_test_and_dump(const env_profile_t *env, float settle_time, uint32_t see
         }
         
         smooth_axis_update_live_dt(&axis, noisy_raw, dt);
+        smooth_axis_compact_update_live_dt(&compact, &shared, noisy_raw, dt);
         
         int has_new = 0;
         if (smooth_axis_has_new_value(&axis)) {
-            last_out = smooth_axis_get_u16(&axis);
+            uint16_t out = smooth_axis_get_u16(&axis);
+            stats.updates[0]++;
+            stats.false_updates[0] += (uint32_t)(stats.updates[0] > 1 && out < last_out);
+            last_out = out;
             has_new = 1;
         }
+        if (smooth_axis_compact_has_new_value(&compact, &shared)) {
+            uint16_t out = smooth_axis_compact_get_u16(&compact, &shared);
+            stats.updates[1]++;
+            stats.false_updates[1] += (uint32_t)(stats.updates[1] > 1 && out < compact_out);
+            compact_out = out;
+        }
+        
+        uint16_t live_f = smooth_axis_get_u16(&axis);
+        uint16_t live_c = smooth_axis_compact_get_u16(&compact, &shared);
+        uint16_t diff   = (uint16_t)(live_f > live_c ? live_f - live_c : live_c - live_f);
+        if (diff > stats.max_u16_diff) { stats.max_u16_diff = diff; }
         
-        fprintf(f, "%.6f,%.6f,%u,%u,%d,%u,%.6f,%.6f\n",
-                t, dt, clean_raw, noisy_raw, has_new, last_out,
-                smooth_axis_get_noise_norm(&axis),
-                smooth_axis_get_effective_thresh_norm(&axis));
+        trace_put_f32(&trace, t);
+        trace_put_f32(&trace, dt);
+        trace_put_u16(&trace, clean_raw);
+        trace_put_u16(&trace, noisy_raw);
+        trace_put_u8(&trace, (uint8_t)has_new);
+        trace_put_u16(&trace, last_out);
+        trace_put_f32(&trace, smooth_axis_get_noise_norm(&axis));
+        trace_put_f32(&trace, smooth_axis_get_effective_thresh_norm(&axis));
+        trace_end_record(&trace);
         
         t += dt;
     }
     
-    fclose(f);
+    if (!trace_close(&trace)) {
+        fprintf(stderr, "ERROR: Failed writing %s\n", bin_path);
+    }
+    return stats;
 }
 
 // -----------------------------------------------------------------------------
 // Entry Point
 // -----------------------------------------------------------------------------
 
-int main(void) {
+int main(int argc, char **argv) {
+    // --csv: also export every trace as CSV (the .bin traces are always written)
+    bool csv = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--csv]\n", argv[0]);
+            return 1;
+        }
+    }
+
     // Validate we're in the right place
     if (!validate_working_directory()) {
         return 1;
@@ -190,13 +265,18 @@ int main(void) {
     size_t st_count  = sizeof(SETTLE_TIMES) / sizeof(SETTLE_TIMES[0]);
     
     printf("Running ramp response tests...\n");
+    printf("Compact state (8 bytes) vs float, updates and false updates as float / compact:\n");
     
     for (size_t ei = 0; ei < env_count; ++ei) {
         for (size_t ti = 0; ti < st_count; ++ti) {
             // Deterministic seed for reproducibility
             uint32_t seed = (uint32_t)(1000u + ei * 100u + ti * 7u);
             
-            run_test_and_dump(&ENV_PROFILES[ei], SETTLE_TIMES[ti], seed);
+            compact_stats_t st = run_test_and_dump(&ENV_PROFILES[ei], SETTLE_TIMES[ti], seed, csv);
+            printf("  %-8s %5.0fms: max |du16| %3u, updates %5u / %5u, false %4u / %4u\n",
+                   ENV_PROFILES[ei].name, SETTLE_TIMES[ti] * 1000.0f, (unsigned)st.max_u16_diff,
+                   (unsigned)st.updates[0], (unsigned)st.updates[1],
+                   (unsigned)st.false_updates[0], (unsigned)st.false_updates[1]);
         }
     }
     
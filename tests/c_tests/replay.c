@@ -0,0 +1,731 @@
+/**
+ * @file replay.c
+ * @brief Offline replay of recorded sensor captures through smooth_axis, as fast as possible
+ * @author Jonatan Vider
+ *
+ * Memory-maps a capture and pushes every sample through
+ * smooth_axis_update_live_dt() (one smooth_axis_t per channel) or through a
+ * LIVE_DT bank (smooth_axis_bank_update_axis_live_dt()), back to back, not in
+ * simulated real time. Only summary metrics and report events come out, so a
+ * new library version can be regression-tested against production captures
+ * and its throughput read off in samples/sec.
+ *
+ * Capture format: a trace file (layout in trace_writer.h) with the columns
+ *
+ *   raw      u2   ADC reading (--raw-col picks another u2 column, e.g. raw_noisy)
+ *   t_us     u4   Timestamp in microseconds (wraps), dt per channel from deltas
+ *     or
+ *   dt_sec   f4   Time since the previous record
+ *   channel  u1/u2 (optional) Channel index, records of all channels interleaved
+ *
+ * so ramp_test traces replay directly (dt_sec + raw_noisy).
+ *
+ * Reported events are folded, in record order, into a 64-bit digest of
+ * (record index, channel, out_u16). Two runs agree on every report exactly
+ * when their digests match. --events STEM also writes them as a trace
+ * (STEM.bin, plus STEM.csv with --csv).
+ *
+ * Usage:
+ *   ./build/replay capture.bin [--api axis|bank] [--settle SEC] [--max-raw N]
+ *                              [--raw-col NAME] [--repeat N] [--events STEM [--csv]]
+ *   ./build/replay --quick     # Synthetic capture, replay must match a direct run and a
+ *                              # column past the record end must be rejected (ctest)
+ */
+#define _POSIX_C_SOURCE 200809L  // mmap(), posix_madvise(), clock_gettime() under strict C99
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "smooth_axis.h"
+#include "smooth_axis_bank.h"
+#include "trace_writer.h"
+
+#ifndef M_PI  // Not provided by strict C99 <math.h>
+#define M_PI 3.14159265358979323846
+#endif
+
+#define QUICK_DIR      "tests/data/replay_files"
+#define QUICK_CAPTURE  QUICK_DIR "/quick_capture.bin"
+#define QUICK_CHANNELS 8
+#define QUICK_SCANS    25000
+
+#define DIGEST_INIT  0xcbf29ce484222325ull  // FNV-1a 64 offset basis
+#define DIGEST_PRIME 0x100000001b3ull
+
+// -----------------------------------------------------------------------------
+// Capture (memory-mapped trace)
+// -----------------------------------------------------------------------------
+
+typedef struct {
+  void          *map;
+  size_t         map_len;
+  const uint8_t *records;
+  size_t         count;
+  size_t         stride;
+  size_t         raw_off;
+  size_t         time_off;
+  bool           time_is_us;   // t_us (u4) timestamps, else dt_sec (f4) deltas
+  bool           has_channel;
+  size_t         channel_off;
+  size_t         channel_size;  // 1 or 2 bytes
+} capture_t;
+
+static inline uint16_t rd_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t rd_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline float rd_f32(const uint8_t *p) {
+    uint32_t bits = rd_u32(p);
+    float    v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static inline size_t capture_channel(const capture_t *cap, const uint8_t *rec) {
+    if (!cap->has_channel) { return 0; }
+    const uint8_t *p = rec + cap->channel_off;
+    return cap->channel_size == 1 ? p[0] : rd_u16(p);
+}
+
+/** @return true and the field offset if the header has column `name` of type `type` */
+static bool capture_column(const uint8_t *hdr, size_t num_cols,
+                           const char *name, const char *type, size_t *offset) {
+    for (size_t i = 0; i < num_cols; i++) {
+        const uint8_t *d = hdr + TRACE_HEADER_BYTES + i * TRACE_COLUMN_BYTES;
+        if (strncmp((const char *)d, name, TRACE_NAME_LEN) == 0 &&
+            strncmp((const char *)d + TRACE_NAME_LEN, type, 4) == 0) {
+            *offset = rd_u32(d + TRACE_NAME_LEN + 4);
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @return true if a `size`-byte field at `offset` lies inside a record (else reports it) */
+static bool capture_field_fits(const capture_t *cap, const char *path, const char *name,
+                               size_t offset, size_t size) {
+    if (offset <= cap->stride && size <= cap->stride - offset) { return true; }
+    fprintf(stderr, "ERROR: %s: column '%s' (offset %lu, %u bytes) overruns the %lu-byte record\n",
+            path, name, (unsigned long)offset, (unsigned)size, (unsigned long)cap->stride);
+    return false;
+}
+
+static bool capture_open(capture_t *cap, const char *path, const char *raw_col) {
+    memset(cap, 0, sizeof(*cap));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < TRACE_HEADER_BYTES) {
+        fprintf(stderr, "ERROR: %s: not a trace file\n", path);
+        close(fd);
+        return false;
+    }
+    cap->map_len = (size_t)st.st_size;
+    cap->map     = mmap(NULL, cap->map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file
+    if (cap->map == MAP_FAILED) {
+        perror("mmap");
+        cap->map = NULL;
+        return false;
+    }
+    posix_madvise(cap->map, cap->map_len, POSIX_MADV_SEQUENTIAL);
+
+    const uint8_t *hdr      = (const uint8_t *)cap->map;
+    size_t         num_cols = rd_u16(hdr + 10);
+    size_t         data_off = rd_u32(hdr + 16);
+    cap->stride             = rd_u32(hdr + 12);
+    if (memcmp(hdr, "SATRACE", 8) != 0 || rd_u16(hdr + 8) != TRACE_FORMAT_VERSION ||
+        cap->stride == 0 || data_off != TRACE_HEADER_BYTES + TRACE_COLUMN_BYTES * num_cols ||
+        data_off > cap->map_len) {
+        fprintf(stderr, "ERROR: %s: bad or unsupported trace header\n", path);
+        return false;
+    }
+
+    if (!capture_column(hdr, num_cols, raw_col, "u2", &cap->raw_off)) {
+        fprintf(stderr, "ERROR: %s: no u2 column '%s'\n", path, raw_col);
+        return false;
+    }
+    if (capture_column(hdr, num_cols, "t_us", "u4", &cap->time_off)) {
+        cap->time_is_us = true;
+    } else if (!capture_column(hdr, num_cols, "dt_sec", "f4", &cap->time_off)) {
+        fprintf(stderr, "ERROR: %s: needs a t_us (u4) or dt_sec (f4) column\n", path);
+        return false;
+    }
+    if (capture_column(hdr, num_cols, "channel", "u1", &cap->channel_off)) {
+        cap->has_channel  = true;
+        cap->channel_size = 1;
+    } else if (capture_column(hdr, num_cols, "channel", "u2", &cap->channel_off)) {
+        cap->has_channel  = true;
+        cap->channel_size = 2;
+    }
+    if (!capture_field_fits(cap, path, raw_col, cap->raw_off, 2) ||
+        !capture_field_fits(cap, path, cap->time_is_us ? "t_us" : "dt_sec", cap->time_off, 4) ||
+        (cap->has_channel && !capture_field_fits(cap, path, "channel", cap->channel_off, cap->channel_size))) {
+        return false;
+    }
+
+    cap->records = hdr + data_off;
+    cap->count   = (cap->map_len - data_off) / cap->stride;  // Ignores a partial tail
+    return true;
+}
+
+static void capture_close(capture_t *cap) {
+    if (cap->map) { munmap(cap->map, cap->map_len); }
+    cap->map = NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Replay
+// -----------------------------------------------------------------------------
+
+typedef enum { REPLAY_AXIS, REPLAY_BANK } replay_api_t;
+
+typedef struct {
+  size_t    num_channels;
+  uint16_t  max_raw_seen;
+  uint16_t *first_raw;     // First reading per channel (bank seed)
+  size_t   *first_record;  // Index of that reading
+  double    dt_sum;
+  float     dt_min;
+  float     dt_max;
+  size_t    dt_count;
+  double    span_sec;      // Capture duration (longest channel)
+} capture_scan_t;
+
+typedef struct {
+  uint64_t  events;
+  uint64_t  digest;
+  uint64_t *events_per_channel;
+  double    noise_mean;    // Final noise estimate over channels
+  double    noise_max;
+  double    elapsed_sec;   // Update loop only
+} replay_result_t;
+
+typedef struct {
+  replay_api_t          api;
+  smooth_axis_config_t  cfg;
+  trace_writer_t       *events;  // NULL = no event log
+} replay_opts_t;
+
+// Per-channel dt: t_us deltas, or a running clock built from dt_sec
+typedef struct {
+  const capture_t *cap;
+  uint32_t        *last_us;
+  double          *last_sec;
+  double           clock_sec;
+} dt_tracker_t;
+
+static inline float dt_next(dt_tracker_t *t, const uint8_t *rec, size_t ch, bool first) {
+    float dt = 0.0f;
+    if (t->cap->time_is_us) {
+        uint32_t now = rd_u32(rec + t->cap->time_off);
+        if (!first) { dt = (float)(uint32_t)(now - t->last_us[ch]) * 1e-6f; }
+        t->last_us[ch] = now;
+    } else {
+        t->clock_sec += (double)rd_f32(rec + t->cap->time_off);
+        if (!first) { dt = (float)(t->clock_sec - t->last_sec[ch]); }
+        t->last_sec[ch] = t->clock_sec;
+    }
+    return dt;
+}
+
+static bool dt_tracker_init(dt_tracker_t *t, const capture_t *cap, size_t num_channels) {
+    t->cap       = cap;
+    t->clock_sec = 0.0;
+    t->last_us   = (uint32_t *)calloc(num_channels, sizeof(*t->last_us));
+    t->last_sec  = (double *)calloc(num_channels, sizeof(*t->last_sec));
+    return t->last_us && t->last_sec;
+}
+
+static void dt_tracker_free(dt_tracker_t *t) {
+    free(t->last_us);
+    free(t->last_sec);
+}
+
+static inline uint64_t digest_mix(uint64_t h, uint64_t record, size_t ch, uint16_t out) {
+    h = (h ^ record) * DIGEST_PRIME;
+    h = (h ^ (uint64_t)ch) * DIGEST_PRIME;
+    return (h ^ (uint64_t)out) * DIGEST_PRIME;
+}
+
+/** @brief One untimed pass: channels, first samples, dt statistics */
+static bool capture_prescan(const capture_t *cap, capture_scan_t *scan) {
+    memset(scan, 0, sizeof(*scan));
+    for (size_t i = 0; i < cap->count; i++) {
+        size_t ch = capture_channel(cap, cap->records + i * cap->stride);
+        if (ch + 1 > scan->num_channels) { scan->num_channels = ch + 1; }
+    }
+    if (scan->num_channels == 0) { return false; }
+
+    scan->first_raw    = (uint16_t *)calloc(scan->num_channels, sizeof(*scan->first_raw));
+    scan->first_record = (size_t *)malloc(scan->num_channels * sizeof(*scan->first_record));
+    double      *start = (double *)calloc(scan->num_channels, sizeof(*start));
+    dt_tracker_t dt;
+    if (!scan->first_raw || !scan->first_record || !start ||
+        !dt_tracker_init(&dt, cap, scan->num_channels)) {
+        free(start);
+        return false;
+    }
+    for (size_t ch = 0; ch < scan->num_channels; ch++) { scan->first_record[ch] = SIZE_MAX; }
+
+    scan->dt_min = INFINITY;
+    double *since = start;  // Elapsed time per channel since its first sample
+    for (size_t i = 0; i < cap->count; i++) {
+        const uint8_t *rec   = cap->records + i * cap->stride;
+        size_t         ch    = capture_channel(cap, rec);
+        uint16_t       raw   = rd_u16(rec + cap->raw_off);
+        bool           first = scan->first_record[ch] == SIZE_MAX;
+        float          d     = dt_next(&dt, rec, ch, first);
+
+        if (raw > scan->max_raw_seen) { scan->max_raw_seen = raw; }
+        if (first) {
+            scan->first_record[ch] = i;
+            scan->first_raw[ch]    = raw;
+            continue;
+        }
+        since[ch]    += (double)d;
+        scan->dt_sum += (double)d;
+        scan->dt_count++;
+        if (d < scan->dt_min) { scan->dt_min = d; }
+        if (d > scan->dt_max) { scan->dt_max = d; }
+        if (since[ch] > scan->span_sec) { scan->span_sec = since[ch]; }
+    }
+    if (scan->dt_count == 0) { scan->dt_min = 0.0f; }
+
+    dt_tracker_free(&dt);
+    free(start);
+    return true;
+}
+
+static void capture_scan_free(capture_scan_t *scan) {
+    free(scan->first_raw);
+    free(scan->first_record);
+}
+
+static inline void replay_emit(replay_result_t *res, const replay_opts_t *opts,
+                               uint64_t record, size_t ch, uint16_t out) {
+    res->events++;
+    res->events_per_channel[ch]++;
+    res->digest = digest_mix(res->digest, record, ch, out);
+    if (opts->events) {
+        trace_put_u32(opts->events, (uint32_t)record);
+        trace_put_u16(opts->events, (uint16_t)ch);
+        trace_put_u16(opts->events, out);
+        trace_end_record(opts->events);
+    }
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Replay the whole capture once
+ *
+ * @return false on allocation failure or a bank too small for the channel count
+ */
+static bool replay_run(const capture_t *cap,
+                       const capture_scan_t *scan,
+                       const replay_opts_t *opts,
+                       replay_result_t *res) {
+    size_t nch = scan->num_channels;
+    res->events             = 0;
+    res->digest             = DIGEST_INIT;
+    res->events_per_channel = (uint64_t *)calloc(nch, sizeof(uint64_t));
+
+    dt_tracker_t dt;
+    if (!res->events_per_channel || !dt_tracker_init(&dt, cap, nch)) { return false; }
+
+    bool ok = true;
+    if (opts->api == REPLAY_AXIS) {
+        smooth_axis_t *axes = (smooth_axis_t *)malloc(nch * sizeof(*axes));
+        bool          *seen = (bool *)calloc(nch, sizeof(*seen));
+        if (!axes || !seen) {
+            ok = false;
+        } else {
+            for (size_t ch = 0; ch < nch; ch++) { smooth_axis_init(&axes[ch], &opts->cfg); }
+
+            double t0 = now_sec();
+            for (size_t i = 0; i < cap->count; i++) {
+                const uint8_t *rec = cap->records + i * cap->stride;
+                size_t         ch  = capture_channel(cap, rec);
+                float          d   = dt_next(&dt, rec, ch, !seen[ch]);
+                seen[ch] = true;
+
+                smooth_axis_update_live_dt(&axes[ch], rd_u16(rec + cap->raw_off), d);
+                if (smooth_axis_has_new_value(&axes[ch])) {
+                    replay_emit(res, opts, i, ch, smooth_axis_get_u16(&axes[ch]));
+                }
+            }
+            res->elapsed_sec = now_sec() - t0;
+
+            res->noise_mean = res->noise_max = 0.0;
+            for (size_t ch = 0; ch < nch; ch++) {
+                double n = (double)smooth_axis_get_noise_norm(&axes[ch]);
+                res->noise_mean += n / (double)nch;
+                if (n > res->noise_max) { res->noise_max = n; }
+            }
+        }
+        free(axes);
+        free(seen);
+    } else {
+        smooth_axis_bank_t *bank = (smooth_axis_bank_t *)malloc(sizeof(*bank));
+        uint32_t            mask[SMOOTH_AXIS_BANK_MASK_WORDS(SMOOTH_AXIS_BANK_MAX_AXES)] = {0};
+        if (!bank || nch > SMOOTH_AXIS_BANK_MAX_AXES) {
+            if (bank) {
+                fprintf(stderr, "ERROR: %u channels, bank holds %u (SMOOTH_AXIS_BANK_MAX_AXES)\n",
+                        (unsigned)nch, (unsigned)SMOOTH_AXIS_BANK_MAX_AXES);
+            }
+            ok = false;
+        } else {
+            smooth_axis_bank_init(bank, &opts->cfg, nch);
+            smooth_axis_bank_set_change_mask(bank, mask);
+
+            double t0 = now_sec();
+            smooth_axis_bank_update_live_dt(bank, scan->first_raw, nch, 0.0f);  // Seeds every axis
+            for (size_t i = 0; i < cap->count; i++) {
+                const uint8_t *rec   = cap->records + i * cap->stride;
+                size_t         ch    = capture_channel(cap, rec);
+                bool           first = scan->first_record[ch] == i;
+                float          d     = dt_next(&dt, rec, ch, first);
+
+                // First sample was fed by the seed scan; its report is taken here, in record order
+                if (!first) { smooth_axis_bank_update_axis_live_dt(bank, ch, rd_u16(rec + cap->raw_off), d); }
+                uint32_t bit = 1u << (ch % 32);
+                if (mask[ch / 32] & bit) {
+                    mask[ch / 32] &= ~bit;
+                    replay_emit(res, opts, i, ch, smooth_axis_bank_get_u16(bank, ch));
+                }
+            }
+            res->elapsed_sec = now_sec() - t0;
+
+            res->noise_mean = res->noise_max = 0.0;
+            for (size_t ch = 0; ch < nch; ch++) {
+                double n = (double)smooth_axis_bank_get_noise_norm(bank, ch);
+                res->noise_mean += n / (double)nch;
+                if (n > res->noise_max) { res->noise_max = n; }
+            }
+        }
+        free(bank);
+    }
+
+    dt_tracker_free(&dt);
+    return ok;
+}
+
+static void replay_print(const char *path, const capture_t *cap, const capture_scan_t *scan,
+                         const replay_opts_t *opts, const replay_result_t *res, double best_sec,
+                         unsigned repeats) {
+    uint64_t ev_min = UINT64_MAX, ev_max = 0;
+    for (size_t ch = 0; ch < scan->num_channels; ch++) {
+        if (res->events_per_channel[ch] < ev_min) { ev_min = res->events_per_channel[ch]; }
+        if (res->events_per_channel[ch] > ev_max) { ev_max = res->events_per_channel[ch]; }
+    }
+
+    printf("=== smooth_axis replay: %s ===\n", path);
+    printf("  records:    %llu (%u channels, %s timestamps, %.3f s span)\n",
+           (unsigned long long)cap->count, (unsigned)scan->num_channels,
+           cap->time_is_us ? "t_us" : "dt_sec", scan->span_sec);
+    printf("  config:     %s API, max_raw %u, settle %.3f s\n",
+           opts->api == REPLAY_AXIS ? "axis" : "bank",
+           (unsigned)opts->cfg.max_raw, opts->cfg.settle_time_sec);
+    printf("  dt:         min %.3f ms, mean %.3f ms, max %.3f ms\n",
+           scan->dt_min * 1e3, scan->dt_count ? scan->dt_sum / (double)scan->dt_count * 1e3 : 0.0,
+           scan->dt_max * 1e3);
+    printf("  events:     %llu (%.3f%% of records, %llu..%llu per channel, %.1f/s per channel)\n",
+           (unsigned long long)res->events,
+           cap->count ? 100.0 * (double)res->events / (double)cap->count : 0.0,
+           (unsigned long long)ev_min, (unsigned long long)ev_max,
+           scan->span_sec > 0.0 ? (double)res->events / (double)scan->num_channels / scan->span_sec : 0.0);
+    printf("  digest:     %016llx\n", (unsigned long long)res->digest);
+    printf("  noise_norm: mean %.6f, max %.6f (final)\n", res->noise_mean, res->noise_max);
+    printf("  throughput: %.1f M samples/s (%.2f ns/sample, best of %u)\n",
+           best_sec > 0.0 ? (double)cap->count / best_sec * 1e-6 : 0.0,
+           cap->count ? best_sec / (double)cap->count * 1e9 : 0.0, repeats);
+}
+
+// -----------------------------------------------------------------------------
+// --quick: synthetic capture vs a direct run
+// -----------------------------------------------------------------------------
+
+static const trace_column_t CAPTURE_COLUMNS[] = {
+        { "t_us",    TRACE_U32, "%lu" },
+        { "channel", TRACE_U8,  "%u"  },
+        { "raw",     TRACE_U16, "%u"  },
+};
+
+static const trace_column_t EVENT_COLUMNS[] = {
+        { "record",  TRACE_U32, "%lu" },  // Low 32 bits of the record index
+        { "channel", TRACE_U16, "%u"  },
+        { "out_u16", TRACE_U16, "%u"  },
+};
+
+static trace_writer_t writer;
+
+static uint32_t quick_rand(uint32_t *state) {
+    *state = (*state * 1664525u + 1013904223u);
+    return *state >> 8;
+}
+
+/** @brief Write the synthetic capture and return the digest of feeding it directly */
+static bool quick_make_capture(const smooth_axis_config_t *cfg, uint64_t *digest) {
+    mkdir("tests/data", 0755);
+    mkdir(QUICK_DIR, 0755);
+    if (!trace_open(&writer, QUICK_CAPTURE, NULL, CAPTURE_COLUMNS, 3)) {
+        perror(QUICK_CAPTURE);
+        return false;
+    }
+
+    smooth_axis_t axes[QUICK_CHANNELS];
+    for (size_t ch = 0; ch < QUICK_CHANNELS; ch++) { smooth_axis_init(&axes[ch], cfg); }
+
+    uint32_t rng      = 42u;
+    uint32_t t_us     = 0xFFF00000u;  // Wraps early on
+    uint32_t last[QUICK_CHANNELS] = {0};
+    uint64_t record   = 0;
+    *digest           = DIGEST_INIT;
+
+    for (uint32_t scan = 0; scan < QUICK_SCANS; scan++) {
+        for (size_t ch = 0; ch < QUICK_CHANNELS; ch++) {
+            t_us += 120u + quick_rand(&rng) % 10u;  // ~1 kHz per channel, jittered
+
+            // Channel ch: slow sine, a step every 7 s, noise growing with ch
+            double t     = (double)scan * 1e-3;
+            double level = 0.5 + 0.3 * sin(2.0 * M_PI * 0.2 * t + (double)ch);
+            if (((unsigned)(t / 7.0) & 1u) != 0) { level = 0.15; }
+            double noise = ((double)(quick_rand(&rng) % 2001u) - 1000.0) * 1e-3 * 4.0 * (double)ch;
+            double raw_f = level * 4095.0 + noise;
+            uint16_t raw = (uint16_t)(raw_f < 0.0 ? 0.0 : raw_f > 4095.0 ? 4095.0 : raw_f + 0.5);
+
+            trace_put_u32(&writer, t_us);
+            trace_put_u8(&writer, (uint8_t)ch);
+            trace_put_u16(&writer, raw);
+            trace_end_record(&writer);
+
+            float dt = scan == 0 ? 0.0f : (float)(uint32_t)(t_us - last[ch]) * 1e-6f;
+            last[ch] = t_us;
+            smooth_axis_update_live_dt(&axes[ch], raw, dt);
+            if (smooth_axis_has_new_value(&axes[ch])) {
+                *digest = digest_mix(*digest, record, ch, smooth_axis_get_u16(&axes[ch]));
+            }
+            record++;
+        }
+    }
+    return trace_close(&writer);
+}
+
+/** @brief Copy of the capture's header and first record with the raw column moved past the record */
+static bool quick_rejects_bad_offset(const capture_t *cap) {
+    const char    *path     = QUICK_DIR "/bad_offset.bin";
+    const uint8_t *hdr      = (const uint8_t *)cap->map;
+    size_t         data_off = (size_t)(cap->records - hdr);
+    uint8_t       *copy     = malloc(data_off + cap->stride);
+    if (!copy) { return false; }
+    memcpy(copy, hdr, data_off + cap->stride);
+    uint8_t *raw_offset = copy + TRACE_HEADER_BYTES + 2 * TRACE_COLUMN_BYTES + TRACE_NAME_LEN + 4;  // "raw"
+    trace_le32(raw_offset, (uint32_t)cap->stride - 1u);
+
+    FILE *f  = fopen(path, "wb");
+    bool  ok = f && fwrite(copy, 1, data_off + cap->stride, f) == data_off + cap->stride;
+    if (f && fclose(f) != 0) { ok = false; }
+    free(copy);
+    if (!ok) {
+        perror(path);
+        return false;
+    }
+
+    capture_t bad;
+    bool      opened = capture_open(&bad, path, "raw");
+    capture_close(&bad);
+    printf("  bad offset: %s\n\n", opened ? "FAIL (accepted)" : "OK (rejected)");
+    return !opened;
+}
+
+static int run_quick(void) {
+    smooth_axis_config_t cfg;
+    smooth_axis_config_live_dt(&cfg, 4095, 0.05f);
+
+    uint64_t direct;
+    if (!quick_make_capture(&cfg, &direct)) { return 1; }
+
+    capture_t      cap;
+    capture_scan_t scan;
+    if (!capture_open(&cap, QUICK_CAPTURE, "raw") || !capture_prescan(&cap, &scan)) {
+        capture_close(&cap);
+        return 1;
+    }
+
+    int status = 0;
+    for (int api = REPLAY_AXIS; api <= REPLAY_BANK; api++) {
+        replay_opts_t   opts = { (replay_api_t)api, cfg, NULL };
+        replay_result_t res;
+        if (!replay_run(&cap, &scan, &opts, &res)) {
+            status = 1;
+            free(res.events_per_channel);
+            break;
+        }
+        replay_print(QUICK_CAPTURE, &cap, &scan, &opts, &res, res.elapsed_sec, 1);
+        bool same = res.digest == direct;
+        printf("  vs direct:  %s (%016llx)\n\n", same ? "OK" : "FAIL", (unsigned long long)direct);
+        if (!same) { status = 1; }
+        free(res.events_per_channel);
+    }
+
+    if (!quick_rejects_bad_offset(&cap)) { status = 1; }
+
+    capture_scan_free(&scan);
+    capture_close(&cap);
+    return status;
+}
+
+// -----------------------------------------------------------------------------
+// Entry Point
+// -----------------------------------------------------------------------------
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s CAPTURE [--api axis|bank] [--settle SEC] [--max-raw N] [--raw-col NAME]\n"
+            "       %*s [--repeat N] [--events STEM [--csv]]\n"
+            "       %s --quick\n",
+            argv0, (int)strlen(argv0), "", argv0);
+}
+
+int main(int argc, char **argv) {
+    const char  *path        = NULL;
+    const char  *raw_col     = "raw";
+    const char  *events_stem = NULL;
+    replay_api_t api         = REPLAY_AXIS;
+    float        settle      = 0.1f;
+    long         max_raw     = 0;  // 0 = smallest 2^k - 1 that holds every reading
+    long         repeats     = 1;
+    bool         csv         = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (strcmp(argv[i], "--quick") == 0) {
+            return run_quick();
+        } else if (strcmp(argv[i], "--api") == 0 && has_val) {
+            const char *v = argv[++i];
+            if (strcmp(v, "axis") == 0) {
+                api = REPLAY_AXIS;
+            } else if (strcmp(v, "bank") == 0) {
+                api = REPLAY_BANK;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--settle") == 0 && has_val) {
+            settle = strtof(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--max-raw") == 0 && has_val) {
+            max_raw = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--raw-col") == 0 && has_val) {
+            raw_col = argv[++i];
+        } else if (strcmp(argv[i], "--repeat") == 0 && has_val) {
+            repeats = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--events") == 0 && has_val) {
+            events_stem = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!path || repeats < 1 || max_raw < 0 || max_raw > 65535 || !(settle > 0.0f)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    capture_t      cap;
+    capture_scan_t scan;
+    if (!capture_open(&cap, path, raw_col)) {
+        capture_close(&cap);
+        return 1;
+    }
+    if (!capture_prescan(&cap, &scan)) {
+        fprintf(stderr, "ERROR: %s: empty capture\n", path);
+        capture_close(&cap);
+        return 1;
+    }
+
+    if (max_raw == 0) {
+        max_raw = 1;
+        while (max_raw < scan.max_raw_seen) { max_raw = max_raw * 2 + 1; }
+    }
+
+    replay_opts_t opts;
+    opts.api    = api;
+    opts.events = NULL;
+    smooth_axis_config_live_dt(&opts.cfg, (uint16_t)max_raw, settle);
+
+    int    status   = 0;
+    double best_sec = 0.0;
+    replay_result_t first;
+    memset(&first, 0, sizeof(first));
+
+    for (long r = 0; r < repeats && status == 0; r++) {
+        // Events are logged on the first pass only; later passes are timing runs
+        bool log = r == 0 && events_stem != NULL;
+        char bin_path[512];
+        char csv_path[512];
+        if (log) {
+            snprintf(bin_path, sizeof(bin_path), "%s.bin", events_stem);
+            snprintf(csv_path, sizeof(csv_path), "%s.csv", events_stem);
+            if (!trace_open(&writer, bin_path, csv ? csv_path : NULL, EVENT_COLUMNS, 3)) {
+                perror(bin_path);
+                status = 1;
+                break;
+            }
+            opts.events = &writer;
+        } else {
+            opts.events = NULL;
+        }
+
+        replay_result_t res;
+        if (!replay_run(&cap, &scan, &opts, &res)) {
+            status = 1;
+        } else if (r == 0) {
+            first    = res;
+            best_sec = res.elapsed_sec;
+            res.events_per_channel = NULL;  // Kept in `first`
+        } else if (res.elapsed_sec < best_sec) {
+            best_sec = res.elapsed_sec;
+        }
+        free(res.events_per_channel);
+
+        if (log && !trace_close(&writer)) {
+            fprintf(stderr, "ERROR: Failed writing %s\n", bin_path);
+            status = 1;
+        }
+    }
+
+    if (status == 0) {
+        replay_print(path, &cap, &scan, &opts, &first, best_sec, (unsigned)repeats);
+        if (events_stem) { printf("  event log:  %s.bin%s\n", events_stem, csv ? " (+ .csv)" : ""); }
+    }
+
+    free(first.events_per_channel);
+    capture_scan_free(&scan);
+    capture_close(&cap);
+    return status;
+}
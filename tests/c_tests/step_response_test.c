@@ -5,12 +5,19 @@
  *
  * Tests settle time accuracy using step input (900 → 100) and 95% threshold detection.
  * Tests under two conditions: clean and noisy+jittery.
+ * Also checks the LIVE_DT alpha table against exact 1 - exp(k·dt), and runs a
+ * compact-state axis (smooth_axis_compact.h) on the same samples to quantify its
+ * difference from the float state (fails the run if either documented error
+ * bound is exceeded).
  *
  * Outputs:
  *   - step_results_clean.csv: Summary of clean tests
  *   - step_results_noisy.csv: Summary of noisy tests
- *   - step_trace_clean_XXms.csv: Detailed traces for clean condition (8 files)
- *   - step_trace_noisy_XXms.csv: Detailed traces for noisy condition (8 files)
+ *   - step_trace_clean_XXms.bin: Detailed traces for clean condition (5 files)
+ *   - step_trace_noisy_XXms.bin: Detailed traces for noisy condition (5 files)
+ *
+ * Traces are binary (trace_writer.h). Run with --csv to also export each
+ * trace as step_trace_*_XXms.csv.
  */
 #include <stdio.h>
 #include <stdint.h>
@@ -21,12 +28,34 @@
 #include <errno.h>
 #include <unistd.h>
 #include "smooth_axis.h"
+#include "smooth_axis_compact.h"
+#include "smooth_axis_internal.h"  // get_alpha_from_lut() for the alpha accuracy check
+#include "trace_writer.h"
+
+#ifndef M_PI  // Not provided by strict C99 <math.h>
+#define M_PI 3.14159265358979323846
+#endif
 
 // -----------------------------------------------------------------------------
 // Output Configuration
 // -----------------------------------------------------------------------------
 #define OUTPUT_DIR "tests/data/step_files"
 
+// One trace record per update (20 bytes; see trace_writer.h for the file layout)
+static const trace_column_t TRACE_COLUMNS[] = {
+        { "time_ms",     TRACE_F32, "%.0f" },
+        { "raw_input",   TRACE_U16, "%u"   },
+        { "raw_ema",     TRACE_U16, "%u"   },  // Current smoothed output
+        { "crossed_95",  TRACE_U8,  "%u"   },
+        { "has_new",     TRACE_U8,  "%u"   },
+        { "out_u16",     TRACE_U16, "%u"   },  // Last declared value
+        { "noise_norm",  TRACE_F32, "%.6f" },
+        { "thresh_norm", TRACE_F32, "%.6f" },
+};
+#define NUM_TRACE_COLUMNS (sizeof(TRACE_COLUMNS) / sizeof(TRACE_COLUMNS[0]))
+
+static trace_writer_t trace;  // 64 KB write buffer, reused for every run
+
 // -----------------------------------------------------------------------------
 // Test Configuration
 // -----------------------------------------------------------------------------
@@ -172,8 +201,17 @@ typedef struct {
   float settle_time_measured_ms;
   float error_pct;
   bool timed_out;
+  
+  // Compact-state shadow axis, same samples
+  float    compact_settle_ms;     // Its 95% crossing (declared values), -1 if none
+  uint16_t compact_max_u16_diff;  // Max |get_u16()| difference from the float axis
+  uint32_t compact_report_diffs;  // Updates where has_new_value() disagreed
 }                  test_result_t;
 
+// Compact state vs float: both bounds are documented in smooth_axis_compact.h
+#define COMPACT_MAX_SETTLE_REL_ERROR 0.01f  // Settle time, of nominal (measured worst: 0.7%)
+#define COMPACT_MAX_U16_DIFF         1      // Output LSB
+
 // -----------------------------------------------------------------------------
 // Step Response Test
 // -----------------------------------------------------------------------------
@@ -183,13 +221,13 @@ typedef struct {
  *
  * @param settle_time_sec Nominal settle time in seconds
  * @param condition       Test condition (clean or noisy)
- * @param trace_file      File to write detailed trace
+ * @param trace           Open trace writer for the detailed trace
  * @param rng_seed        Random seed for noise/jitter
  * @return Test result with measured settle time
  */
 test_result_t run_step_test(float settle_time_sec,
                             test_condition_t condition,
-                            FILE *trace_file,
+                            trace_writer_t *trace,
                             unsigned int rng_seed) {
     test_result_t result  = {0};
     result.settle_time_nominal_ms = settle_time_sec * 1000.0f;
@@ -205,9 +243,11 @@ test_result_t run_step_test(float settle_time_sec,
     smooth_axis_t axis;
     smooth_axis_init(&axis, &cfg);
     
-    // Write trace header
-    fprintf(trace_file,
-            "time_ms,raw_input,raw_ema,crossed_95,has_new,out_u16,noise_norm,thresh_norm\n");
+    smooth_axis_shared_cfg_t shared;
+    smooth_axis_compact_t    compact;
+    smooth_axis_shared_cfg_init(&shared, &cfg);
+    smooth_axis_compact_init(&compact, 1);
+    result.compact_settle_ms = -1.0f;
     
     float        t           = 0.0f;
     int          total_steps = (int)(DURATION_SEC / DT_SEC);
@@ -237,8 +277,18 @@ test_result_t run_step_test(float settle_time_sec,
         
         // Update filter
         smooth_axis_update_live_dt(&axis, raw, dt);
+        smooth_axis_compact_update_live_dt(&compact, &shared, raw, dt);
+        
+        uint16_t raw_ema     = smooth_axis_get_u16(&axis);
+        uint16_t compact_u16 = smooth_axis_compact_get_u16(&compact, &shared);
+        uint16_t u16_diff    = (uint16_t)(raw_ema > compact_u16 ? raw_ema - compact_u16 : compact_u16 - raw_ema);
+        if (u16_diff > result.compact_max_u16_diff) { result.compact_max_u16_diff = u16_diff; }
         
-        uint16_t raw_ema = smooth_axis_get_u16(&axis);
+        bool compact_new = smooth_axis_compact_has_new_value(&compact, &shared);
+        if (compact_new && result.compact_settle_ms < 0.0f && t >= STEP_TIME_SEC
+            && compact_u16 <= THRESHOLD_95) {
+            result.compact_settle_ms = (t - STEP_TIME_SEC) * 1000.0f;
+        }
         
         int has_new = 0;
         if (smooth_axis_has_new_value(&axis)) {
@@ -253,18 +303,20 @@ test_result_t run_step_test(float settle_time_sec,
             }
         }
         
+        result.compact_report_diffs += (uint32_t)(compact_new != (has_new != 0));
+        
         float noise_norm  = smooth_axis_get_noise_norm(&axis);
         float thresh_norm = smooth_axis_get_effective_thresh_norm(&axis);
         
-        fprintf(trace_file, "%.0f,%u,%u,%d,%d,%u,%.6f,%.6f\n",
-                t * 1000.0f,  // time_ms
-                raw,          // raw_input
-                raw_ema,      // raw_ema (current smoothed output)
-                crossed ? 1 : 0,  // crossed_95
-                has_new,      // has_new
-                last_out,     // out_u16 (last declared value)
-                noise_norm,   // noise_norm
-                thresh_norm); // thresh_norm
+        trace_put_f32(trace, t * 1000.0f);
+        trace_put_u16(trace, raw);
+        trace_put_u16(trace, raw_ema);
+        trace_put_u8(trace, crossed ? 1 : 0);
+        trace_put_u8(trace, (uint8_t)has_new);
+        trace_put_u16(trace, last_out);
+        trace_put_f32(trace, noise_norm);
+        trace_put_f32(trace, thresh_norm);
+        trace_end_record(trace);
         
         t += dt;
     }
@@ -278,14 +330,56 @@ test_result_t run_step_test(float settle_time_sec,
     return result;
 }
 
+// -----------------------------------------------------------------------------
+// LIVE_DT Alpha Accuracy
+// -----------------------------------------------------------------------------
+
+#define ALPHA_MAX_REL_ERROR 5e-6   // Bound documented in smooth_axis_internal.h
+#define ALPHA_SWEEP_POINTS  20000  // dt samples per settle time, log-spaced
+
+/**
+ * @brief Sweep dt over [1us .. 60ms] and compare LIVE_DT alpha to double-precision exp()
+ *
+ * @return true if every sample is within ALPHA_MAX_REL_ERROR
+ */
+static bool check_alpha_accuracy(void) {
+    printf("\n=== LIVE_DT ALPHA vs exact 1 - exp(k*dt) ===\n");
+
+    bool ok = true;
+    for (size_t s = 0; s < NUM_SETTLE_TIMES; s++) {
+        smooth_axis_config_t cfg;
+        smooth_axis_config_live_dt(&cfg, MAX_RAW, SETTLE_TIME_MS_VALUES[s] / 1000.0f);
+
+        double max_rel = 0.0;
+        double max_rel_expf = 0.0;  // Reference point: the plain expf() formula
+        for (int i = 0; i < ALPHA_SWEEP_POINTS; i++) {
+            float  dt    = (float)(1e-6 * pow(6e4, (double)i / (ALPHA_SWEEP_POINTS - 1)));
+            double exact = -expm1((double)cfg._ema_decay_rate * (double)dt);
+
+            double rel      = fabs(get_alpha_from_lut(&cfg, dt) - exact) / exact;
+            double rel_expf = fabs(get_alpha_from_dt(cfg._ema_decay_rate, dt) - exact) / exact;
+            if (rel > max_rel) { max_rel = rel; }
+            if (rel_expf > max_rel_expf) { max_rel_expf = rel_expf; }
+        }
+
+        bool pass = max_rel <= ALPHA_MAX_REL_ERROR;
+        printf("settle_time %.0fms: max rel error %.2e (expf: %.2e) %s\n",
+               SETTLE_TIME_MS_VALUES[s], max_rel, max_rel_expf, pass ? "OK" : "FAIL");
+        ok = ok && pass;
+    }
+    return ok;
+}
+
 // -----------------------------------------------------------------------------
 // Test Suite Runner
 // -----------------------------------------------------------------------------
 
 /**
  * @brief Run all tests for a given condition
+ *
+ * @return false if the compact state exceeds its documented bounds
  */
-void run_test_suite(test_condition_t condition, const char *condition_name) {
+bool run_test_suite(test_condition_t condition, const char *condition_name, bool csv) {
     printf("\n=== %s ===\n", condition_name);
     
     // Open summary results file
@@ -298,9 +392,12 @@ void run_test_suite(test_condition_t condition, const char *condition_name) {
     FILE *results_file = fopen(summary_filename, "w");
     if (!results_file) {
         perror("Failed to open summary file");
-        return;
+        return false;
     }
     
+    test_result_t results[NUM_SETTLE_TIMES];
+    bool          ran[NUM_SETTLE_TIMES] = { false };
+    
     fprintf(results_file, "settle_time_ms,measured_settle_ms,error_pct\n");
     
     // Run tests for each settle_time value
@@ -311,16 +408,20 @@ void run_test_suite(test_condition_t condition, const char *condition_name) {
         printf("Testing settle_time: %.0fms... ", settle_time_ms);
         fflush(stdout);
         
-        // Open trace file for this test
-        char trace_filename[256];
-        snprintf(trace_filename, sizeof(trace_filename),
-                 "%s/step_trace_%s_%.0fms.csv",
+        // Open trace file(s) for this test
+        char trace_stem[240];
+        char bin_path[256];
+        char csv_path[256];
+        snprintf(trace_stem, sizeof(trace_stem),
+                 "%s/step_trace_%s_%.0fms",
                  OUTPUT_DIR,
                  (condition == CONDITION_CLEAN) ? "clean" : "noisy",
                  settle_time_ms);
+        snprintf(bin_path, sizeof(bin_path), "%s.bin", trace_stem);
+        snprintf(csv_path, sizeof(csv_path), "%s.csv", trace_stem);
         
-        FILE *trace_file = fopen(trace_filename, "w");
-        if (!trace_file) {
+        if (!trace_open(&trace, bin_path, csv ? csv_path : NULL,
+                        TRACE_COLUMNS, NUM_TRACE_COLUMNS)) {
             perror("Failed to open trace file");
             fprintf(results_file, "%.0f,error,N/A\n", settle_time_ms);
             continue;
@@ -329,9 +430,13 @@ void run_test_suite(test_condition_t condition, const char *condition_name) {
         // Run the test (use different RNG seed for each test)
         unsigned int  rng_seed = 12345u + (unsigned int)i +
                                  (condition == CONDITION_NOISY ? 1000u : 0u);
-        test_result_t result   = run_step_test(settle_time_sec, condition, trace_file, rng_seed);
+        test_result_t result   = run_step_test(settle_time_sec, condition, &trace, rng_seed);
+        results[i] = result;
+        ran[i]     = true;
         
-        fclose(trace_file);
+        if (!trace_close(&trace)) {
+            fprintf(stderr, "ERROR: Failed writing %s\n", bin_path);
+        }
         
         // Output results
         if (result.timed_out) {
@@ -349,13 +454,48 @@ void run_test_suite(test_condition_t condition, const char *condition_name) {
     }
     
     fclose(results_file);
+    
+    // Compact state vs float, same samples
+    bool ok = true;
+    printf("Compact state (8 bytes) vs float:\n");
+    for (size_t i = 0; i < NUM_SETTLE_TIMES; i++) {
+        if (!ran[i]) { continue; }
+        const test_result_t *r = &results[i];
+        
+        float settle_rel = 0.0f;
+        bool  pass       = r->compact_max_u16_diff <= COMPACT_MAX_U16_DIFF;
+        if (r->timed_out || r->compact_settle_ms < 0.0f) {
+            pass = pass && r->timed_out && r->compact_settle_ms < 0.0f;
+        } else {
+            settle_rel = fabsf(r->compact_settle_ms - r->settle_time_measured_ms) / r->settle_time_nominal_ms;
+            pass       = pass && settle_rel <= COMPACT_MAX_SETTLE_REL_ERROR;
+        }
+        printf("  settle_time %4.0fms: compact %8.3fms (%.3f%% of nominal off float), max |du16| %u, "
+               "report decisions differing %u %s\n",
+               r->settle_time_nominal_ms, r->compact_settle_ms, settle_rel * 100.0f,
+               (unsigned)r->compact_max_u16_diff, (unsigned)r->compact_report_diffs,
+               pass ? "OK" : "FAIL");
+        ok = ok && pass;
+    }
+    return ok;
 }
 
 // -----------------------------------------------------------------------------
 // Main Test Runner
 // -----------------------------------------------------------------------------
 
-int main(void) {
+int main(int argc, char **argv) {
+    // --csv: also export every trace as CSV (the .bin traces are always written)
+    bool csv = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--csv]\n", argv[0]);
+            return 1;
+        }
+    }
+
     // Validate we're in the right place
     if (!validate_working_directory()) {
         return 1;
@@ -374,10 +514,13 @@ int main(void) {
     printf("  Duration: %.1f seconds\n", DURATION_SEC);
 
     // Run clean condition tests
-    run_test_suite(CONDITION_CLEAN, "CLEAN CONDITIONS");
+    bool compact_ok = run_test_suite(CONDITION_CLEAN, "CLEAN CONDITIONS", csv);
 
     // Run noisy condition tests
-    run_test_suite(CONDITION_NOISY, "NOISY CONDITIONS (4% noise, 8% jitter)");
+    compact_ok = run_test_suite(CONDITION_NOISY, "NOISY CONDITIONS (4% noise, 8% jitter)", csv)
+                 && compact_ok;
+
+    bool alpha_ok = check_alpha_accuracy();
 
     printf("\nDone. Results written to:\n");
     printf("  Directory: %s\n", OUTPUT_DIR);
@@ -385,8 +528,11 @@ int main(void) {
     printf("    - step_results_clean.csv\n");
     printf("    - step_results_noisy.csv\n");
     printf("  Trace files:\n");
-    printf("    - step_trace_clean_*.csv (5 files)\n");
-    printf("    - step_trace_noisy_*.csv (5 files)\n");
+    printf("    - step_trace_clean_*.bin (5 files)\n");
+    printf("    - step_trace_noisy_*.bin (5 files)\n");
+    if (csv) {
+        printf("    - step_trace_*.csv (CSV export)\n");
+    }
 
-    return 0;
+    return alpha_ok && compact_ok ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,549 @@
+/**
+ * @file sweep.c
+ * @brief Multithreaded parameter-sweep stress harness for smooth_axis tunings
+ * @author Jonatan Vider
+ *
+ * The ramp test renders 25 conditions one by one, with a trace per sample.
+ * This harness runs a full cartesian grid of conditions instead:
+ *
+ *   noise × jitter × settle_time × max_raw × loop rate (× repeats)
+ *
+ * (2880 conditions per repeat by default). Conditions are spread over a
+ * pthread pool, and only per-condition statistics are kept in memory. No
+ * per-sample traces are written.
+ *
+ * Each condition simulates one LIVE_DT axis:
+ *
+ *   hold 10% → ramp 10%→90% over 0.8 s → hold 90% → step to 10% → hold
+ *
+ * and measures:
+ *   - settle error: time until the declared value crosses 95% of the step,
+ *     vs the nominal settle_time (same definition as step_response_test.c)
+ *   - false updates: declared values that move against the input direction
+ *     (the ramp test's monotonicity measure)
+ *   - idle updates: declared values during the settled half of the 90% hold
+ *
+ * Determinism: every condition seeds its own PCG32 stream from (--seed,
+ * condition index). It does not matter which worker runs a condition or in
+ * what order, so results are bit-identical for any --threads value. --quick
+ * runs a small grid single-threaded and multi-threaded and fails if the two
+ * runs differ.
+ *
+ * Usage:
+ *   ./build/sweep                      # Full grid, one thread per online CPU
+ *   ./build/sweep --threads 64 --repeats 4 --csv tests/data/sweep.csv
+ *   ./build/sweep --quick              # Small grid + determinism check (ctest)
+ */
+#define _POSIX_C_SOURCE 200809L  // pthreads, sysconf(), clock_gettime() under strict C99
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "smooth_axis.h"
+
+#ifndef M_PI  // Not provided by strict C99 <math.h>
+#define M_PI 3.14159265358979323846
+#endif
+
+// -----------------------------------------------------------------------------
+// Sweep Grid
+// -----------------------------------------------------------------------------
+
+#define SWEEP_MAX_THREADS 256
+#define SWEEP_DEFAULT_SEED 20251208u
+
+// Scenario timing (seconds)
+#define RAMP_START_SEC    0.2f
+#define RAMP_DURATION_SEC 0.8f
+#define MIN_HOLD_SEC      0.5f   // Each hold lasts max(MIN_HOLD_SEC, HOLD_SETTLES x settle_time)
+#define HOLD_SETTLES      4.0f
+#define LOW_FRAC          0.10f
+#define HIGH_FRAC         0.90f
+#define SETTLE_FRACTION   0.95f
+
+typedef struct {
+  const float    *noise;      size_t num_noise;     // Gaussian noise, ±3σ as a fraction of max_raw
+  const float    *jitter;     size_t num_jitter;    // Uniform dt jitter, fraction of the nominal dt
+  const float    *settle;     size_t num_settle;    // settle_time_sec
+  const uint16_t *max_raw;    size_t num_max_raw;
+  const float    *rate_hz;    size_t num_rate;      // Nominal loop rate
+  size_t          repeats;                          // Seeds per condition
+} sweep_grid_t;
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static const float    FULL_NOISE[]   = { 0.000f, 0.005f, 0.015f, 0.040f, 0.100f };
+static const float    FULL_JITTER[]  = { 0.000f, 0.010f, 0.020f, 0.050f, 0.100f, 0.250f };
+static const float    FULL_SETTLE[]  = { 0.02f, 0.05f, 0.10f, 0.20f, 0.50f, 1.00f };
+static const uint16_t FULL_MAX_RAW[] = { 255, 1023, 4095, 16383 };
+static const float    FULL_RATE[]    = { 250.0f, 1000.0f, 4000.0f, 10000.0f };
+
+static const float    QUICK_NOISE[]   = { 0.000f, 0.040f };
+static const float    QUICK_JITTER[]  = { 0.000f, 0.050f };
+static const float    QUICK_SETTLE[]  = { 0.05f, 0.20f };
+static const uint16_t QUICK_MAX_RAW[] = { 1023 };
+static const float    QUICK_RATE[]    = { 1000.0f };
+
+#define GRID_OF(prefix, reps) {                                   \
+    prefix##_NOISE,   COUNT_OF(prefix##_NOISE),                   \
+    prefix##_JITTER,  COUNT_OF(prefix##_JITTER),                  \
+    prefix##_SETTLE,  COUNT_OF(prefix##_SETTLE),                  \
+    prefix##_MAX_RAW, COUNT_OF(prefix##_MAX_RAW),                 \
+    prefix##_RATE,    COUNT_OF(prefix##_RATE),                    \
+    (reps) }
+
+typedef struct {
+  float    noise_frac;
+  float    jitter_frac;
+  float    settle_sec;
+  uint16_t max_raw;
+  float    rate_hz;
+  uint32_t repeat;
+} sweep_condition_t;
+
+typedef struct {
+  float    measured_ms;    // 95% crossing after the step (valid unless timed_out)
+  float    error_pct;      // (measured - nominal) / nominal
+  uint32_t samples;
+  uint32_t updates;        // Declared values over the whole run
+  uint32_t false_updates;  // Declared values moving against the input direction
+  uint32_t idle_updates;   // Declared values while settled on a constant input
+  bool     timed_out;
+} sweep_result_t;
+
+static size_t grid_size(const sweep_grid_t *g) {
+    return g->num_noise * g->num_jitter * g->num_settle * g->num_max_raw * g->num_rate * g->repeats;
+}
+
+// Index order: repeat fastest, then rate, max_raw, settle, jitter, noise
+static sweep_condition_t grid_condition(const sweep_grid_t *g, size_t index) {
+    sweep_condition_t c;
+    c.repeat      = (uint32_t)(index % g->repeats);    index /= g->repeats;
+    c.rate_hz     = g->rate_hz[index % g->num_rate];   index /= g->num_rate;
+    c.max_raw     = g->max_raw[index % g->num_max_raw]; index /= g->num_max_raw;
+    c.settle_sec  = g->settle[index % g->num_settle];  index /= g->num_settle;
+    c.jitter_frac = g->jitter[index % g->num_jitter];  index /= g->num_jitter;
+    c.noise_frac  = g->noise[index];
+    return c;
+}
+
+// -----------------------------------------------------------------------------
+// Random Number Generator (PCG32, one stream per condition)
+// -----------------------------------------------------------------------------
+
+typedef struct {
+  uint64_t state;
+  uint64_t inc;  // Stream selector (odd)
+} sweep_rng_t;
+
+static uint32_t rng_next(sweep_rng_t *r) {
+    uint64_t old = r->state;
+    r->state     = old * 6364136223846793005ull + r->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot        = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+}
+
+static void rng_seed(sweep_rng_t *r, uint64_t seed, uint64_t stream) {
+    r->state = 0;
+    r->inc   = (stream << 1) | 1u;
+    rng_next(r);
+    r->state += seed;
+    rng_next(r);
+}
+
+// [0, 1)
+static float rng_uniform01(sweep_rng_t *r) {
+    return (float)(rng_next(r) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Standard normal N(0,1), Box-Muller
+static float rng_normal01(sweep_rng_t *r) {
+    float u1 = rng_uniform01(r);
+    if (u1 < 1e-7f) { u1 = 1e-7f; }
+    float u2 = rng_uniform01(r);
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * (float)M_PI * u2);
+}
+
+// -----------------------------------------------------------------------------
+// One Condition
+// -----------------------------------------------------------------------------
+
+static float scenario_clean_frac(float t, float t_step) {
+    if (t >= t_step) { return LOW_FRAC; }
+    if (t <= RAMP_START_SEC) { return LOW_FRAC; }
+    if (t >= RAMP_START_SEC + RAMP_DURATION_SEC) { return HIGH_FRAC; }
+    float u = (t - RAMP_START_SEC) / RAMP_DURATION_SEC;
+    return LOW_FRAC + u * (HIGH_FRAC - LOW_FRAC);
+}
+
+static sweep_result_t run_condition(const sweep_condition_t *c, sweep_rng_t *rng) {
+    sweep_result_t r;
+    memset(&r, 0, sizeof(r));
+    r.timed_out = true;
+
+    smooth_axis_config_t cfg;
+    smooth_axis_config_live_dt(&cfg, c->max_raw, c->settle_sec);
+    cfg.sticky_zone_norm = 0.0f;  // Linear output: get_norm() == raw / max_raw once settled
+    cfg.full_off_norm    = 0.0f;
+    cfg.full_on_norm     = 1.0f;
+
+    smooth_axis_t axis;
+    smooth_axis_init(&axis, &cfg);
+
+    float hold      = fmaxf(MIN_HOLD_SEC, HOLD_SETTLES * c->settle_sec);
+    float ramp_end  = RAMP_START_SEC + RAMP_DURATION_SEC;
+    float t_step    = ramp_end + hold;
+    float idle_from = ramp_end + 0.5f * hold;
+    float t_end     = t_step + hold;
+    float dt_nom    = 1.0f / c->rate_hz;
+    float sigma     = (c->noise_frac / 3.0f) * (float)c->max_raw;
+    float thresh_95 = HIGH_FRAC - SETTLE_FRACTION * (HIGH_FRAC - LOW_FRAC);
+
+    float last_reported = 0.0f;
+    bool  any_reported  = false;
+    float t             = 0.0f;
+
+    for (uint32_t i = 0; t < t_end; i++) {
+        float dt = dt_nom;
+        if (c->jitter_frac > 0.0f) {
+            dt = dt_nom * (1.0f + (rng_uniform01(rng) * 2.0f - 1.0f) * c->jitter_frac);
+            if (dt < dt_nom * 0.1f) { dt = dt_nom * 0.1f; }
+        }
+
+        float val = scenario_clean_frac(t, t_step) * (float)c->max_raw;
+        if (sigma > 0.0f && i > 0) {  // Keep first sample clean to seed filter
+            val += sigma * rng_normal01(rng);
+            if (val < 0.0f) { val = 0.0f; }
+            if (val > (float)c->max_raw) { val = (float)c->max_raw; }
+        }
+
+        smooth_axis_update_live_dt(&axis, (uint16_t)(val + 0.5f), dt);
+        r.samples++;
+
+        if (smooth_axis_has_new_value(&axis)) {
+            float out = smooth_axis_get_norm(&axis);
+            r.updates++;
+
+            // Rising until the step, falling after it
+            if (any_reported && (t < t_step ? out < last_reported : out > last_reported)) {
+                r.false_updates++;
+            }
+            if (t >= idle_from && t < t_step) { r.idle_updates++; }
+            if (r.timed_out && t >= t_step && out <= thresh_95) {
+                r.timed_out   = false;
+                r.measured_ms = (t - t_step) * 1000.0f;
+            }
+            last_reported = out;
+            any_reported  = true;
+        }
+        t += dt;
+    }
+
+    if (!r.timed_out) {
+        float nominal_ms = c->settle_sec * 1000.0f;
+        r.error_pct      = (r.measured_ms - nominal_ms) / nominal_ms * 100.0f;
+    }
+    return r;
+}
+
+// -----------------------------------------------------------------------------
+// Thread Pool
+// -----------------------------------------------------------------------------
+
+typedef struct {
+  const sweep_grid_t *grid;
+  sweep_result_t     *results;  // One slot per condition, written by exactly one worker
+  size_t              count;
+  size_t              next;     // Next unclaimed condition (guarded by lock)
+  uint64_t            seed;
+  pthread_mutex_t     lock;
+} sweep_job_t;
+
+static void *sweep_worker(void *arg) {
+    sweep_job_t *job = (sweep_job_t *)arg;
+    sweep_rng_t  rng;  // Per-thread generator, re-seeded for every condition
+
+    for (;;) {
+        pthread_mutex_lock(&job->lock);
+        size_t index = job->next++;
+        pthread_mutex_unlock(&job->lock);
+        if (index >= job->count) { break; }
+
+        sweep_condition_t c = grid_condition(job->grid, index);
+        rng_seed(&rng, job->seed, (uint64_t)index);
+        job->results[index] = run_condition(&c, &rng);
+    }
+    return NULL;
+}
+
+/** @return false if no worker thread could be started */
+static bool sweep_run(const sweep_grid_t *grid,
+                      sweep_result_t *results,
+                      uint64_t seed,
+                      size_t num_threads) {
+    sweep_job_t job;
+    job.grid    = grid;
+    job.results = results;
+    job.count   = grid_size(grid);
+    job.next    = 0;
+    job.seed    = seed;
+    pthread_mutex_init(&job.lock, NULL);
+
+    if (num_threads > job.count) { num_threads = job.count; }
+
+    pthread_t threads[SWEEP_MAX_THREADS];
+    size_t    started = 0;
+    for (size_t i = 0; i < num_threads; i++) {
+        if (pthread_create(&threads[i], NULL, sweep_worker, &job) != 0) { break; }
+        started++;
+    }
+    if (started > 0 && started < num_threads) {
+        fprintf(stderr, "Warning: started %u of %u threads\n", (unsigned)started, (unsigned)num_threads);
+    }
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&job.lock);
+    return started > 0;
+}
+
+// -----------------------------------------------------------------------------
+// Reporting
+// -----------------------------------------------------------------------------
+
+typedef struct {
+  size_t   runs;
+  size_t   timeouts;
+  double   sum_abs_error_pct;
+  double   max_abs_error_pct;
+  uint64_t updates;
+  uint64_t false_updates;
+  uint64_t idle_updates;
+  uint64_t samples;
+} sweep_stats_t;
+
+static void stats_add(sweep_stats_t *s, const sweep_result_t *r) {
+    s->runs++;
+    s->updates       += r->updates;
+    s->false_updates += r->false_updates;
+    s->idle_updates  += r->idle_updates;
+    s->samples       += r->samples;
+    if (r->timed_out) {
+        s->timeouts++;
+        return;
+    }
+    double e = fabs((double)r->error_pct);
+    s->sum_abs_error_pct += e;
+    if (e > s->max_abs_error_pct) { s->max_abs_error_pct = e; }
+}
+
+static void stats_print_row(const char *label, const sweep_stats_t *s) {
+    size_t timed = s->runs - s->timeouts;
+    printf("  %-14s %6u runs  MAPE %7.2f%%  max %7.2f%%  timeouts %4u  "
+           "monotonic %8.4f%%  idle/run %6.2f\n",
+           label,
+           (unsigned)s->runs,
+           timed ? s->sum_abs_error_pct / (double)timed : 0.0,
+           s->max_abs_error_pct,
+           (unsigned)s->timeouts,
+           s->updates ? 100.0 * (1.0 - (double)s->false_updates / (double)s->updates) : 100.0,
+           s->runs ? (double)s->idle_updates / (double)s->runs : 0.0);
+}
+
+typedef enum { DIM_NOISE, DIM_JITTER, DIM_SETTLE, DIM_MAX_RAW, DIM_RATE } sweep_dim_t;
+
+// Aggregate all conditions that share one value of `dim`, one row per value
+static void print_breakdown(const sweep_grid_t *g, const sweep_result_t *results, sweep_dim_t dim) {
+    static const char *titles[] = { "noise", "jitter", "settle_time", "max_raw", "loop rate" };
+    size_t n = dim == DIM_NOISE ? g->num_noise : dim == DIM_JITTER ? g->num_jitter
+             : dim == DIM_SETTLE ? g->num_settle : dim == DIM_MAX_RAW ? g->num_max_raw
+             : g->num_rate;
+    if (n < 2) { return; }
+
+    printf("\nBy %s:\n", titles[dim]);
+    for (size_t v = 0; v < n; v++) {
+        sweep_stats_t s;
+        memset(&s, 0, sizeof(s));
+
+        char label[32];
+        switch (dim) {
+            case DIM_NOISE:   snprintf(label, sizeof(label), "%.1f%%", g->noise[v] * 100.0f); break;
+            case DIM_JITTER:  snprintf(label, sizeof(label), "%.1f%%", g->jitter[v] * 100.0f); break;
+            case DIM_SETTLE:  snprintf(label, sizeof(label), "%.0f ms", g->settle[v] * 1000.0f); break;
+            case DIM_MAX_RAW: snprintf(label, sizeof(label), "%u", g->max_raw[v]); break;
+            default:          snprintf(label, sizeof(label), "%.0f Hz", g->rate_hz[v]); break;
+        }
+
+        for (size_t i = 0; i < grid_size(g); i++) {
+            sweep_condition_t c = grid_condition(g, i);
+            bool match = dim == DIM_NOISE ? c.noise_frac == g->noise[v]
+                       : dim == DIM_JITTER ? c.jitter_frac == g->jitter[v]
+                       : dim == DIM_SETTLE ? c.settle_sec == g->settle[v]
+                       : dim == DIM_MAX_RAW ? c.max_raw == g->max_raw[v]
+                       : c.rate_hz == g->rate_hz[v];
+            if (match) { stats_add(&s, &results[i]); }
+        }
+        stats_print_row(label, &s);
+    }
+}
+
+static bool write_csv(const char *path, const sweep_grid_t *g, const sweep_result_t *results) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror("Failed to open CSV file");
+        return false;
+    }
+
+    fprintf(f, "noise_frac,jitter_frac,settle_ms,max_raw,rate_hz,repeat,"
+               "measured_ms,error_pct,timed_out,samples,updates,false_updates,idle_updates\n");
+    for (size_t i = 0; i < grid_size(g); i++) {
+        sweep_condition_t     c = grid_condition(g, i);
+        const sweep_result_t *r = &results[i];
+        fprintf(f, "%.4f,%.4f,%.0f,%u,%.0f,%u,",
+                c.noise_frac, c.jitter_frac, c.settle_sec * 1000.0f,
+                c.max_raw, c.rate_hz, (unsigned)c.repeat);
+        if (r->timed_out) {
+            fprintf(f, "N/A,N/A,1,");
+        } else {
+            fprintf(f, "%.3f,%.3f,0,", r->measured_ms, r->error_pct);
+        }
+        fprintf(f, "%u,%u,%u,%u\n",
+                (unsigned)r->samples, (unsigned)r->updates,
+                (unsigned)r->false_updates, (unsigned)r->idle_updates);
+    }
+
+    return fclose(f) == 0;
+}
+
+// Field by field: struct copies need not preserve padding, so no memcmp()
+static bool results_equal(const sweep_result_t *a, const sweep_result_t *b, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (a[i].measured_ms != b[i].measured_ms || a[i].error_pct != b[i].error_pct ||
+            a[i].samples != b[i].samples || a[i].updates != b[i].updates ||
+            a[i].false_updates != b[i].false_updates || a[i].idle_updates != b[i].idle_updates ||
+            a[i].timed_out != b[i].timed_out) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// -----------------------------------------------------------------------------
+// Entry Point
+// -----------------------------------------------------------------------------
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [--quick] [--threads N] [--repeats N] [--seed S] [--csv PATH]\n",
+            argv0);
+}
+
+int main(int argc, char **argv) {
+    bool        quick    = false;
+    long        threads  = sysconf(_SC_NPROCESSORS_ONLN);
+    long        repeats  = 1;
+    uint64_t    seed     = SWEEP_DEFAULT_SEED;
+    const char *csv_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && has_val) {
+            threads = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--repeats") == 0 && has_val) {
+            repeats = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && has_val) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--csv") == 0 && has_val) {
+            csv_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (threads < 1) { threads = 1; }
+    if (threads > SWEEP_MAX_THREADS) { threads = SWEEP_MAX_THREADS; }
+    if (quick && threads < 4) { threads = 4; }  // Determinism check needs real interleaving
+    if (repeats < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    sweep_grid_t full_grid  = GRID_OF(FULL, (size_t)repeats);
+    sweep_grid_t quick_grid = GRID_OF(QUICK, (size_t)repeats);
+    const sweep_grid_t *grid = quick ? &quick_grid : &full_grid;
+    size_t count = grid_size(grid);
+
+    sweep_result_t *results = (sweep_result_t *)calloc(count, sizeof(*results));
+    if (!results) {
+        fprintf(stderr, "ERROR: Cannot allocate %u results\n", (unsigned)count);
+        return 1;
+    }
+
+    printf("=== smooth_axis parameter sweep ===\n");
+    printf("  %u conditions (%u noise x %u jitter x %u settle x %u max_raw x %u rate x %u repeats)\n",
+           (unsigned)count, (unsigned)grid->num_noise, (unsigned)grid->num_jitter,
+           (unsigned)grid->num_settle, (unsigned)grid->num_max_raw,
+           (unsigned)grid->num_rate, (unsigned)grid->repeats);
+    printf("  %ld threads, seed %llu\n", threads, (unsigned long long)seed);
+
+    double t0 = now_sec();
+    if (!sweep_run(grid, results, seed, (size_t)threads)) {
+        fprintf(stderr, "ERROR: Cannot start worker threads\n");
+        free(results);
+        return 1;
+    }
+    double elapsed = now_sec() - t0;
+
+    sweep_stats_t total;
+    memset(&total, 0, sizeof(total));
+    for (size_t i = 0; i < count; i++) { stats_add(&total, &results[i]); }
+
+    printf("  %.3f s wall, %.0f conditions/s, %.1f M samples/s\n",
+           elapsed, (double)count / elapsed, (double)total.samples / elapsed * 1e-6);
+
+    printf("\nOverall:\n");
+    stats_print_row("all", &total);
+    print_breakdown(grid, results, DIM_NOISE);
+    print_breakdown(grid, results, DIM_JITTER);
+    print_breakdown(grid, results, DIM_SETTLE);
+    print_breakdown(grid, results, DIM_MAX_RAW);
+    print_breakdown(grid, results, DIM_RATE);
+
+    int status = 0;
+    if (csv_path) {
+        if (write_csv(csv_path, grid, results)) {
+            printf("\nPer-condition results written to %s\n", csv_path);
+        } else {
+            status = 1;
+        }
+    }
+
+    // Same grid on one thread: must match bit for bit
+    if (quick) {
+        sweep_result_t *serial = (sweep_result_t *)calloc(count, sizeof(*serial));
+        bool same = serial && sweep_run(grid, serial, seed, 1)
+                    && results_equal(serial, results, count);
+        printf("\nDeterminism (%ld threads vs 1): %s\n", threads, same ? "OK" : "FAIL");
+        if (!same) { status = 1; }
+        free(serial);
+    }
+
+    free(results);
+    return status;
+}
@@ -6,19 +6,30 @@
  * Enhanced test suite covering NULL safety, mode mismatches, edge cases, boundary conditions,
  * reset validation, output quantization, uninitialized state, and critical corner cases.
  *
- * Compile with:
- *   gcc -o test_api -DNDEBUG -I./include ./tests/test_api_sanity.c ./src/smooth_axis.c -lm
+ * Compile with (release argument checks, without NDEBUG so the suite's own
+ * assert()s still run):
+ *   gcc -o test_api -DSMOOTH_AXIS_CHECK_LEVEL=1 -I./src ./tests/c_tests/test_api_sanity_enhanced.c ./src/smooth_axis*.c -lm
  *
  * Run:
  *   ./test_api
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
 #include <stdbool.h>
 #include "smooth_axis.h"
+#include "smooth_axis_bank.h"
+#include "smooth_axis_events.h"
+#include "smooth_axis_spsc.h"
+#include "smooth_axis_shared.h"
+#include "smooth_axis_compact.h"
+#include "smooth_axis_vec.h"
+#include "smooth_axis_wcet.h"
+#include "smooth_axis_sched.h"
+#include "smooth_axis_static.h"
 
 // ============================================================================
 // Test Helpers
@@ -51,9 +62,9 @@ static bool float_eq(float a, float b, float epsilon) {
 // ============================================================================
 
 void test_null_safety_release_mode(void) {
-#ifdef NDEBUG
+#if SMOOTH_AXIS_CHECK_LEVEL == 1
     // All these should return early without crashing in release builds
-    // In debug builds, they would assert, so we skip this test
+    // In debug builds (check level 2), they would assert, so we skip this test
     
     smooth_axis_config_auto_dt(NULL, 1023, 0.25f, test_timer);
     smooth_axis_config_live_dt(NULL, 1023, 0.25f);
@@ -802,18 +813,1668 @@ void test_diagnostic_functions(void) {
     printf("✓ Test 29: Diagnostic functions\n");
 }
 
+// ============================================================================
+// Test 30-32: Multi-axis bank
+// ============================================================================
+
+#define BANK_TEST_AXES 19  // Not a multiple of the vector width: covers the scalar tail
+
+void test_bank_matches_independent_axes_live_dt(void) {
+#if SMOOTH_AXIS_FIXED_POINT
+    printf("⊘ Test 30: Bank (LIVE_DT) vs independent axes (skipped: bank is float, axes are fixed-point)\n");
+#else
+    smooth_axis_config_t cfg;
+    smooth_axis_t        axes[BANK_TEST_AXES];
+    static smooth_axis_bank_t bank;
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.25f);
+    smooth_axis_bank_init(&bank, &cfg, BANK_TEST_AXES);
+    for (int a = 0; a < BANK_TEST_AXES; a++) {
+        smooth_axis_init(&axes[a], &cfg);
+    }
+    
+    // Per-axis ramps with alternating noise: exercises EMA, sign flips and sticky zones
+    uint16_t raw[BANK_TEST_AXES];
+    int      reports = 0;
+    for (int i = 0; i < 2000; i++) {
+        for (int a = 0; a < BANK_TEST_AXES; a++) {
+            int value = (i * (a + 1)) % 1100 - 40 + ((i + a) % 3 - 1) * 4;
+            raw[a] = (uint16_t)(value < 0 ? 0 : (value > 1023 ? 1023 : value));
+            smooth_axis_update_live_dt(&axes[a], raw[a], 0.001f);
+        }
+        smooth_axis_bank_update_live_dt(&bank, raw, BANK_TEST_AXES, 0.001f);
+        
+        for (int a = 0; a < BANK_TEST_AXES; a++) {
+            bool single_new = smooth_axis_has_new_value(&axes[a]);
+            bool bank_new   = smooth_axis_bank_has_new_value(&bank, (size_t)a);
+            assert(single_new == bank_new);
+            assert(smooth_axis_get_norm(&axes[a]) == smooth_axis_bank_get_norm(&bank, (size_t)a));
+            assert(smooth_axis_get_u16(&axes[a]) == smooth_axis_bank_get_u16(&bank, (size_t)a));
+            assert(smooth_axis_get_noise_norm(&axes[a]) ==
+                   smooth_axis_bank_get_noise_norm(&bank, (size_t)a));
+            reports += bank_new ? 1 : 0;
+        }
+    }
+    
+    printf("✓ Test 30: Bank (LIVE_DT) matches %d independent axes bit-for-bit (%d reports)\n",
+           BANK_TEST_AXES, reports);
+#endif
+}
+
+void test_bank_matches_independent_axes_auto_dt(void) {
+#if SMOOTH_AXIS_FIXED_POINT
+    printf("⊘ Test 31: Bank (AUTO_DT) vs independent axes (skipped: bank is float, axes are fixed-point)\n");
+#else
+    smooth_axis_config_t cfg;
+    smooth_axis_t        axes[BANK_TEST_AXES];
+    static smooth_axis_bank_t bank;
+    
+    // Bank and axes read the same clock: advance once per scan, no reads in between
+    reset_timer();
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.25f, test_timer);
+    smooth_axis_bank_init(&bank, &cfg, BANK_TEST_AXES);
+    for (int a = 0; a < BANK_TEST_AXES; a++) {
+        smooth_axis_init(&axes[a], &cfg);
+    }
+    
+    uint16_t raw[BANK_TEST_AXES];
+    for (int i = 0; i < 400; i++) {
+        advance_time_ms((i % 2) ? 4 : 6);
+        for (int a = 0; a < BANK_TEST_AXES; a++) {
+            raw[a] = (uint16_t)((i < 300) ? 100 + a * 50 : 900 - a * 40);
+            smooth_axis_update_auto_dt(&axes[a], raw[a]);
+        }
+        smooth_axis_bank_update_auto_dt(&bank, raw, BANK_TEST_AXES);
+    }
+    
+    for (int a = 0; a < BANK_TEST_AXES; a++) {
+        assert(smooth_axis_get_norm(&axes[a]) == smooth_axis_bank_get_norm(&bank, (size_t)a));
+        bool axis_new = smooth_axis_has_new_value(&axes[a]);
+        bool bank_new = smooth_axis_bank_has_new_value(&bank, (size_t)a);
+        assert(axis_new == bank_new);
+    }
+    
+    printf("✓ Test 31: Bank (AUTO_DT) shares one warmup and matches independent axes\n");
+#endif
+}
+
+void test_bank_bounds_and_mode(void) {
+    smooth_axis_config_t cfg;
+    static smooth_axis_bank_t bank;
+    uint16_t raw[4] = { 0, 300, 700, 1023 };
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.25f);
+    smooth_axis_bank_init(&bank, &cfg, 4);
+    
+    // Before any sample: everything reads as zero, nothing to report
+    assert(smooth_axis_bank_get_u16(&bank, 2) == 0);
+    bool has_new = smooth_axis_bank_has_new_value(&bank, 2);
+    assert(has_new == false);
+    
+    // Wrong mode is a no-op (release), first sample teleports
+    smooth_axis_bank_update_auto_dt(&bank, raw, 4);
+    assert(smooth_axis_bank_get_u16(&bank, 3) == 0);
+    smooth_axis_bank_update_live_dt(&bank, raw, 4, 0.016f);
+    assert(smooth_axis_bank_get_u16(&bank, 0) == 0);
+    assert(smooth_axis_bank_get_u16(&bank, 3) == 1023);
+    
+    // Out-of-range index returns safe defaults
+    assert(smooth_axis_bank_get_u16(&bank, 4) == 0);
+    assert(smooth_axis_bank_get_norm(&bank, 99) == 0.0f);
+    assert(smooth_axis_bank_get_noise_norm(NULL, 0) == 0.0f);
+#if SMOOTH_AXIS_CHECK_LEVEL == 1
+    has_new = smooth_axis_bank_has_new_value(&bank, 4);
+    assert(has_new == false);
+    has_new = smooth_axis_bank_has_new_value(NULL, 0);
+    assert(has_new == false);
+    smooth_axis_bank_update_live_dt(&bank, raw, 3, 0.016f);  // Count mismatch: ignored
+    smooth_axis_bank_update_live_dt(NULL, raw, 4, 0.016f);
+#endif
+    
+    printf("✓ Test 32: Bank bounds, mode and NULL safety\n");
+}
+
+// ============================================================================
+// Test 33-34: Settle-time and monotonicity guarantees (float and fixed-point builds)
+// ============================================================================
+
+static uint32_t test_rng_state = 1u;
+
+static float test_rand_uniform01(void) {
+    test_rng_state = test_rng_state * 1664525u + 1013904223u;
+    return (float)(test_rng_state >> 8) / (float)0xFFFFFFu;
+}
+
+void test_guarantee_step_settle_time(void) {
+    static const float settle_times[] = { 0.05f, 0.2f, 1.0f };
+    
+    for (size_t s = 0; s < sizeof(settle_times) / sizeof(settle_times[0]); s++) {
+        smooth_axis_config_t cfg;
+        smooth_axis_t        axis;
+        
+        smooth_axis_config_live_dt(&cfg, 1023, settle_times[s]);
+        cfg.sticky_zone_norm = 0.0f;
+        smooth_axis_init(&axis, &cfg);
+        
+        // Step 900 → 100 at 10 kHz; settled once the declared value crosses 95% (140)
+        const float dt       = 0.0001f;
+        float       settle_t = -1.0f;
+        uint16_t    last_out = 900;
+        int         steps    = (int)((settle_times[s] * 2.0f) / dt);
+        
+        smooth_axis_update_live_dt(&axis, 900, dt);
+        smooth_axis_has_new_value(&axis);
+        for (int i = 1; i <= steps; i++) {
+            smooth_axis_update_live_dt(&axis, 100, dt);
+            if (smooth_axis_has_new_value(&axis)) {
+                uint16_t out = smooth_axis_get_u16(&axis);
+                assert(out <= last_out);  // Monotonic: never reverses during the transition
+                last_out = out;
+                if (settle_t < 0.0f && out <= 140) { settle_t = (float)i * dt; }
+            }
+        }
+        
+        float error_pct = (settle_t - settle_times[s]) / settle_times[s] * 100.0f;
+        printf("   settle %.0fms: measured %.2fms (%.2f%% error)\n",
+               settle_times[s] * 1000.0f, settle_t * 1000.0f, error_pct);
+        assert(settle_t > 0.0f);
+        assert(fabsf(error_pct) < 3.0f);
+    }
+    
+    printf("✓ Test 33: Step response settles on time and monotonically\n");
+}
+
+void test_guarantee_noisy_ramp_monotonic(void) {
+    smooth_axis_config_t cfg;
+    smooth_axis_t        axis;
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.2f);
+    smooth_axis_init(&axis, &cfg);
+    test_rng_state = 1234u;
+    
+    // Ramp 102 → 921 over 0.8s at 1 kHz with ±1.5% noise and 2% jitter ("common" profile)
+    uint16_t last_out     = 0;
+    int      reports      = 0;
+    int      false_update = 0;
+    for (int i = 0; i < 3000; i++) {
+        float    u     = (i < 200) ? 0.0f : (i > 1000 ? 1.0f : (float)(i - 200) / 800.0f);
+        float    clean = 102.0f + u * 819.0f;
+        float    noise = (test_rand_uniform01() * 2.0f - 1.0f) * 0.015f * 1023.0f;
+        float    dt    = 0.001f * (1.0f + (test_rand_uniform01() * 2.0f - 1.0f) * 0.02f);
+        float    value = clean + (i > 0 ? noise : 0.0f);
+        uint16_t raw   = (uint16_t)(value < 0.0f ? 0.0f : (value > 1023.0f ? 1023.0f : value));
+        
+        smooth_axis_update_live_dt(&axis, raw, dt);
+        if (smooth_axis_has_new_value(&axis)) {
+            uint16_t out = smooth_axis_get_u16(&axis);
+            if (reports > 0 && out < last_out) { false_update++; }
+            last_out = out;
+            reports++;
+        }
+    }
+    
+    assert(false_update == 0);
+    assert(last_out > 880);  // Tracked the ramp to its end
+    
+    printf("✓ Test 34: Noisy ramp - %d reports, 0 reversals\n", reports);
+}
+
+// ============================================================================
+// Test 35: Block (DMA buffer) update
+// ============================================================================
+
+void test_block_update_matches_sequential(void) {
+    static const size_t block_sizes[] = { 1, 32, 7, 0, 128, 64 };
+    smooth_axis_config_t cfg;
+    smooth_axis_t        seq, blk;
+    uint16_t             buf[128];
+    
+    smooth_axis_config_live_dt(&cfg, 4095, 0.1f);
+    smooth_axis_init(&seq, &cfg);
+    smooth_axis_init(&blk, &cfg);
+    test_rng_state = 42u;
+    
+    int sample = 0;
+    for (int round = 0; round < 20; round++) {
+        for (size_t b = 0; b < sizeof(block_sizes) / sizeof(block_sizes[0]); b++) {
+            size_t n  = block_sizes[b];
+            float  dt = (b % 2) ? 0.00025f : 0.0005f;  // Alpha changes between blocks
+            
+            // Noisy slow sweep with a step halfway: movement, noise and sticky zones
+            for (size_t i = 0; i < n; i++, sample++) {
+                float value = (sample < 4000 ? (float)sample : 4095.0f - (float)(sample - 4000))
+                              + (test_rand_uniform01() - 0.5f) * 60.0f;
+                buf[i] = (uint16_t)(value < 0.0f ? 0.0f : (value > 4095.0f ? 4095.0f : value));
+                smooth_axis_update_live_dt(&seq, buf[i], dt);
+            }
+            smooth_axis_update_block(&blk, buf, n, dt);
+            
+            assert(smooth_axis_get_norm(&seq) == smooth_axis_get_norm(&blk));
+            assert(smooth_axis_get_noise_norm(&seq) == smooth_axis_get_noise_norm(&blk));
+            bool seq_new = smooth_axis_has_new_value(&seq);
+            bool blk_new = smooth_axis_has_new_value(&blk);
+            assert(seq_new == blk_new);
+        }
+    }
+    
+#if SMOOTH_AXIS_CHECK_LEVEL == 1
+    // Wrong mode and NULL buffer are no-ops
+    smooth_axis_t auto_axis;
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.1f, test_timer);
+    smooth_axis_init(&auto_axis, &cfg);
+    smooth_axis_update_block(&auto_axis, buf, 8, 0.001f);
+    assert(smooth_axis_get_u16(&auto_axis) == 0);
+    smooth_axis_update_block(&blk, NULL, 8, 0.001f);
+    smooth_axis_update_block(NULL, buf, 8, 0.001f);
+#endif
+    
+    printf("✓ Test 35: Block update matches %d sequential updates bit-for-bit\n", sample);
+}
+
+// ============================================================================
+// Test 36: ISR producer / main-loop consumer channel
+// ============================================================================
+
+void test_spsc_matches_direct_polling(void) {
+    smooth_axis_config_t  cfg;
+    smooth_axis_t         isr_axis, twin;
+    smooth_axis_spsc_t    chan;
+    smooth_axis_reading_t r;
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.05f);
+    smooth_axis_init(&isr_axis, &cfg);
+    smooth_axis_init(&twin, &cfg);
+    smooth_axis_spsc_init(&chan, &isr_axis);
+    
+    // Nothing published yet
+    bool published = smooth_axis_spsc_read(&chan, &r);
+    assert(!published && r.u16 == 0 && r.has_new == false);
+    
+    // Producer updates every tick; consumer polls every 3rd tick, twin polls directly
+    test_rng_state = 7u;
+    int reports = 0;
+    for (int i = 0; i < 3000; i++) {
+        float    value = 512.0f + 400.0f * sinf((float)i * 0.004f)
+                         + (test_rand_uniform01() - 0.5f) * 20.0f;
+        uint16_t raw   = (uint16_t)value;
+        smooth_axis_update_live_dt(&isr_axis, raw, 0.001f);
+        smooth_axis_update_live_dt(&twin, raw, 0.001f);
+        smooth_axis_spsc_publish(&chan);
+        
+        if (i % 3 == 0) {
+            published     = smooth_axis_spsc_read(&chan, &r);
+            bool twin_new = smooth_axis_has_new_value(&twin);
+            assert(published);
+            assert(r.has_new == twin_new);
+            assert(r.norm == smooth_axis_get_norm(&twin));
+            assert(r.u16 == smooth_axis_get_u16(&twin));
+            reports += r.has_new ? 1 : 0;
+        }
+    }
+    
+    // Re-reading without a new publish never reports twice
+    smooth_axis_spsc_read(&chan, &r);
+    published = smooth_axis_spsc_read(&chan, &r);
+    assert(published && r.has_new == false);
+    
+#if SMOOTH_AXIS_CHECK_LEVEL == 1
+    published = smooth_axis_spsc_read(NULL, &r);
+    assert(!published);
+    smooth_axis_spsc_publish(NULL);
+#endif
+    (void)published;
+    
+    printf("✓ Test 36: SPSC channel matches direct polling (%d reports)\n", reports);
+}
+
+// ============================================================================
+// Test 37: Bank change bitmask
+// ============================================================================
+
+void test_bank_change_mask_matches_polling(void) {
+    enum { AXES = 70 };  // Spans three mask words, last one partial
+    smooth_axis_config_t      cfg;
+    static smooth_axis_bank_t polled, masked;
+    uint32_t                  changed[SMOOTH_AXIS_BANK_MASK_WORDS(AXES)] = { 0 };
+    uint16_t                  raw[AXES];
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.1f);
+    smooth_axis_bank_init(&polled, &cfg, AXES);
+    smooth_axis_bank_init(&masked, &cfg, AXES);
+    smooth_axis_bank_set_change_mask(&masked, changed);
+    
+    // Only a few axes move at a time; the rest sit still with light noise
+    int reports = 0;
+    for (int i = 0; i < 1500; i++) {
+        for (int a = 0; a < AXES; a++) {
+            int moving = ((i / 100) % 7) == (a % 7);
+            int value  = moving ? (i % 100) * 10 : 300 + a;
+            raw[a] = (uint16_t)(value + ((i + a) % 2));
+        }
+        smooth_axis_bank_update_live_dt(&polled, raw, AXES, 0.001f);
+        smooth_axis_bank_update_live_dt(&masked, raw, AXES, 0.001f);
+        
+        for (int a = 0; a < AXES; a++) {
+            bool polled_new = smooth_axis_bank_has_new_value(&polled, (size_t)a);
+            bool mask_new   = (changed[a / 32] >> (a % 32)) & 1u;
+            assert(polled_new == mask_new);
+            reports += mask_new ? 1 : 0;
+        }
+        for (size_t w = 0; w < SMOOTH_AXIS_BANK_MASK_WORDS(AXES); w++) { changed[w] = 0; }
+    }
+    assert(reports > 0);
+    
+    printf("✓ Test 37: Bank change mask matches has_new_value() polling (%d reports)\n", reports);
+}
+
+// ============================================================================
+// Test 38: Shared (by-reference) config
+// ============================================================================
+
+void test_shared_config_matches_copied_config(void) {
+    enum { AXES = 8 };
+    smooth_axis_config_t            cfg;
+    static smooth_axis_shared_cfg_t shared;
+    smooth_axis_shared_t            lean[AXES];
+    smooth_axis_t                   full[AXES];
+    
+    smooth_axis_config_live_dt(&cfg, 4095, 0.15f);
+    cfg.full_off_norm    = 0.02f;
+    cfg.sticky_zone_norm = 0.01f;
+    smooth_axis_shared_cfg_init(&shared, &cfg);
+    for (int a = 0; a < AXES; a++) {
+        smooth_axis_shared_init(&lean[a], &shared);
+        smooth_axis_init(&full[a], &cfg);
+    }
+    
+    test_rng_state = 99u;
+    int reports = 0;
+    for (int i = 0; i < 2000; i++) {
+        float dt = 0.001f * (1.0f + (test_rand_uniform01() - 0.5f) * 0.1f);
+        for (int a = 0; a < AXES; a++) {
+            float    value = 2048.0f + 2000.0f * sinf((float)(i + a * 100) * 0.003f)
+                             + (test_rand_uniform01() - 0.5f) * 40.0f;
+            uint16_t raw   = (uint16_t)value;
+            if (i == 1200 && a == 3) {  // Reset mid-run on one axis
+                smooth_axis_shared_reset(&lean[a], raw);
+                smooth_axis_reset(&full[a], raw);
+            }
+            smooth_axis_shared_update_live_dt(&lean[a], raw, dt);
+            smooth_axis_update_live_dt(&full[a], raw, dt);
+            
+            bool lean_new = smooth_axis_shared_has_new_value(&lean[a]);
+            bool full_new = smooth_axis_has_new_value(&full[a]);
+            assert(lean_new == full_new);
+            assert(smooth_axis_shared_get_norm(&lean[a]) == smooth_axis_get_norm(&full[a]));
+            assert(smooth_axis_shared_get_u16(&lean[a]) == smooth_axis_get_u16(&full[a]));
+            assert(smooth_axis_shared_get_noise_norm(&lean[a]) == smooth_axis_get_noise_norm(&full[a]));
+            reports += lean_new ? 1 : 0;
+        }
+        assert(i == 0 || shared._live_alpha._dt_sec == dt);  // One alpha per frame for all axes
+    }
+    
+    assert(sizeof(smooth_axis_shared_t) * 3 < sizeof(smooth_axis_t));
+    
+    printf("✓ Test 38: Shared config axes match copied-config axes (%d reports, %u vs %u bytes/axis)\n",
+           reports, (unsigned)sizeof(smooth_axis_shared_t), (unsigned)sizeof(smooth_axis_t));
+}
+
+// ============================================================================
+// Test 39: Precomputed input/output mapping
+// ============================================================================
+
+void test_mapping_exact_endpoints(void) {
+    static const uint16_t max_raws[] = { 255, 1023, 4095, 65535 };
+    static const float    dead_zones[][2] = { { 0.0f, 1.0f }, { 0.02f, 0.98f }, { 0.1f, 0.7f } };
+    
+    for (size_t r = 0; r < sizeof(max_raws) / sizeof(max_raws[0]); r++) {
+        for (size_t d = 0; d < sizeof(dead_zones) / sizeof(dead_zones[0]); d++) {
+            smooth_axis_config_t cfg;
+            smooth_axis_t        axis;
+            uint16_t             max_raw = max_raws[r];
+            
+            smooth_axis_config_live_dt(&cfg, max_raw, 0.1f);
+            cfg.sticky_zone_norm = 0.0f;       // Endpoints must come from the input map alone
+            cfg.full_off_norm    = dead_zones[d][0];
+            cfg.full_on_norm     = dead_zones[d][1];
+            smooth_axis_init(&axis, &cfg);    // Edits after config_*() are picked up here
+            
+            uint16_t on_raw  = (uint16_t)ceilf(dead_zones[d][1] * (float)max_raw);
+            uint16_t off_raw = (uint16_t)floorf(dead_zones[d][0] * (float)max_raw);
+            
+            smooth_axis_reset(&axis, on_raw);
+            assert(smooth_axis_get_norm(&axis) == 1.0f);
+            assert(smooth_axis_get_u16(&axis) == max_raw);
+            smooth_axis_reset(&axis, max_raw);
+            assert(smooth_axis_get_norm(&axis) == 1.0f);
+            
+            smooth_axis_update_live_dt(&axis, off_raw, 10.0f);  // alpha ~1: jump to floor
+            assert(smooth_axis_get_norm(&axis) == 0.0f);
+            assert(smooth_axis_get_u16(&axis) == 0);
+            
+            // Midpoint of the live range maps to the middle of the output
+            uint16_t mid_raw = (uint16_t)((off_raw + on_raw) / 2);
+            smooth_axis_reset(&axis, mid_raw);
+            assert(fabsf(smooth_axis_get_norm(&axis) - 0.5f) < 0.01f);
+        }
+    }
+    
+    printf("✓ Test 39: Precomputed input/output mapping hits exact endpoints\n");
+}
+
+// ============================================================================
+// Test 40: AUTO_DT at kHz loop rates (ms / us timers)
+// ============================================================================
+
+// Largest |norm difference| between a warmed-up AUTO_DT axis and a LIVE_DT axis
+// fed the true dt, over a 900 -> 100 step (both pre-seeded at 900)
+static float auto_vs_live_step_error(smooth_axis_t *auto_axis, uint32_t ticks_per_frame_q8,
+                                     uint32_t *ticks_q8, float dt_sec) {
+    smooth_axis_config_t live_cfg;
+    smooth_axis_t        live;
+    float                max_err = 0.0f;
+    
+    smooth_axis_config_live_dt(&live_cfg, 1023, auto_axis->cfg.settle_time_sec);
+    smooth_axis_init(&live, &live_cfg);
+    smooth_axis_reset(&live, 900);
+    smooth_axis_reset(auto_axis, 900);
+    
+    for (int i = 0; i < 2000; i++) {
+        *ticks_q8 += ticks_per_frame_q8;
+        mock_time_ms = *ticks_q8 >> 8;
+        smooth_axis_update_auto_dt(auto_axis, 100);
+        smooth_axis_update_live_dt(&live, 100, dt_sec);
+        float err = fabsf(smooth_axis_get_norm(auto_axis) - smooth_axis_get_norm(&live));
+        max_err = err > max_err ? err : max_err;
+    }
+    return max_err;
+}
+
+// Warm up an AUTO_DT axis with a loop of `ticks_per_frame_q8` / 256 timer ticks
+static void warm_auto_axis(smooth_axis_t *axis, uint32_t timer_hz, bool tracking,
+                           uint32_t ticks_per_frame_q8, uint32_t *ticks_q8) {
+    smooth_axis_config_t cfg;
+    
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.05f, test_timer);
+    cfg.timer_hz         = timer_hz;
+    cfg.auto_dt_tracking = tracking;
+    smooth_axis_init(axis, &cfg);
+    
+    for (int i = 0; i < 300; i++) {
+        *ticks_q8 += ticks_per_frame_q8;
+        mock_time_ms = *ticks_q8 >> 8;
+        smooth_axis_update_auto_dt(axis, 900);
+    }
+}
+
+void test_auto_dt_fast_loop_timebase(void) {
+    smooth_axis_t axis;
+    uint32_t      ticks_q8;
+    
+    // 8 kHz loop on a millisecond timer: each delta reads 0 or 1 ms
+    ticks_q8 = 1u << 8;
+    warm_auto_axis(&axis, 1000u, false, 256u / 8u, &ticks_q8);
+    float err_ms = auto_vs_live_step_error(&axis, 256u / 8u, &ticks_q8, 1.0f / 8000.0f);
+    assert(err_ms < 0.01f);
+    
+    // Same loop on a microsecond timer (125 ticks per frame)
+    ticks_q8 = 1u << 8;
+    warm_auto_axis(&axis, 1000000u, false, 125u << 8, &ticks_q8);
+    float err_us = auto_vs_live_step_error(&axis, 125u << 8, &ticks_q8, 1.0f / 8000.0f);
+    assert(err_us < 1e-3f);
+    
+    printf("✓ Test 40: AUTO_DT warmup measures 8 kHz loops (ms err %.4f, us err %.5f)\n",
+           err_ms, err_us);
+}
+
+// ============================================================================
+// Test 41: AUTO_DT loop-rate tracking after warmup
+// ============================================================================
+
+void test_auto_dt_tracking_follows_rate_change(void) {
+    smooth_axis_t fixed, tracked;
+    uint32_t      ticks_fixed = 1u << 8, ticks_tracked = 1u << 8;
+    
+    // Warm up at 1 kHz on a microsecond timer, then the loop speeds up to 2 kHz
+    warm_auto_axis(&fixed, 1000000u, false, 1000u << 8, &ticks_fixed);
+    warm_auto_axis(&tracked, 1000000u, true, 1000u << 8, &ticks_tracked);
+    
+    for (int i = 0; i < 40 * SMOOTH_AXIS_DT_TRACK_FRAMES; i++) {
+        ticks_fixed += 500u << 8;
+        mock_time_ms = ticks_fixed >> 8;
+        smooth_axis_update_auto_dt(&fixed, 900);
+        
+        ticks_tracked += 500u << 8;
+        mock_time_ms = ticks_tracked >> 8;
+        smooth_axis_update_auto_dt(&tracked, 900);
+    }
+    
+    float err_fixed   = auto_vs_live_step_error(&fixed, 500u << 8, &ticks_fixed, 0.0005f);
+    float err_tracked = auto_vs_live_step_error(&tracked, 500u << 8, &ticks_tracked, 0.0005f);
+    assert(err_fixed > 0.1f);      // Warmup alpha is 2x too large for the new rate
+    assert(err_tracked < 0.01f);   // Tracked alpha converged to the new rate
+    
+    printf("✓ Test 41: AUTO_DT tracking follows loop-rate change (err %.4f vs fixed %.4f)\n",
+           err_tracked, err_fixed);
+}
+
+// ============================================================================
+// Test 42: Compile-time configured (header-only) axes
+// ============================================================================
+
+SMOOTH_AXIS_STATIC_DEFINE(static_knob, 1023, 250, SMOOTH_AXIS_MODE_AUTO_DT, test_timer)
+SMOOTH_AXIS_STATIC_DEFINE_EX(static_key, 4095, 150, SMOOTH_AXIS_MODE_LIVE_DT, NULL, 1000u, 10)
+
+void test_static_axis_matches_runtime_axis(void) {
+    smooth_axis_config_t cfg;
+    smooth_axis_t        rt_auto, rt_live;
+    static_knob_t        st_auto;
+    static_key_t         st_live;
+    
+    reset_timer();
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.25f, test_timer);
+    smooth_axis_init(&rt_auto, &cfg);
+    static_knob_init(&st_auto);
+    
+    smooth_axis_config_live_dt(&cfg, 4095, 0.15f);
+    cfg.sticky_zone_norm = 10.0f / 1023.0f;
+    smooth_axis_init(&rt_live, &cfg);
+    static_key_init(&st_live);
+    
+    test_rng_state = 4242u;
+    int   report_mismatch = 0, reports = 0;
+    float max_err_auto = 0.0f, max_err_live = 0.0f;
+    for (int i = 0; i < 3000; i++) {
+        float    wave = sinf((float)i * 0.004f);
+        uint16_t raw_a = (uint16_t)(512.0f + 480.0f * wave + (test_rand_uniform01() - 0.5f) * 12.0f);
+        uint16_t raw_l = (uint16_t)(2048.0f + 2040.0f * wave + (test_rand_uniform01() - 0.5f) * 40.0f);
+        float    dt    = 0.001f * (1.0f + (test_rand_uniform01() - 0.5f) * 0.2f);
+        if (i == 2000) {  // Reset mid-run
+            smooth_axis_reset(&rt_auto, raw_a);
+            static_knob_reset(&st_auto, raw_a);
+        }
+        
+        advance_time_ms(5);
+        smooth_axis_update_auto_dt(&rt_auto, raw_a);
+        static_knob_update(&st_auto, raw_a);
+        smooth_axis_update_live_dt(&rt_live, raw_l, dt);
+        static_key_update_dt(&st_live, raw_l, dt);
+        
+        bool rt_new_a = smooth_axis_has_new_value(&rt_auto);
+        bool st_new_a = static_knob_has_new_value(&st_auto);
+        bool rt_new_l = smooth_axis_has_new_value(&rt_live);
+        bool st_new_l = static_key_has_new_value(&st_live);
+        
+        float err_a = fabsf(static_knob_get_norm(&st_auto) - smooth_axis_get_norm(&rt_auto));
+        float err_l = fabsf(static_key_get_norm(&st_live) - smooth_axis_get_norm(&rt_live));
+        max_err_auto = err_a > max_err_auto ? err_a : max_err_auto;
+        max_err_live = err_l > max_err_live ? err_l : max_err_live;
+#if !SMOOTH_AXIS_FIXED_POINT
+        // Same helpers, same constants: AUTO_DT is bit-exact with the float library
+        assert(rt_new_a == st_new_a);
+        assert(static_knob_get_u16(&st_auto) == smooth_axis_get_u16(&rt_auto));
+        assert(static_knob_get_noise_norm(&st_auto) == smooth_axis_get_noise_norm(&rt_auto));
+#endif
+        report_mismatch += (rt_new_a != st_new_a) + (rt_new_l != st_new_l);
+        reports += st_new_a + st_new_l;
+    }
+    
+#if !SMOOTH_AXIS_FIXED_POINT
+    assert(max_err_auto == 0.0f);
+#endif
+    assert(max_err_auto < 1e-5f);
+    assert(max_err_live < 1e-4f);                 // expf() vs alpha table
+    assert(report_mismatch * 50 < reports);       // Decisions only differ at threshold ties
+    assert(sizeof(static_knob_t) * 2 < sizeof(smooth_axis_t));
+    
+    printf("✓ Test 42: Compile-time axes match smooth_axis_t (err %.1e / %.1e, %d/%d decisions differ, %u bytes)\n",
+           max_err_auto, max_err_live, report_mismatch, reports, (unsigned)sizeof(static_knob_t));
+}
+
+// ============================================================================
+// Test 43: Idle detection (settled hold, instant wake)
+// ============================================================================
+
+// Noisy hold at 300, step to 700 at i == 3000 (1 kHz, ±5 LSB uniform noise)
+static uint16_t idle_test_raw(int i) {
+    float noise = (test_rand_uniform01() * 2.0f - 1.0f) * 5.0f;
+    return (uint16_t)((i < 3000 ? 300.0f : 700.0f) + noise);
+}
+
+void test_idle_hold_and_wake(void) {
+    smooth_axis_config_t cfg;
+    smooth_axis_t        awake, idle, block;
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.2f);
+    assert(cfg.idle_frames == 0);  // Off by default
+    smooth_axis_init(&awake, &cfg);
+    cfg.idle_frames = 200;         // settle_time × 1 kHz
+    smooth_axis_init(&idle, &cfg);
+    smooth_axis_init(&block, &cfg);
+    
+    const float dt          = 0.001f;
+    uint16_t    buf[16];
+    int         idle_frames = 0, hold_reports = 0, awake_hold_reports = 0;
+    int         reversals   = 0;
+    int         awake_cross = -1, idle_cross = -1;
+    uint16_t    last_out    = 0;
+    
+    test_rng_state = 777u;
+    for (int i = 0; i < 5000; i++) {
+        uint16_t raw = idle_test_raw(i);
+        buf[i % 16]  = raw;
+        
+        smooth_axis_update_live_dt(&awake, raw, dt);
+        smooth_axis_update_live_dt(&idle, raw, dt);
+        if (i % 16 == 15) {  // Same stream in DMA-sized blocks
+            smooth_axis_update_block(&block, buf, 16, dt);
+            assert(smooth_axis_get_u16(&block) == smooth_axis_get_u16(&idle));
+            assert(smooth_axis_get_noise_norm(&block) == smooth_axis_get_noise_norm(&idle));
+            assert(smooth_axis_is_idle(&block) == smooth_axis_is_idle(&idle));
+        }
+        assert(!smooth_axis_is_idle(&awake));
+        if (i == 3000) { assert(!smooth_axis_is_idle(&idle)); }  // Step wakes on its first sample
+        idle_frames += smooth_axis_is_idle(&idle);
+        
+        bool awake_new = smooth_axis_has_new_value(&awake);
+        bool idle_new  = smooth_axis_has_new_value(&idle);
+        if (i >= 1000 && i < 3000) {  // Settled hold: no more reports than without idle
+            awake_hold_reports += awake_new;
+            hold_reports       += idle_new;
+        }
+        if (idle_new) {
+            uint16_t out = smooth_axis_get_u16(&idle);
+            if (i > 3000 && out < last_out) { reversals++; }
+            last_out = out;
+            if (idle_cross < 0 && out >= 680) { idle_cross = i; }
+        }
+        if (awake_new && awake_cross < 0 && smooth_axis_get_u16(&awake) >= 680) { awake_cross = i; }
+    }
+    
+    assert(idle_frames > 1500);                    // Idle for most of the hold
+    assert(hold_reports <= awake_hold_reports);
+    assert(reversals == 0);                        // Monotonic through the step
+    assert(idle_cross > 0 && idle_cross - awake_cross <= 2 && awake_cross - idle_cross <= 2);
+    assert(abs((int)smooth_axis_get_u16(&idle) - 700) <= 1);  // Input mean is 699.5
+    
+    // Noise-free step smaller than the noise band: quiet from its first frame, but must
+    // not go idle (and freeze) before the output has reached the target
+    smooth_axis_config_live_dt(&cfg, 1023, 0.1f);
+    smooth_axis_init(&awake, &cfg);
+    cfg.idle_frames = 100;  // settle_time × 1 kHz
+    smooth_axis_init(&idle, &cfg);
+    int step_idle = -1;
+    for (int i = 0; i < 3000; i++) {
+        uint16_t raw = i < 1000 ? 500 : 560;
+        smooth_axis_update_live_dt(&idle, raw, dt);
+        smooth_axis_update_live_dt(&awake, raw, dt);
+        if (i > 1000 && step_idle < 0 && smooth_axis_is_idle(&idle)) { step_idle = i - 1000; }
+    }
+    assert(smooth_axis_get_u16(&awake) == 560);
+    assert(smooth_axis_get_u16(&idle) == 560);
+    assert(step_idle > 0 && smooth_axis_is_idle(&idle));  // ... and still goes idle once there
+    
+    printf("✓ Test 43: Idle detection - idle %d/5000 updates, %d hold reports (%d awake), "
+           "95%% at +%dms, small step idle at +%dms\n",
+           idle_frames, hold_reports, awake_hold_reports, idle_cross - 3000, step_idle);
+}
+
+// ============================================================================
+// Test 44: Fast-start warmup (early exit, seeded dt)
+// ============================================================================
+
+// Updates until the warmup reports its dt; mock timer advances per update by period_ms
+// (± jitter_ms uniform, rounded to whole ticks) starting at 1000 ms
+static int updates_to_calibrate(smooth_axis_t *axis, bool fast, float period_ms, float jitter_ms) {
+    smooth_axis_config_t cfg;
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.25f, test_timer);
+    cfg.fast_warmup = fast;
+    smooth_axis_init(axis, &cfg);
+    
+    mock_time_ms  = 1000;
+    float t_ms    = 1000.0f;
+    int   updates = 0;
+    while (smooth_axis_get_auto_dt_sec(axis) == 0.0f && updates < 1000) {
+        t_ms        += period_ms + (test_rand_uniform01() * 2.0f - 1.0f) * jitter_ms;
+        mock_time_ms = (uint32_t)t_ms;
+        smooth_axis_update_auto_dt(axis, 512);
+        updates++;
+    }
+    return updates;
+}
+
+void test_fast_warmup_and_seed(void) {
+    smooth_axis_t axis;
+    test_rng_state = 99u;
+    
+    // Steady 50 Hz, ms timer: 16 deltas instead of 256
+    int full = updates_to_calibrate(&axis, false, 20.0f, 0.0f);
+    assert(full == 257);
+    int steady = updates_to_calibrate(&axis, true, 20.0f, 0.0f);
+    assert(steady == 17);
+    assert(float_eq(smooth_axis_get_auto_dt_sec(&axis), 0.020f, 1e-6f));
+    
+    // ±10% jitter: takes longer (1% at ~2 standard errors)
+    int jittery = updates_to_calibrate(&axis, true, 20.0f, 2.0f);
+    assert(jittery > steady && jittery < 257);
+    assert(fabsf(smooth_axis_get_auto_dt_sec(&axis) - 0.020f) < 0.020f * 0.02f);
+    
+    // 1.5 kHz on a ms timer: quantization alone needs >= 100 ticks (150 updates)
+    int coarse = updates_to_calibrate(&axis, true, 0.6667f, 0.0f);
+    assert(coarse >= 150 && coarse <= 257);
+    assert(fabsf(smooth_axis_get_auto_dt_sec(&axis) - 0.0006667f) < 0.0006667f * 0.015f);
+    
+    // Seeded (previous session: 20 ms) matches LIVE_DT at 20 ms during warmup
+    smooth_axis_config_t cfg;
+    smooth_axis_t        seeded, unseeded, live;
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.25f, test_timer);
+    smooth_axis_init(&seeded, &cfg);
+    smooth_axis_init(&unseeded, &cfg);
+    smooth_axis_seed_auto_dt(&seeded, 0.020f);
+    smooth_axis_config_live_dt(&cfg, 1023, 0.25f);
+    smooth_axis_init(&live, &cfg);
+    
+    float seeded_err = 0.0f, fallback_err = 0.0f;
+    for (int i = 0; i < 40; i++) {  // Step 100 -> 900, well inside the warmup
+        uint16_t raw = i == 0 ? 100 : 900;
+        advance_time_ms(20);
+        smooth_axis_update_auto_dt(&seeded, raw);
+        smooth_axis_update_auto_dt(&unseeded, raw);
+        smooth_axis_update_live_dt(&live, raw, 0.020f);
+        float ref = smooth_axis_get_norm(&live);
+        seeded_err   = fmaxf(seeded_err, fabsf(smooth_axis_get_norm(&seeded) - ref));
+        fallback_err = fmaxf(fallback_err, fabsf(smooth_axis_get_norm(&unseeded) - ref));
+    }
+    assert(smooth_axis_get_auto_dt_sec(&seeded) == 0.0f);  // Warmup still measuring
+    assert(seeded_err < 1e-4f);
+    assert(fallback_err > 0.02f);
+    
+    // Bank: one seed and one calibrated period for all axes
+    static smooth_axis_bank_t bank;
+    uint16_t                  scan[4] = { 100, 200, 300, 400 };
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.25f, test_timer);
+    cfg.fast_warmup = true;
+    smooth_axis_bank_init(&bank, &cfg, 4);
+    smooth_axis_bank_seed_auto_dt(&bank, 0.020f);
+    for (int i = 0; i < 17; i++) {
+        advance_time_ms(20);
+        smooth_axis_bank_update_auto_dt(&bank, scan, 4);
+    }
+    assert(float_eq(smooth_axis_bank_get_auto_dt_sec(&bank), 0.020f, 1e-6f));
+    
+    printf("✓ Test 44: Fast warmup - %d updates steady, %d jittery, %d coarse timer (of 257); "
+           "seed err %.1e\n", steady, jittery, coarse, seeded_err);
+}
+
+// ============================================================================
+// TEST 45: Snapshot / restore across deep sleep
+// ============================================================================
+
+void test_snapshot_restore(void) {
+    smooth_axis_config_t cfg;
+    smooth_axis_t        axis, resumed, twin;
+    smooth_axis_snapshot_t snap;
+    test_rng_state = 45u;
+    
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.25f, test_timer);
+    cfg.fast_warmup = true;
+    smooth_axis_init(&axis, &cfg);
+    for (int i = 0; i < 300; i++) {
+        advance_time_ms(20);
+        smooth_axis_update_auto_dt(&axis, (uint16_t)(600.0f + 6.0f * (test_rand_uniform01() - 0.5f)));
+        (void)smooth_axis_has_new_value(&axis);
+    }
+    assert(sizeof(smooth_axis_snapshot_t) == 12);
+    smooth_axis_save(&axis, &snap);
+    
+    // Wake: timer restarted, fresh axis from the same config
+    mock_time_ms = 3;
+    smooth_axis_init(&resumed, &cfg);
+    bool ok = smooth_axis_restore(&resumed, &snap);
+    assert(ok);
+    assert(float_eq(smooth_axis_get_auto_dt_sec(&resumed), 0.020f, 1e-6f));  // No warmup
+    assert(fabsf(smooth_axis_get_norm(&resumed) - smooth_axis_get_norm(&axis)) < 2e-5f);
+    float noise_err = fabsf(smooth_axis_get_noise_norm(&resumed) - smooth_axis_get_noise_norm(&axis));
+    assert(noise_err < 1e-6f);
+    bool has_new = smooth_axis_has_new_value(&resumed);
+    assert(!has_new);  // Nothing moved while asleep
+    
+    // Same pot position after wake: no spurious report; a move is reported
+    int spurious = 0;
+    for (int i = 0; i < 100; i++) {
+        advance_time_ms(20);
+        smooth_axis_update_auto_dt(&resumed, (uint16_t)(600.0f + 6.0f * (test_rand_uniform01() - 0.5f)));
+        spurious += smooth_axis_has_new_value(&resumed);
+    }
+    assert(spurious == 0);
+    advance_time_ms(20);
+    smooth_axis_update_auto_dt(&resumed, 900);
+    has_new = smooth_axis_has_new_value(&resumed);
+    assert(has_new);
+    
+    // Cleared backup RAM (or a flipped byte) is rejected; axis untouched
+    smooth_axis_init(&twin, &cfg);
+    smooth_axis_snapshot_t bad;
+    memset(&bad, 0, sizeof(bad));
+    ok = smooth_axis_restore(&twin, &bad);
+    assert(!ok);
+    bad = snap;
+    bad._smoothed ^= 0x0100;
+    ok = smooth_axis_restore(&twin, &bad);
+    assert(!ok);
+    has_new = smooth_axis_has_new_value(&twin);
+    assert(!has_new && smooth_axis_get_auto_dt_sec(&twin) == 0.0f);
+    
+    // LIVE_DT: the same snapshot restores position/noise, dt is ignored
+    smooth_axis_config_live_dt(&cfg, 1023, 0.25f);
+    smooth_axis_init(&twin, &cfg);
+    ok = smooth_axis_restore(&twin, &snap);
+    assert(ok);
+    assert(fabsf(smooth_axis_get_norm(&twin) - smooth_axis_get_norm(&axis)) < 2e-5f);
+    
+    printf("✓ Test 45: Snapshot - %u bytes, resumed without warmup, noise err %.1e, "
+           "bad snapshots rejected\n", (unsigned)sizeof(snap), noise_err);
+}
+
+// ============================================================================
+// TEST 46: Multiplexed scan scheduler (per-channel rate and dt)
+// ============================================================================
+
+#define SCHED_TEST_CHANNELS 32
+#define SCHED_TEST_BUDGET   4  // Conversions per 1 ms slot (full rate would need 32)
+
+static uint16_t sched_test_raw(size_t ch, uint32_t now_us) {
+    float t     = (float)now_us * 1e-6f;
+    float noise = 4.0f * (test_rand_uniform01() - 0.5f);
+    if (ch == 0) {  // Triangle sweep, 0.5 s period
+        float phase = fmodf(t, 0.5f) / 0.5f;
+        return (uint16_t)(300.0f + 800.0f * (phase < 0.5f ? phase : 1.0f - phase) + noise);
+    }
+    if (ch == 5 && t >= 1.0f) { return (uint16_t)(800.0f + noise); }  // Step from rest
+    return (uint16_t)(200.0f + (float)ch * 20.0f + noise);
+}
+
+void test_sched_adaptive_rates(void) {
+    static smooth_axis_bank_t  bank;
+    static smooth_axis_sched_t sched;
+    smooth_axis_config_t       cfg;
+    smooth_axis_t              ref;
+    uint16_t                   raw[SCHED_TEST_CHANNELS];
+    test_rng_state = 46u;
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.1f);
+    smooth_axis_bank_init(&bank, &cfg, SCHED_TEST_CHANNELS);
+    smooth_axis_sched_init(&sched, &bank, 1000000u, 0.001f, 0.020f);
+    smooth_axis_init(&ref, &cfg);  // Shadow of channel 0, fed the same samples and dt
+    
+    uint32_t now_us = 0;
+    for (size_t ch = 0; ch < SCHED_TEST_CHANNELS; ch++) { raw[ch] = sched_test_raw(ch, now_us); }
+    smooth_axis_sched_prime(&sched, raw, now_us);
+    smooth_axis_update_live_dt(&ref, raw[0], 0.0f);
+    
+    uint32_t ref_last_us   = 0;
+    long     conversions   = 0;
+    int      spurious      = 0;
+    float    max_ref_err   = 0.0f;
+    float    step_report_s = -1.0f, step_settle_s = -1.0f;
+    for (int slot = 1; slot <= 1500; slot++) {
+        size_t picked[SCHED_TEST_BUDGET];
+        size_t n = smooth_axis_sched_next(&sched, now_us = (uint32_t)slot * 1000u,
+                                          picked, SCHED_TEST_BUDGET);
+        assert(n <= SCHED_TEST_BUDGET);
+        for (size_t k = 0; k < n; k++) {
+            uint32_t t_us = now_us + (uint32_t)k * 20u;  // 20 us per conversion
+            uint16_t r    = sched_test_raw(picked[k], t_us);
+            smooth_axis_sched_submit(&sched, picked[k], r, t_us);
+            if (picked[k] == 0) {
+                smooth_axis_update_live_dt(&ref, r, (float)(t_us - ref_last_us) * 1e-6f);
+                ref_last_us = t_us;
+            }
+        }
+        conversions += (long)n;
+        max_ref_err = fmaxf(max_ref_err, fabsf(smooth_axis_bank_get_norm(&bank, 0)
+                                               - smooth_axis_get_norm(&ref)));
+        
+        for (size_t ch = 1; ch < SCHED_TEST_CHANNELS; ch++) {
+            bool reported = smooth_axis_bank_has_new_value(&bank, ch);
+            if (ch == 5 && slot >= 1000) {
+                float t = (float)(slot - 1000) * 1e-3f;
+                if (reported && step_report_s < 0.0f) { step_report_s = t; }
+                if (step_settle_s < 0.0f &&
+                    fabsf(smooth_axis_bank_get_norm(&bank, ch) - 800.0f / 1023.0f) < 0.02f) {
+                    step_settle_s = t;
+                }
+            } else if (slot > 300) {
+                spurious += reported;
+            }
+        }
+        if (slot == 900) {  // Rest: quiet channels backed off, the sweep runs at full rate
+            assert(float_eq(smooth_axis_sched_get_period_sec(&sched, 0), 0.001f, 1e-6f));
+            for (size_t ch = 1; ch < SCHED_TEST_CHANNELS; ch++) {
+                assert(float_eq(smooth_axis_sched_get_period_sec(&sched, ch), 0.020f, 1e-6f));
+            }
+        }
+    }
+    
+    assert(max_ref_err < 1e-4f);  // Per-channel dt: same output as a dedicated LIVE_DT axis
+    assert(spurious == 0);
+    assert(step_report_s >= 0.0f && step_report_s <= 0.025f);   // <= max period + a slot
+    assert(step_settle_s >= 0.0f && step_settle_s <= 0.1f + 0.025f);
+    assert(conversions < 1500L * SCHED_TEST_CHANNELS / 5);
+    
+    printf("✓ Test 46: Scan scheduler - %.1f conversions/ms for %d channels, step reported "
+           "after %.0f ms, settled %.0f ms, sweep err %.1e\n",
+           (double)conversions / 1500.0, SCHED_TEST_CHANNELS,
+           step_report_s * 1000.0f, step_settle_s * 1000.0f, max_ref_err);
+}
+
+// ============================================================================
+// TEST 47: Oversampling / decimation front-end
+// ============================================================================
+
+// Seconds until a 100 -> 900 step (applied at the first sample) is within 5%
+static float decim_settle_sec(smooth_axis_t *axis, float dt, int samples) {
+    const float target = 900.0f / 1023.0f, start = 100.0f / 1023.0f;
+    for (int i = 0; i < samples; i++) {
+        smooth_axis_update_live_dt(axis, i < 64 ? 100 : 900, dt);
+        if (i >= 64 && smooth_axis_get_norm(axis) >= target - 0.05f * (target - start)) {
+            return (float)(i - 63) * dt;
+        }
+    }
+    return -1.0f;
+}
+
+void test_decimation_front_end(void) {
+    const float          dt = 1.0f / 32000.0f;  // 32 kHz raw, decimated to 1 kHz
+    smooth_axis_config_t cfg;
+    smooth_axis_t        plain, decim, block;
+    
+    // settle_time_sec holds: alpha comes from the decimated dt (32 x dt)
+    smooth_axis_config_live_dt(&cfg, 1023, 0.1f);
+    smooth_axis_init(&plain, &cfg);
+    cfg.decimation = 32;
+    smooth_axis_init(&decim, &cfg);
+    assert(smooth_axis_get_norm(&decim) == 0.0f);
+    float settle_plain = decim_settle_sec(&plain, dt, 8000);
+    float settle_decim = decim_settle_sec(&decim, dt, 8000);
+    assert(float_eq(settle_plain, 0.1f, 0.002f));
+    assert(float_eq(settle_decim, 0.1f, 0.002f));
+    
+    // Noise: the EMA sees the boxcar mean, so the estimate (and threshold) shrinks
+    test_rng_state = 47u;
+    smooth_axis_init(&plain, &cfg);  // Still decimation = 32
+    cfg.decimation = 0;
+    smooth_axis_init(&decim, &cfg);  // Plain this time
+    for (int i = 0; i < 64000; i++) {
+        uint16_t raw = (uint16_t)(500.0f + 16.0f * (test_rand_uniform01() - 0.5f));
+        smooth_axis_update_live_dt(&plain, raw, dt);
+        smooth_axis_update_live_dt(&decim, raw, dt);
+    }
+    float noise_decim = smooth_axis_get_noise_norm(&plain);
+    float noise_plain = smooth_axis_get_noise_norm(&decim);
+    assert(noise_decim < 0.35f * noise_plain);
+    
+    // Resolution above max_raw: a 500/501 dither averages to 500.5, kept as a fraction
+    cfg.decimation = 8;
+    smooth_axis_init(&decim, &cfg);
+    smooth_axis_init(&block, &cfg);
+    uint16_t dither[600];
+    for (int i = 0; i < 600; i++) { dither[i] = (uint16_t)(500 + (i & 1)); }
+    for (int i = 0; i < 600; i++) { smooth_axis_update_live_dt(&decim, dither[i], 0.001f); }
+    smooth_axis_reset(&plain, 500);  // Output mapping is affine mid-range: expect the midpoint
+    float out_500 = smooth_axis_get_norm(&plain);
+    smooth_axis_reset(&plain, 501);
+    float out_mid = 0.5f * (out_500 + smooth_axis_get_norm(&plain));
+    assert(float_eq(smooth_axis_get_norm(&decim), out_mid, 1e-5f));
+    
+    // update_block: bit-exact with per-sample calls, across odd block boundaries
+    smooth_axis_update_block(&block, dither, 5, 0.001f);
+    smooth_axis_update_block(&block, dither + 5, 19, 0.001f);
+    smooth_axis_update_block(&block, dither + 24, 576, 0.001f);
+    assert(smooth_axis_get_norm(&block) == smooth_axis_get_norm(&decim));
+    assert(smooth_axis_get_noise_norm(&block) == smooth_axis_get_noise_norm(&decim));
+    
+    // AUTO_DT: the warmup times decimated samples (1 ms raw x 8)
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.25f, test_timer);
+    cfg.decimation  = 8;
+    cfg.fast_warmup = true;
+    smooth_axis_init(&decim, &cfg);
+    for (int i = 0; i < 8 * 40; i++) {
+        advance_time_ms(1);
+        smooth_axis_update_auto_dt(&decim, 600);
+    }
+    assert(float_eq(smooth_axis_get_auto_dt_sec(&decim), 0.008f, 1e-6f));
+    
+    printf("✓ Test 47: Decimation x32 - settle %.1f ms (plain %.1f ms), noise %.5f vs %.5f, "
+           "dither err %.1e\n", settle_decim * 1000.0f, settle_plain * 1000.0f,
+           noise_decim, noise_plain, fabsf(smooth_axis_get_norm(&block) - out_mid));
+}
+
+// ============================================================================
+// TEST 48: Instrumentation counters (SMOOTH_AXIS_STATS builds)
+// ============================================================================
+
+void test_stats_counters(void) {
+    smooth_axis_config_t cfg;
+    smooth_axis_t        axis;
+    smooth_axis_stats_t  st;
+    smooth_axis_config_live_dt(&cfg, 1023, 0.1f);
+    smooth_axis_init(&axis, &cfg);
+    
+#if !SMOOTH_AXIS_STATS
+    smooth_axis_update_live_dt(&axis, 500, 0.001f);
+    smooth_axis_get_stats(&axis, &st);
+    assert(st.updates == 0 && st.dt_max_sec == 0.0f);  // Compiled out: zeros
+    printf("⊘ Test 48: Stats counters (skipped: built without SMOOTH_AXIS_STATS)\n");
+#else
+    static smooth_axis_bank_t bank;
+    test_rng_state = 48u;
+    
+    // Noisy hold, then a ramp and a push to full scale (sticky zone)
+    uint32_t reported = 0, polled = 0;
+    float    dt_lo = 1.0f, dt_hi = 0.0f;
+    for (int i = 0; i < 3000; i++) {
+        float    level = i < 1000 ? 300.0f : (i < 2000 ? 300.0f + (float)(i - 1000) * 0.5f : 1023.0f);
+        uint16_t raw   = (uint16_t)fminf(level + 6.0f * (test_rand_uniform01() - 0.5f), 1023.0f);
+        float    dt    = 0.001f * (0.9f + 0.2f * test_rand_uniform01());
+        dt_lo = fminf(dt_lo, dt);
+        dt_hi = fmaxf(dt_hi, dt);
+        smooth_axis_update_live_dt(&axis, raw, dt);
+        reported += smooth_axis_has_new_value(&axis);
+        polled++;
+    }
+    uint16_t block[64] = { 0 };
+    smooth_axis_update_block(&axis, block, 64, 0.001f);
+    
+    smooth_axis_get_stats(&axis, &st);
+    assert(st.updates == 3000 + 64);
+    assert(st.noise_spikes + st.settling_samples == st.updates - 1);  // First sample teleports
+    assert(st.noise_spikes > 500 && st.settling_samples > 500);
+    assert(st.reports_sticky + st.reports_threshold == reported);
+    assert(st.reports_sticky > 0 && st.reports_threshold > 0);
+    assert(st.reports_sticky + st.reports_threshold + st.suppressed_sub_lsb + st.suppressed_noise
+           == polled);
+    assert(st.suppressed_sub_lsb > 0 && st.suppressed_noise > 0);
+    assert(st.dt_min_sec == dt_lo && st.dt_max_sec == dt_hi);
+    smooth_axis_stats_t total = st;
+    
+    smooth_axis_reset_stats(&axis);
+    smooth_axis_get_stats(&axis, &st);
+    assert(st.updates == 0 && st.reports_threshold == 0 && st.dt_max_sec == 0.0f);
+    
+    // Bank: counted over all axes, for polling and for the change mask alike
+    uint32_t mask[1] = { 0 };
+    uint16_t scan[4];
+    smooth_axis_bank_init(&bank, &cfg, 4);
+    reported = 0;
+    for (int i = 0; i < 500; i++) {
+        for (int a = 0; a < 4; a++) { scan[a] = (uint16_t)(200 * a + (i < 250 ? 100 : 150)); }
+        smooth_axis_bank_update_live_dt(&bank, scan, 4, 0.002f);
+        for (size_t a = 0; a < 4; a++) { reported += smooth_axis_bank_has_new_value(&bank, a); }
+    }
+    smooth_axis_get_stats(&axis, &st);  // Untouched by the bank
+    assert(st.updates == 0);
+    smooth_axis_bank_get_stats(&bank, &st);
+    assert(st.updates == 2000);
+    assert(st.noise_spikes + st.settling_samples == 2000 - 4);
+    assert(st.reports_sticky + st.reports_threshold == reported);
+    assert(st.reports_sticky + st.reports_threshold + st.suppressed_sub_lsb + st.suppressed_noise
+           == 2000);  // One decision per poll
+    assert(st.dt_min_sec == 0.002f && st.dt_max_sec == 0.002f);
+    
+    smooth_axis_bank_reset_stats(&bank);
+    smooth_axis_bank_set_change_mask(&bank, mask);
+    for (size_t a = 0; a < 4; a++) { scan[a] = 1000; }
+    smooth_axis_bank_update_live_dt(&bank, scan, 4, 0.002f);
+    smooth_axis_bank_get_stats(&bank, &st);
+    assert(st.reports_threshold == 4 && mask[0] == 0xFu);
+    
+    printf("✓ Test 48: Stats - %u updates: %u noise / %u settling, reports %u sticky + %u "
+           "threshold, suppressed %u sub-LSB + %u noise, dt %.2f..%.2f ms\n",
+           (unsigned)total.updates, (unsigned)total.noise_spikes, (unsigned)total.settling_samples,
+           (unsigned)total.reports_sticky, (unsigned)total.reports_threshold,
+           (unsigned)total.suppressed_sub_lsb, (unsigned)total.suppressed_noise,
+           total.dt_min_sec * 1000.0f, total.dt_max_sec * 1000.0f);
+#endif
+}
+
+// ============================================================================
+// Output Cache
+// ============================================================================
+
+// Cached reads must equal a fresh computation (copy of the axis with the cache dropped),
+// and the const getters must not write the axis (it may be a const object)
+static void check_output_cache(const smooth_axis_t *axis) {
+    smooth_axis_t fresh = *axis;
+    fresh._out._valid = false;
+    smooth_axis_t before = fresh;
+    assert(smooth_axis_get_norm(axis) == smooth_axis_get_norm(&fresh));
+    assert(smooth_axis_get_u16(axis) == smooth_axis_get_u16(&fresh));
+    assert(memcmp(&before, &fresh, sizeof fresh) == 0);
+}
+
+void test_output_cache(void) {
+    smooth_axis_config_t   cfg;
+    smooth_axis_t          axis;
+    smooth_axis_snapshot_t snap;
+    uint16_t               block[8];
+    test_rng_state = 49u;
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.1f);
+    cfg.idle_frames = 32;  // Idle holds skip update_core(): the cache must stay valid
+    smooth_axis_init(&axis, &cfg);
+    check_output_cache(&axis);
+    assert(smooth_axis_get_norm(&axis) == 0.0f && smooth_axis_get_u16(&axis) == 0);
+    
+    uint32_t changes = 0;
+    uint16_t last    = 0;
+    for (int i = 0; i < 3000; i++) {
+        float    level = i < 1000 ? 20.0f : (i < 2000 ? 500.0f : 1010.0f);
+        uint16_t raw   = (uint16_t)fminf(level + 4.0f * (test_rand_uniform01() - 0.5f), 1023.0f);
+        if (i % 100 == 50) {
+            for (int k = 0; k < 8; k++) { block[k] = raw; }
+            smooth_axis_update_block(&axis, block, 8, 0.001f);
+        } else {
+            smooth_axis_update_live_dt(&axis, raw, 0.001f);
+        }
+        if (i == 1500) { smooth_axis_reset(&axis, 700); }
+        if (i == 2200) { smooth_axis_save(&axis, &snap); }
+        if (i == 2600) {
+            bool restored = smooth_axis_restore(&axis, &snap);
+            assert(restored);
+        }
+        
+        check_output_cache(&axis);
+        (void)smooth_axis_has_new_value(&axis);  // Same cached position, no recompute
+        check_output_cache(&axis);
+        uint16_t u16 = smooth_axis_get_u16(&axis);
+        changes += u16 != last;
+        last = u16;
+    }
+    assert(changes > 10);
+    
+    // Decimated updates invalidate only when a block reaches the EMA
+    cfg.idle_frames = 0;
+    cfg.decimation  = 4;
+    smooth_axis_init(&axis, &cfg);
+    for (int i = 0; i < 200; i++) {
+        smooth_axis_update_live_dt(&axis, (uint16_t)(i * 5), 0.001f);
+        check_output_cache(&axis);
+    }
+    
+    printf("✓ Test 49: Output cache - reads match a fresh computation through updates, "
+           "blocks, idle, reset and restore (%u output changes)\n", (unsigned)changes);
+}
+
+// ============================================================================
+// Test 50: Compact 8-byte axes
+// ============================================================================
+
+void test_compact_axes(void) {
+    enum { AXES = 16 };
+    smooth_axis_config_t            cfg;
+    static smooth_axis_shared_cfg_t shared;
+    smooth_axis_compact_t           scan[AXES];
+    smooth_axis_compact_t           single[AXES];
+    smooth_axis_shared_t            ref[AXES];
+    uint16_t                        raw[AXES];
+    test_rng_state = 50u;
+    
+    assert(sizeof(smooth_axis_compact_t) == 8);
+    
+    smooth_axis_config_live_dt(&cfg, 4095, 0.05f);
+    cfg.sticky_zone_norm = 0.01f;
+    smooth_axis_shared_cfg_init(&shared, &cfg);
+    smooth_axis_compact_init(scan, AXES);
+    smooth_axis_compact_init(single, AXES);
+    for (int a = 0; a < AXES; a++) { smooth_axis_shared_init(&ref[a], &shared); }
+    
+    // Nothing reported or read before the first sample
+    bool has_new = smooth_axis_compact_has_new_value(&scan[0], &shared);
+    assert(!has_new);
+    assert(smooth_axis_compact_get_u16(&scan[0], &shared) == 0);
+    assert(fabsf(smooth_axis_compact_get_noise_norm(&scan[0]) - smooth_axis_shared_get_noise_norm(&ref[0]))
+           < 1e-5f);
+    
+    uint32_t reports = 0;
+    uint32_t report_diffs = 0;
+    for (int i = 0; i < 3000; i++) {
+        float dt = 0.001f * (1.0f + (test_rand_uniform01() - 0.5f) * 0.1f);
+        for (int a = 0; a < AXES; a++) {
+            float level = (i / 500) % 2 ? 3500.0f : 300.0f + 100.0f * (float)a;
+            raw[a] = (uint16_t)(level + (test_rand_uniform01() - 0.5f) * 30.0f);
+        }
+        if (i == 1800) {  // Reset mid-run on one axis
+            smooth_axis_compact_reset(&scan[5], &shared, raw[5]);
+            smooth_axis_compact_reset(&single[5], &shared, raw[5]);
+            smooth_axis_shared_reset(&ref[5], raw[5]);
+        }
+        
+        smooth_axis_compact_update_scan(scan, &shared, raw, AXES, dt);
+        for (int a = 0; a < AXES; a++) {
+            smooth_axis_compact_update_live_dt(&single[a], &shared, raw[a], dt);
+            smooth_axis_shared_update_live_dt(&ref[a], raw[a], dt);
+            
+            // One scan == per-axis updates, bit for bit
+            assert(memcmp(&scan[a], &single[a], sizeof(scan[a])) == 0);
+            
+            // Within one output LSB of the full-precision state
+            int du16 = (int)smooth_axis_compact_get_u16(&scan[a], &shared)
+                       - (int)smooth_axis_shared_get_u16(&ref[a]);
+            assert(du16 >= -1 && du16 <= 1);
+            assert(fabsf(smooth_axis_compact_get_norm(&scan[a], &shared) - smooth_axis_shared_get_norm(&ref[a]))
+                   < 1e-4f);
+            
+            bool compact_new = smooth_axis_compact_has_new_value(&scan[a], &shared);
+            bool ref_new     = smooth_axis_shared_has_new_value(&ref[a]);
+            (void)smooth_axis_compact_has_new_value(&single[a], &shared);
+            reports      += compact_new;
+            report_diffs += compact_new != ref_new;
+        }
+    }
+    assert(reports > 100);
+    assert(report_diffs * 20 < reports);  // Threshold-edge disagreements only
+    
+    // Reset to 0 waits for a sample again; a nonzero reset reads back at once
+    smooth_axis_compact_reset(&scan[0], &shared, 0);
+    assert(smooth_axis_compact_get_u16(&scan[0], &shared) == 0);
+    has_new = smooth_axis_compact_has_new_value(&scan[0], &shared);
+    assert(!has_new);
+    smooth_axis_compact_reset(&scan[0], &shared, 2048);
+    smooth_axis_shared_reset(&ref[0], 2048);
+    assert(smooth_axis_compact_get_u16(&scan[0], &shared) == smooth_axis_shared_get_u16(&ref[0]));
+    has_new = smooth_axis_compact_has_new_value(&scan[0], &shared);
+    assert(!has_new);  // Reset value counts as reported
+    
+    printf("✓ Test 50: Compact axes - %u bytes/axis, scan matches per-axis updates, within 1 LSB of "
+           "shared axes (%u reports, %u decisions differ)\n",
+           (unsigned)sizeof(smooth_axis_compact_t), (unsigned)reports, (unsigned)report_diffs);
+}
+
+// ============================================================================
+// Test 51: One warmup for a group of AUTO_DT axes
+// ============================================================================
+
+static uint32_t counted_timer_reads = 0;
+
+static uint32_t counted_timer(void) {
+    counted_timer_reads++;
+    return mock_time_ms;
+}
+
+void test_auto_dt_group_warmup(void) {
+    enum { AXES = 6 };
+    smooth_axis_config_t cfg;
+    smooth_axis_t        group[AXES];
+    smooth_axis_t        solo[AXES];
+    uint16_t             raw[AXES];
+    test_rng_state = 51u;
+    
+    // Axes 0-3 identical, 4 with its own settle time, 5 decimating by 4
+    for (int a = 0; a < AXES; a++) {
+        smooth_axis_config_auto_dt(&cfg, 1023, a == 4 ? 0.2f : 0.05f, counted_timer);
+        cfg.decimation = a == 5 ? 4 : 1;
+        smooth_axis_init(&group[a], &cfg);
+        smooth_axis_init(&solo[a], &cfg);
+    }
+    
+    uint32_t ticks_q8 = 1000u << 8;
+    uint32_t group_reads = 0;
+    uint32_t max_frame_reads = 0;
+    for (int i = 0; i < 1500; i++) {
+        ticks_q8    += 256u * 2u + (uint32_t)(test_rand_uniform01() * 128.0f);  // ~2.25 ms
+        mock_time_ms = ticks_q8 >> 8;
+        for (int a = 0; a < AXES; a++) {
+            raw[a] = (uint16_t)((i / 300) % 2 ? 800 + 10 * a : 200)
+                     + (uint16_t)(test_rand_uniform01() * 6.0f);
+        }
+        
+        counted_timer_reads = 0;
+        smooth_axis_update_auto_dt_group(group, raw, AXES);
+        group_reads    += counted_timer_reads;
+        max_frame_reads = counted_timer_reads > max_frame_reads ? counted_timer_reads : max_frame_reads;
+        
+        for (int a = 0; a < AXES; a++) { smooth_axis_update_auto_dt(&solo[a], raw[a]); }
+        
+        // Non-decimating members see the same dt sequence as on their own: bit-exact
+        for (int a = 0; a < 5; a++) {
+            assert(smooth_axis_get_norm(&group[a]) == smooth_axis_get_norm(&solo[a]));
+            bool group_new = smooth_axis_has_new_value(&group[a]);
+            bool solo_new  = smooth_axis_has_new_value(&solo[a]);
+            assert(group_new == solo_new);
+        }
+        
+        // Every member switches to its calibrated alpha on the same call
+        bool done = smooth_axis_get_auto_dt_sec(&group[0]) > 0.0f;
+        for (int a = 1; a < AXES; a++) {
+            assert((smooth_axis_get_auto_dt_sec(&group[a]) > 0.0f) == done);
+        }
+    }
+    assert(max_frame_reads <= 1);
+    assert(group_reads <= SMOOTH_AXIS_INIT_CALIBRATION_CYCLES + 1u);  // Then no reads (no tracking)
+    
+    float dt = smooth_axis_get_auto_dt_sec(&group[0]);
+    assert(dt > 0.0020f && dt < 0.0025f);
+    assert(smooth_axis_get_auto_dt_sec(&group[4]) == dt);
+    assert(float_eq(smooth_axis_get_auto_dt_sec(&group[5]), 4.0f * dt, 1e-6f));
+    assert(float_eq(smooth_axis_get_auto_dt_sec(&group[5]), smooth_axis_get_auto_dt_sec(&solo[5]), 2e-4f));
+    
+    printf("✓ Test 51: AUTO_DT group - one timer read per frame (%u during warmup vs %d per frame "
+           "solo), members match solo axes, dt %.3f ms\n",
+           (unsigned)group_reads, AXES, dt * 1000.0f);
+}
+
+// ============================================================================
+// Test 52: Bank report events (ring buffer, overflow policies)
+// ============================================================================
+
+void test_bank_event_queue(void) {
+    enum { AXES = 40, SCANS = 1200, ALL = AXES * SCANS };
+    smooth_axis_config_t             cfg;
+    static smooth_axis_bank_t        polled, streamed, dropping, coalescing, squeezed;
+    static smooth_axis_event_t       all_buf[ALL], drop_buf[16], coal_buf[AXES], batch[8];
+    static smooth_axis_event_t       sq_buf[8], ref_buf[8], ref_batch[8];
+    static smooth_axis_event_t       history[ALL];
+    smooth_axis_event_queue_t        all_q, drop_q, coal_q, sq_q, ref_q;
+    uint32_t                         changed[SMOOTH_AXIS_BANK_MASK_WORDS(AXES)] = { 0 };
+    uint16_t                         raw[AXES];
+    uint16_t                         latest[AXES];
+    
+    smooth_axis_config_live_dt(&cfg, 1023, 0.1f);
+    smooth_axis_bank_init(&polled, &cfg, AXES);
+    smooth_axis_bank_init(&streamed, &cfg, AXES);
+    smooth_axis_bank_init(&dropping, &cfg, AXES);
+    smooth_axis_bank_init(&coalescing, &cfg, AXES);
+    smooth_axis_bank_init(&squeezed, &cfg, AXES);
+    
+    smooth_axis_event_queue_init(&all_q, all_buf, ALL, SMOOTH_AXIS_EVENTS_DROP_OLDEST, NULL);
+    smooth_axis_event_queue_init(&drop_q, drop_buf, 16, SMOOTH_AXIS_EVENTS_DROP_OLDEST, NULL);
+    smooth_axis_event_queue_init(&coal_q, coal_buf, AXES, SMOOTH_AXIS_EVENTS_COALESCE, counted_timer);
+    smooth_axis_bank_set_event_queue(&streamed, &all_q);
+    smooth_axis_bank_set_change_mask(&streamed, changed);  // Both at once
+    smooth_axis_bank_set_event_queue(&dropping, &drop_q);
+    smooth_axis_bank_set_event_queue(&coalescing, &coal_q);
+    
+    // COALESCE with fewer slots than axes, drained now and then: the bank's slot
+    // index must agree with the scanning push fed the same reports
+    smooth_axis_event_queue_init(&sq_q, sq_buf, 8, SMOOTH_AXIS_EVENTS_COALESCE, NULL);
+    smooth_axis_event_queue_init(&ref_q, ref_buf, 8, SMOOTH_AXIS_EVENTS_COALESCE, NULL);
+    smooth_axis_bank_set_event_queue(&squeezed, &sq_q);
+    
+    size_t   total = 0;
+    uint32_t max_reads = 0;
+    for (int i = 0; i < SCANS; i++) {
+        for (int a = 0; a < AXES; a++) {
+            int moving = ((i / 100) % 5) == (a % 5);
+            raw[a] = (uint16_t)((moving ? (i % 100) * 10 : 300 + a) + ((i + a) % 2));
+        }
+        mock_time_ms        = 5000u + (uint32_t)i;
+        counted_timer_reads = 0;
+        if (i % 50 == 49) {  // Per-axis updates report too
+            smooth_axis_bank_update_axis_live_dt(&polled, 3, raw[3], 0.002f);
+            smooth_axis_bank_update_axis_live_dt(&streamed, 3, raw[3], 0.002f);
+            smooth_axis_bank_update_axis_live_dt(&dropping, 3, raw[3], 0.002f);
+            smooth_axis_bank_update_axis_live_dt(&coalescing, 3, raw[3], 0.002f);
+            smooth_axis_bank_update_axis_live_dt(&squeezed, 3, raw[3], 0.002f);
+        } else {
+            smooth_axis_bank_update_live_dt(&polled, raw, AXES, 0.001f);
+            smooth_axis_bank_update_live_dt(&streamed, raw, AXES, 0.001f);
+            smooth_axis_bank_update_live_dt(&dropping, raw, AXES, 0.001f);
+            smooth_axis_bank_update_live_dt(&coalescing, raw, AXES, 0.001f);
+            smooth_axis_bank_update_live_dt(&squeezed, raw, AXES, 0.001f);
+        }
+        max_reads = counted_timer_reads > max_reads ? counted_timer_reads : max_reads;
+        
+        // Events == polled decisions == mask bits, axis order, clockless timestamp = update count
+        size_t n = smooth_axis_event_queue_drain(&all_q, &history[total], ALL - total);
+        size_t k = 0;
+        for (int a = 0; a < AXES; a++) {
+            bool polled_new = smooth_axis_bank_has_new_value(&polled, (size_t)a);
+            assert(polled_new == (bool)((changed[a / 32] >> (a % 32)) & 1u));
+            if (!polled_new) { continue; }
+            assert(k < n && history[total + k].axis == a);
+            assert(history[total + k].u16 == smooth_axis_bank_get_u16(&polled, (size_t)a));
+            assert(history[total + k].timestamp == (uint32_t)i + 1u);
+            k++;
+        }
+        assert(k == n);
+        for (k = 0; k < n; k++) {
+            const smooth_axis_event_t *ev = &history[total + k];
+            smooth_axis_event_queue_push(&ref_q, ev->axis, ev->u16, ev->timestamp);
+        }
+        if (i % 7 == 6 || i == SCANS - 1) {
+            size_t got_sq = smooth_axis_event_queue_drain(&sq_q, batch, (size_t)(i % 3) + 2);
+            size_t got_ref = smooth_axis_event_queue_drain(&ref_q, ref_batch, (size_t)(i % 3) + 2);
+            assert(got_sq == got_ref);
+            for (size_t e = 0; e < got_sq; e++) {
+                assert(batch[e].axis == ref_batch[e].axis && batch[e].u16 == ref_batch[e].u16
+                       && batch[e].timestamp == ref_batch[e].timestamp);
+            }
+        }
+        total += n;
+        for (size_t w = 0; w < SMOOTH_AXIS_BANK_MASK_WORDS(AXES); w++) { changed[w] = 0; }
+    }
+    assert(total > 200);
+    assert(max_reads <= 1);  // Queue clock read once per scan at most
+    
+    // DROP_OLDEST, never drained: the newest 16 events survive
+    assert(smooth_axis_event_queue_count(&drop_q) == 16);
+    assert(smooth_axis_event_queue_dropped(&drop_q) == total - 16);
+    size_t got = 0, n;
+    while ((n = smooth_axis_event_queue_drain(&drop_q, batch, 8)) > 0) {
+        for (size_t e = 0; e < n; e++, got++) {
+            const smooth_axis_event_t *want = &history[total - 16 + got];
+            assert(batch[e].axis == want->axis && batch[e].u16 == want->u16
+                   && batch[e].timestamp == want->timestamp);
+        }
+    }
+    assert(got == 16 && smooth_axis_event_queue_count(&drop_q) == 0);
+    
+    // COALESCE with one slot per axis: nothing dropped, one event per axis with its latest value
+    for (int a = 0; a < AXES; a++) { latest[a] = 0xFFFF; }
+    for (size_t e = 0; e < total; e++) { latest[history[e].axis] = history[e].u16; }
+    size_t queued = smooth_axis_event_queue_count(&coal_q);
+    assert(smooth_axis_event_queue_dropped(&coal_q) == 0);
+    assert(smooth_axis_event_queue_coalesced(&coal_q) == total - queued);
+    bool seen[AXES] = { false };
+    while ((n = smooth_axis_event_queue_drain(&coal_q, batch, 8)) > 0) {
+        for (size_t e = 0; e < n; e++) {
+            assert(!seen[batch[e].axis]);
+            seen[batch[e].axis] = true;
+            assert(batch[e].u16 == latest[batch[e].axis]);
+            assert(batch[e].timestamp >= 5000u && batch[e].timestamp < 5000u + SCANS);
+        }
+    }
+    for (int a = 0; a < AXES; a++) { assert(seen[a] == (latest[a] != 0xFFFF)); }
+    
+    // Undersized COALESCE: same queue as the scanning reference, both paths taken
+    assert(smooth_axis_event_queue_count(&sq_q) == smooth_axis_event_queue_count(&ref_q));
+    assert(smooth_axis_event_queue_dropped(&sq_q) == smooth_axis_event_queue_dropped(&ref_q));
+    assert(smooth_axis_event_queue_coalesced(&sq_q) == smooth_axis_event_queue_coalesced(&ref_q));
+    assert(smooth_axis_event_queue_dropped(&sq_q) > 0 && smooth_axis_event_queue_coalesced(&sq_q) > 0);
+    while ((n = smooth_axis_event_queue_drain(&sq_q, batch, 8)) > 0) {
+        size_t got_ref = smooth_axis_event_queue_drain(&ref_q, ref_batch, 8);
+        assert(got_ref == n);
+        for (size_t e = 0; e < n; e++) {
+            assert(batch[e].axis == ref_batch[e].axis && batch[e].u16 == ref_batch[e].u16
+                   && batch[e].timestamp == ref_batch[e].timestamp);
+        }
+    }
+    
+    printf("✓ Test 52: Bank events - %u events match polling in order; drop-oldest keeps the newest 16, "
+           "coalesce keeps %u (one per axis, latest value); 8-slot coalesce matches the scan "
+           "(%u merged, %u dropped)\n", (unsigned)total, (unsigned)queued,
+           (unsigned)smooth_axis_event_queue_coalesced(&ref_q), (unsigned)smooth_axis_event_queue_dropped(&ref_q));
+}
+
+// ============================================================================
+// Test 53: Vector axes (joint update, one report decision, shared noise)
+// ============================================================================
+
+void test_vector_axis(void) {
+    smooth_axis_config_t cfg;
+    smooth_axis_vec_t    vec, shared_vec;
+    smooth_axis_t        scalar[3];
+    uint16_t             raw[3];
+    test_rng_state = 53u;
+    
+    smooth_axis_config_live_dt(&cfg, 4095, 0.05f);
+    cfg.sticky_zone_norm = 0.01f;
+    smooth_axis_vec_init(&vec, &cfg, 3, SMOOTH_AXIS_VEC_NOISE_PER_AXIS);
+    smooth_axis_vec_init(&shared_vec, &cfg, 3, SMOOTH_AXIS_VEC_NOISE_SHARED);
+    for (int k = 0; k < 3; k++) { smooth_axis_init(&scalar[k], &cfg); }
+    bool has_new = smooth_axis_vec_has_new_value(&vec);
+    assert(!has_new && smooth_axis_vec_get_u16(&vec, 0) == 0);
+    
+    // Slow circles in X/Y, Z still: one physical move touches several components
+    uint32_t vec_reports = 0, scalar_reports = 0, scalar_max = 0, per_axis[3] = { 0 };
+    for (int i = 0; i < 4000; i++) {
+        float phase = (float)i * 0.004f;
+        raw[0] = (uint16_t)(2048.0f + 1500.0f * cosf(phase) + (test_rand_uniform01() - 0.5f) * 12.0f);
+        raw[1] = (uint16_t)(2048.0f + 1500.0f * sinf(phase) + (test_rand_uniform01() - 0.5f) * 12.0f);
+        raw[2] = (uint16_t)(1000.0f + (test_rand_uniform01() - 0.5f) * 12.0f);
+        
+        smooth_axis_vec_update_live_dt(&vec, raw, 0.001f);
+        smooth_axis_vec_update_live_dt(&shared_vec, raw, 0.001f);
+        for (int k = 0; k < 3; k++) {
+            smooth_axis_update_live_dt(&scalar[k], raw[k], 0.001f);
+            
+            // PER_AXIS: components are independent axes (bit-exact with the float library)
+#if !SMOOTH_AXIS_FIXED_POINT
+            assert(smooth_axis_vec_get_norm(&vec, (size_t)k) == smooth_axis_get_norm(&scalar[k]));
+            assert(smooth_axis_vec_get_noise_norm(&vec, (size_t)k) == smooth_axis_get_noise_norm(&scalar[k]));
+#endif
+            assert(fabsf(smooth_axis_vec_get_norm(&vec, (size_t)k) - smooth_axis_get_norm(&scalar[k])) < 1e-4f);
+            per_axis[k] += smooth_axis_has_new_value(&scalar[k]);
+            
+            // SHARED: one estimate, same position math
+            assert(smooth_axis_vec_get_noise_norm(&shared_vec, (size_t)k)
+                   == smooth_axis_vec_get_noise_norm(&shared_vec, 0));
+            assert(smooth_axis_vec_get_norm(&shared_vec, (size_t)k) == smooth_axis_vec_get_norm(&vec, (size_t)k));
+        }
+        vec_reports += smooth_axis_vec_has_new_value(&vec);
+        (void)smooth_axis_vec_has_new_value(&shared_vec);
+    }
+    for (int k = 0; k < 3; k++) {
+        scalar_reports += per_axis[k];
+        scalar_max      = per_axis[k] > scalar_max ? per_axis[k] : scalar_max;
+    }
+    assert(vec_reports >= scalar_max);              // Never less responsive than its busiest component
+    assert(vec_reports * 10 < scalar_reports * 7);  // Staggered X/Y reports merge
+    
+    float mean_noise = (smooth_axis_vec_get_noise_norm(&vec, 0) + smooth_axis_vec_get_noise_norm(&vec, 1)
+                        + smooth_axis_vec_get_noise_norm(&vec, 2)) / 3.0f;
+    assert(fabsf(smooth_axis_vec_get_noise_norm(&shared_vec, 0) - mean_noise) < 0.25f * mean_noise);
+    
+    // Reset seeds all components (counted as reported); out-of-range reads are 0
+    uint16_t seed[3] = { 100, 2000, 4095 };
+    smooth_axis_vec_reset(&vec, seed);
+    for (int k = 0; k < 3; k++) {
+        smooth_axis_reset(&scalar[k], seed[k]);
+        assert(smooth_axis_vec_get_u16(&vec, (size_t)k) == smooth_axis_get_u16(&scalar[k]));
+    }
+    has_new = smooth_axis_vec_has_new_value(&vec);
+    assert(!has_new);
+    assert(smooth_axis_vec_get_u16(&vec, 3) == 0 && smooth_axis_vec_get_norm(&vec, 7) == 0.0f);
+    
+    // AUTO_DT: one warmup (one timer read) per vector update
+    smooth_axis_config_auto_dt(&cfg, 1023, 0.05f, counted_timer);
+    smooth_axis_vec_init(&vec, &cfg, 2, SMOOTH_AXIS_VEC_NOISE_SHARED);
+    uint32_t reads = 0;
+    for (int i = 0; i < 300; i++) {
+        mock_time_ms        = 100u + 2u * (uint32_t)i;
+        counted_timer_reads = 0;
+        smooth_axis_vec_update_auto_dt(&vec, raw);
+        assert(counted_timer_reads <= 1);
+        reads += counted_timer_reads;
+    }
+    assert(reads == SMOOTH_AXIS_INIT_CALIBRATION_CYCLES + 1u);
+    
+    printf("✓ Test 53: Vector axis - components match scalar axes, %u vector reports vs %u scalar "
+           "(%u/%u/%u), shared noise %.5f vs mean %.5f\n",
+           (unsigned)vec_reports, (unsigned)scalar_reports, (unsigned)per_axis[0], (unsigned)per_axis[1],
+           (unsigned)per_axis[2], smooth_axis_vec_get_noise_norm(&shared_vec, 0), mean_noise);
+}
+
+// ----------------------------------------------------------------------------
+// Test 54: Fixed-period WCET axis matches a polled LIVE_DT axis
+// ----------------------------------------------------------------------------
+
+void test_wcet_axis(void) {
+    smooth_axis_config_t cfg;
+    smooth_axis_wcet_t   wcet;
+    smooth_axis_t        axis;
+    test_rng_state = 54u;
+    
+    smooth_axis_config_live_dt(&cfg, 4095, 0.02f);
+    cfg.sticky_zone_norm = 0.01f;
+    smooth_axis_wcet_init(&wcet, &cfg, 0.001f, 2048);
+    smooth_axis_init(&axis, &cfg);
+    smooth_axis_reset(&axis, 2048);
+    assert(smooth_axis_wcet_get_u16(&wcet) == smooth_axis_get_u16(&axis));
+    bool has_new = smooth_axis_wcet_has_new_value(&wcet);
+    assert(!has_new);
+    
+    // Noisy triangle through both sticky zones and past max_raw (input clip)
+    uint32_t reports = 0, u16_off = 0;
+    for (int i = 0; i < 6000; i++) {
+        int   phase = i % 3000;
+        float base  = phase < 1500 ? (float)phase * 3.0f : (float)(3000 - phase) * 3.0f;
+        uint16_t raw = (uint16_t)(base + (test_rand_uniform01() - 0.5f) * 16.0f + 8.0f);
+        
+        smooth_axis_wcet_update(&wcet, raw);
+        smooth_axis_update_live_dt(&axis, raw, 0.001f);
+        
+#if !SMOOTH_AXIS_FIXED_POINT
+        assert(smooth_axis_wcet_get_norm(&wcet) == smooth_axis_get_norm(&axis));
+        assert(smooth_axis_wcet_get_noise_norm(&wcet) == smooth_axis_get_noise_norm(&axis));
+        bool reported      = smooth_axis_has_new_value(&axis);
+        bool wcet_reported = smooth_axis_wcet_has_new_value(&wcet);
+        assert(wcet_reported == reported);
+        reports += reported;
+#else
+        assert(fabsf(smooth_axis_wcet_get_norm(&wcet) - smooth_axis_get_norm(&axis)) < 1e-4f);
+        reports += smooth_axis_wcet_has_new_value(&wcet);
+        (void)smooth_axis_has_new_value(&axis);
+#endif
+        int du = (int)smooth_axis_wcet_get_u16(&wcet) - (int)smooth_axis_get_u16(&axis);
+        assert(du >= -1 && du <= 1);
+        u16_off += du != 0;
+    }
+    assert(reports > 100);
+    assert(smooth_axis_wcet_get_u16(&wcet) == 0);  // Ends in the low sticky zone
+    
+    // The decision is made in update(): unpolled reports latch until read
+    smooth_axis_wcet_reset(&wcet, 1000);
+    for (int i = 0; i < 200; i++) { smooth_axis_wcet_update(&wcet, 3000); }
+    bool latched = smooth_axis_wcet_has_new_value(&wcet);
+    bool cleared  = !smooth_axis_wcet_has_new_value(&wcet);
+    assert(latched && cleared);
+    assert(smooth_axis_wcet_get_u16(&wcet) > 2900);
+    
+    printf("✓ Test 54: WCET axis matches polled LIVE_DT axis (%u reports, %u u16 off by one)\n",
+           (unsigned)reports, (unsigned)u16_off);
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
 
 int main(void) {
     printf("=== smooth_axis API Sanity Tests (Enhanced) ===\n");
+    printf("Arithmetic: %s\n", SMOOTH_AXIS_FIXED_POINT ? "FIXED_POINT (Q30)" : "float");
+    printf("Counters:   %s\n", SMOOTH_AXIS_STATS ? "SMOOTH_AXIS_STATS" : "off");
+#if SMOOTH_AXIS_CHECK_LEVEL == 1
+    printf("Checks:     RELEASE (bad arguments return early)\n");
+#else
+    printf("Checks:     DEBUG (bad arguments assert)\n");
+    printf("Note: NULL pointer tests skipped (they would assert)\n");
+    printf("      To test NULL handling, compile with: gcc -DSMOOTH_AXIS_CHECK_LEVEL=1 ...\n");
+#endif
 #ifdef NDEBUG
-    printf("Build mode: RELEASE (assertions disabled)\n\n");
+    printf("WARNING: suite built with NDEBUG - its assert()s are compiled out\n\n");
 #else
-    printf("Build mode: DEBUG (assertions enabled)\n");
-    printf("Note: NULL pointer tests skipped in debug mode (they would assert)\n");
-    printf("      To test NULL handling, compile with: gcc -DNDEBUG ...\n\n");
+    printf("Suite:      assertions enabled\n\n");
 #endif
     
     // Core safety tests
@@ -853,7 +2514,74 @@ int main(void) {
     test_two_independent_axes();
     test_diagnostic_functions();
     
-    printf("\n=== All 29 tests passed! ===\n");
+    // Multi-axis bank
+    test_bank_matches_independent_axes_live_dt();
+    test_bank_matches_independent_axes_auto_dt();
+    test_bank_bounds_and_mode();
+    
+    // Behavioral guarantees
+    test_guarantee_step_settle_time();
+    test_guarantee_noisy_ramp_monotonic();
+    
+    // Block ingestion
+    test_block_update_matches_sequential();
+    
+    // ISR / main-loop split
+    test_spsc_matches_direct_polling();
+    
+    // Event-driven reporting
+    test_bank_change_mask_matches_polling();
+    
+    // Shared config
+    test_shared_config_matches_copied_config();
+    
+    // Precomputed mapping
+    test_mapping_exact_endpoints();
+    
+    // AUTO_DT timebase
+    test_auto_dt_fast_loop_timebase();
+    test_auto_dt_tracking_follows_rate_change();
+    
+    // Header-only variant
+    test_static_axis_matches_runtime_axis();
+    
+    // Idle detection
+    test_idle_hold_and_wake();
+    
+    // Fast-start warmup
+    test_fast_warmup_and_seed();
+    
+    // Deep-sleep snapshot
+    test_snapshot_restore();
+    
+    // Multiplexed scan scheduler
+    test_sched_adaptive_rates();
+    
+    // Oversampling front-end
+    test_decimation_front_end();
+    
+    // Instrumentation counters
+    test_stats_counters();
+    
+    // Lazily cached output
+    test_output_cache();
+    
+    // Packed state
+    test_compact_axes();
+    
+    // Shared AUTO_DT timebase
+    test_auto_dt_group_warmup();
+    
+    // Push-style report delivery
+    test_bank_event_queue();
+    
+    // Multi-component axes
+    test_vector_axis();
+    
+    // Constant-time update
+    test_wcet_axis();
+    
+    printf("\n=== All 54 tests passed! ===\n");
     return 0;
 }
 
@@ -861,8 +2589,8 @@ int main(void) {
 
 /*  Command line (copy paste): Ctrl+C -> Ctrl+V
 --------------------------------------
-# Compile in release mode (full test coverage)
-gcc -o test_api -DNDEBUG -I./include ./tests/test_api_sanity_enhanced.c ./src/smooth_axis.c -lm
+# Release argument checks, suite assertions live (full test coverage)
+gcc -o test_api -DSMOOTH_AXIS_CHECK_LEVEL=1 -I./src ./tests/c_tests/test_api_sanity_enhanced.c ./src/smooth_axis*.c -lm
 
 # Run it
 ./test_api
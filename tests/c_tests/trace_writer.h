@@ -0,0 +1,273 @@
+/**
+ * @file trace_writer.h
+ * @brief Buffered fixed-record binary trace writer for the test harnesses
+ * @author Jonatan Vider
+ *
+ * The ramp and step harnesses log one row per filter update. As text that is
+ * dozens of bytes and a printf per sample, and the plot scripts then spend most
+ * of their time parsing it back. A trace is instead written as fixed-size
+ * little-endian records behind a header that describes the columns, so Python
+ * maps it straight into a structured array (numpy.memmap, see trace_io.py).
+ *
+ * File layout (all integers little-endian, independent of the host):
+ *
+ *   offset  size  field
+ *   0       8     magic "SATRACE\0"
+ *   8       2     version (TRACE_FORMAT_VERSION)
+ *   10      2     column count N
+ *   12      4     record size in bytes
+ *   16      4     data offset (= 24 + 32·N)
+ *   20      4     reserved (0)
+ *   24      32·N  column descriptors:
+ *                   char name[24]    NUL-padded
+ *                   char type[4]     NumPy type code, NUL-padded ("f4", "u4", "u2", "u1")
+ *                   u32  offset      byte offset of the field inside a record
+ *   data    ...   records, packed in column order, no padding
+ *
+ * The record count is (file size - data offset) / record size, so a trace is
+ * readable while it is still being written and a truncated tail is ignored.
+ *
+ * With csv_path set, every record is also written as a CSV row (the optional
+ * text export, same columns, per-column printf format).
+ *
+ * Typical usage:
+ * @code
+ * static const trace_column_t cols[] = {
+ *     { "t_sec",   TRACE_F32, "%.6f" },
+ *     { "out_u16", TRACE_U16, "%u"   },
+ * };
+ * trace_writer_t tw;
+ * if (!trace_open(&tw, "run.bin", NULL, cols, 2)) { ... }
+ * for (...) {
+ *     trace_put_f32(&tw, t);
+ *     trace_put_u16(&tw, out);
+ *     trace_end_record(&tw);
+ * }
+ * if (!trace_close(&tw)) { ... }
+ * @endcode
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define TRACE_FORMAT_VERSION 1
+#define TRACE_MAX_COLUMNS    16
+#define TRACE_NAME_LEN       24
+#define TRACE_HEADER_BYTES   24
+#define TRACE_COLUMN_BYTES   32
+#define TRACE_BUFFER_BYTES   65536  // Whole records only; flushed with one fwrite
+
+typedef enum {
+  TRACE_F32,  // IEEE-754 binary32
+  TRACE_U32,
+  TRACE_U16,
+  TRACE_U8
+} trace_type_t;
+
+typedef struct {
+  const char   *name;     // Column name (at most TRACE_NAME_LEN - 1 chars)
+  trace_type_t  type;
+  const char   *csv_fmt;  // printf format for the CSV export (F32: "%.6f", U32: "%lu", else "%u")
+} trace_column_t;
+
+typedef struct {
+  FILE                 *bin;
+  FILE                 *csv;      // NULL unless the CSV export is enabled
+  const trace_column_t *cols;
+  size_t                num_cols;
+  size_t                col;      // Next column of the current record
+  size_t                record_size;
+  size_t                pos;      // Bytes used in buf
+  bool                  ok;       // False after any write error or misuse
+  uint8_t               buf[TRACE_BUFFER_BYTES];
+} trace_writer_t;
+
+// -----------------------------------------------------------------------------
+// Internal helpers
+// -----------------------------------------------------------------------------
+
+static inline size_t trace_type_size(trace_type_t type) {
+    switch (type) {
+        case TRACE_F32: return 4;
+        case TRACE_U32: return 4;
+        case TRACE_U16: return 2;
+        default:        return 1;
+    }
+}
+
+static inline const char *trace_type_code(trace_type_t type) {
+    switch (type) {
+        case TRACE_F32: return "f4";
+        case TRACE_U32: return "u4";
+        case TRACE_U16: return "u2";
+        default:        return "u1";
+    }
+}
+
+static inline void trace_le16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void trace_le32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void trace_flush(trace_writer_t *w) {
+    if (w->pos > 0 && fwrite(w->buf, 1, w->pos, w->bin) != w->pos) { w->ok = false; }
+    w->pos = 0;
+}
+
+// Checks the column order and returns where the next field goes
+static inline uint8_t *trace_slot(trace_writer_t *w, trace_type_t type) {
+    if (w->col >= w->num_cols || w->cols[w->col].type != type) {
+        w->ok = false;  // Wrong column type or too many fields: keep the layout intact
+        return NULL;
+    }
+    uint8_t *p = w->buf + w->pos;
+    w->pos += trace_type_size(type);
+    return p;
+}
+
+static inline void trace_csv_sep(trace_writer_t *w) {
+    fputc(w->col + 1 < w->num_cols ? ',' : '\n', w->csv);
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Create a trace file and write its header
+ *
+ * @param w        Writer state (large: keep off small stacks)
+ * @param bin_path Binary trace path
+ * @param csv_path Optional CSV export path (NULL = binary only)
+ * @param cols     Column descriptors (referenced until trace_close())
+ * @param num_cols Number of columns [1 .. TRACE_MAX_COLUMNS]
+ * @return false if a file cannot be opened (nothing is left open)
+ */
+static inline bool trace_open(trace_writer_t *w,
+                              const char *bin_path,
+                              const char *csv_path,
+                              const trace_column_t *cols,
+                              size_t num_cols) {
+    if (num_cols == 0 || num_cols > TRACE_MAX_COLUMNS) { return false; }
+
+    w->bin = fopen(bin_path, "wb");
+    if (!w->bin) { return false; }
+    w->csv = NULL;
+    if (csv_path) {
+        w->csv = fopen(csv_path, "w");
+        if (!w->csv) {
+            fclose(w->bin);
+            return false;
+        }
+    }
+
+    w->cols        = cols;
+    w->num_cols    = num_cols;
+    w->col         = 0;
+    w->record_size = 0;
+    w->pos         = 0;
+    w->ok          = true;
+
+    uint8_t *p = w->buf + TRACE_HEADER_BYTES;
+    for (size_t i = 0; i < num_cols; i++, p += TRACE_COLUMN_BYTES) {
+        memset(p, 0, TRACE_COLUMN_BYTES);
+        strncpy((char *)p, cols[i].name, TRACE_NAME_LEN - 1);
+        memcpy(p + TRACE_NAME_LEN, trace_type_code(cols[i].type), 2);
+        trace_le32(p + TRACE_NAME_LEN + 4, (uint32_t)w->record_size);
+        w->record_size += trace_type_size(cols[i].type);
+    }
+
+    uint8_t *h = w->buf;
+    memcpy(h, "SATRACE", 8);
+    trace_le16(h + 8, TRACE_FORMAT_VERSION);
+    trace_le16(h + 10, (uint16_t)num_cols);
+    trace_le32(h + 12, (uint32_t)w->record_size);
+    trace_le32(h + 16, (uint32_t)(TRACE_HEADER_BYTES + TRACE_COLUMN_BYTES * num_cols));
+    trace_le32(h + 20, 0);
+    w->pos = TRACE_HEADER_BYTES + TRACE_COLUMN_BYTES * num_cols;
+
+    if (w->csv) {
+        for (size_t i = 0; i < num_cols; i++) {
+            fprintf(w->csv, "%s%c", cols[i].name, i + 1 < num_cols ? ',' : '\n');
+        }
+    }
+    return true;
+}
+
+static inline void trace_put_f32(trace_writer_t *w, float v) {
+    uint8_t *p = trace_slot(w, TRACE_F32);
+    if (!p) { return; }
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    trace_le32(p, bits);
+    if (w->csv) {
+        fprintf(w->csv, w->cols[w->col].csv_fmt, (double)v);
+        trace_csv_sep(w);
+    }
+    w->col++;
+}
+
+static inline void trace_put_u32(trace_writer_t *w, uint32_t v) {
+    uint8_t *p = trace_slot(w, TRACE_U32);
+    if (!p) { return; }
+    trace_le32(p, v);
+    if (w->csv) {
+        fprintf(w->csv, w->cols[w->col].csv_fmt, (unsigned long)v);
+        trace_csv_sep(w);
+    }
+    w->col++;
+}
+
+static inline void trace_put_u16(trace_writer_t *w, uint16_t v) {
+    uint8_t *p = trace_slot(w, TRACE_U16);
+    if (!p) { return; }
+    trace_le16(p, v);
+    if (w->csv) {
+        fprintf(w->csv, w->cols[w->col].csv_fmt, (unsigned)v);
+        trace_csv_sep(w);
+    }
+    w->col++;
+}
+
+static inline void trace_put_u8(trace_writer_t *w, uint8_t v) {
+    uint8_t *p = trace_slot(w, TRACE_U8);
+    if (!p) { return; }
+    *p = v;
+    if (w->csv) {
+        fprintf(w->csv, w->cols[w->col].csv_fmt, (unsigned)v);
+        trace_csv_sep(w);
+    }
+    w->col++;
+}
+
+/** @brief Finish the current record (every column must have been put, in order) */
+static inline void trace_end_record(trace_writer_t *w) {
+    if (w->col != w->num_cols) { w->ok = false; }
+    w->col = 0;
+    if (TRACE_BUFFER_BYTES - w->pos < w->record_size) { trace_flush(w); }
+}
+
+/**
+ * @brief Flush and close the trace (and the CSV export)
+ *
+ * @return false if any write failed or a record was malformed
+ */
+static inline bool trace_close(trace_writer_t *w) {
+    trace_flush(w);
+    if (fclose(w->bin) != 0) { w->ok = false; }
+    if (w->csv && fclose(w->csv) != 0) { w->ok = false; }
+    w->bin = NULL;
+    w->csv = NULL;
+    return w->ok;
+}
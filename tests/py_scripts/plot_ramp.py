@@ -1,18 +1,24 @@
 #!/usr/bin/env python3
 """
-Evidence boards for smooth_axis CSV logs.
+Evidence boards for smooth_axis ramp traces (binary, or the CSV export).
 Refactored for maintainability while preserving exact logic.
+
+Metrics for all scenarios are computed in one vectorized batch
+(trace_analysis.TraceBatch); --no-render prints only the accuracy tables and
+never imports matplotlib.
 """
 
 import os
 import glob
 import math
+import argparse
 import numpy as np
-import pandas as pd
-import matplotlib.pyplot as plt
 from dataclasses import dataclass, field
 from typing import List, Dict, Optional, Tuple, Any
 
+from trace_io import load_arrays, trace_stem
+from trace_analysis import TraceBatch
+
 # Multiplier = 3.0 (Sigma Scaling}) X 1.25 (MAD Correction) X 2.0 (Zero-Injection) = 7.5
 RAW_NOISE_RMS_TO_PTP_MULTIPLIER = 7.5
 
@@ -43,7 +49,7 @@ class Config:
 @dataclass
 class ScenarioMeta:
     """Metadata parsed from filename."""
-    path: str
+    path: str  # Trace stem (no extension)
     basename: str
     max_raw: int
     settle_time: float
@@ -148,67 +154,64 @@ class Utils:
         return outMin + t * (outMax - outMin)
 
 
-class SignalAnalyzer:
-
-    @staticmethod
-    def measure_settle_time_robust(df: pd.DataFrame, motion_end_t: float = 1.0) -> Tuple[
-        Optional[float], Optional[float]]:
-        """
-        Robust Settle Time v2 (Truncated Area Method).
-        Returns: (settled_timestamp, delay_seconds)
-        """
-        tail = df[df["t_sec"] >= motion_end_t].copy()
-        if tail.empty:
-            return None, None
-
-        y_start = np.interp(motion_end_t, df['t_sec'], df['out_u16'])
+class RampAnalysis:
+    """Update and settle-time metrics for a list of scenarios, in one batch."""
 
-        t_mid = (tail['t_sec'].max() + tail['t_sec'].min()) / 2
-        steady_state_data = tail[tail['t_sec'] > t_mid]
-        if steady_state_data.empty:
-            return None, None
-
-        y_final = steady_state_data['out_u16'].mean()
-        step_height = y_final - y_start
-
-        if abs(step_height) < 1.0:
-            return motion_end_t, 0.0
+    def __init__(self, scenarios: List[ScenarioMeta], motion_end_t: float = 1.0, use_cache: bool = True):
+        self.scenarios = scenarios
+        self.index = {s.path: i for i, s in enumerate(scenarios)}
+        self.batch = TraceBatch([load_arrays(s.path, use_cache) for s in scenarios]) if scenarios else None
+        if self.batch is None:
+            return
 
-        if step_height > 0:
-            crossed = tail[tail['out_u16'] >= y_final]
-        else:
-            crossed = tail[tail['out_u16'] <= y_final]
+        # A false update moves against the ramp direction
+        falling = np.array([s.target_raw < s.init_raw for s in scenarios])
+        self.false_updates, self.total_updates = self.batch.update_stats(falling)
 
-        if crossed.empty:
-            valid_tail = tail
-        else:
-            cutoff_t = crossed['t_sec'].iloc[0]
-            valid_tail = tail[tail['t_sec'] <= cutoff_t].copy()
+        # Robust settle time (truncated-area method), NaN where undefined
+        self.settled_t, self.delay = self.batch.settle_time_robust(motion_end_t)
 
-        valid_tail['error'] = y_final - valid_tail['out_u16']
-        area = np.trapezoid(valid_tail['error'].abs(), valid_tail['t_sec'])
-        tau = area / abs(step_height)
-        delay = 3.0 * tau
+    def __len__(self) -> int:
+        return len(self.scenarios)
 
-        return motion_end_t + delay, delay
+    def column(self, meta: ScenarioMeta, name: str) -> np.ndarray:
+        return self.batch.column(name, self.index[meta.path])
 
-    @staticmethod
-    def calculate_update_stats(df: pd.DataFrame) -> Tuple[int, int]:
+    def update_stats(self, meta: ScenarioMeta) -> Tuple[int, int]:
         """Returns (false_updates, total_updates)"""
-        if "has_new" not in df.columns or "out_u16" not in df.columns:
-            return 0, 0
-
-        events = df[df["has_new"] == 1]
-        total_updates = int(len(events))
-
-        if total_updates <= 1:
-            false_updates = 0
-        else:
-            values = events["out_u16"].to_numpy()
-            diffs = values[1:] - values[:-1]
-            false_updates = int((diffs < 0).sum())
+        i = self.index[meta.path]
+        return int(self.false_updates[i]), int(self.total_updates[i])
 
-        return false_updates, total_updates
+    def settle_time(self, meta: ScenarioMeta) -> Tuple[Optional[float], Optional[float]]:
+        """Returns (settled_timestamp, delay_seconds)"""
+        i = self.index[meta.path]
+        if np.isnan(self.delay[i]):
+            return None, None
+        return float(self.settled_t[i]), float(self.delay[i])
+
+    def fill_stats(self, stats: StatsTracker):
+        for meta in self.scenarios:
+            stats.add_batch(*self.update_stats(meta))
+            _, delay = self.settle_time(meta)
+            if delay is not None:
+                stats.add_timing_error(meta.settle_time, delay)
+
+    def report_lines(self) -> List[str]:
+        """Per-scenario accuracy table."""
+        lines = [f"{'env':>8s} {'jit':>6s} {'noise':>6s} {'settle':>8s} {'measured':>9s} {'error':>7s} {'false/total':>12s}"]
+        for meta in sorted(self.scenarios, key=lambda m: (m.jitter ** 2 + m.noise ** 2, m.settle_time)):
+            false_u, total_u = self.update_stats(meta)
+            _, delay = self.settle_time(meta)
+            if delay is None or meta.settle_time <= 0:
+                measured, error = "-", "-"
+            else:
+                measured = f"{delay * 1000:.0f}ms"
+                error = f"{(delay - meta.settle_time) / meta.settle_time:+.1%}"
+            lines.append(f"{Definitions.describe_env(meta.jitter, meta.noise):>8s} "
+                         f"{meta.jitter * 100:5.1f}% {meta.noise * 100:5.1f}% "
+                         f"{meta.settle_time * 1000:6.0f}ms {measured:>9s} {error:>7s} "
+                         f"{f'{false_u}/{total_u}':>12s}")
+        return lines
 
 
 # ============================
@@ -219,11 +222,11 @@ class ScenarioParser:
 
     @staticmethod
     def parse_filename(path: str) -> Optional[ScenarioMeta]:
-        base = os.path.basename(path)
-        if not base.startswith("smooth_axis_") or not base.endswith(".csv"):
+        base = os.path.basename(trace_stem(path))
+        if not base.startswith("smooth_axis_"):
             return None
 
-        name = base[len("smooth_axis_"):-len(".csv")]
+        name = base[len("smooth_axis_"):]
         parts = name.split("_")
 
         if len(parts) < 11:
@@ -265,16 +268,18 @@ class ScenarioParser:
             return None
 
         return ScenarioMeta(
-                path=path, basename=base, max_raw=max_raw, settle_time=settle_time,
+                path=trace_stem(path), basename=base, max_raw=max_raw, settle_time=settle_time,
                 dt=dt, jitter=jitter, noise=noise, move_type=move_type,
                 init_raw=init_raw, target_raw=target_raw,
         )
 
     @staticmethod
     def load_all(csv_dir: str) -> List[ScenarioMeta]:
-        paths = sorted(glob.glob(os.path.join(csv_dir, "*.csv")))
+        # One scenario per stem: the .bin trace wins over its CSV export
+        stems = {trace_stem(p) for ext in ("bin", "csv")
+                 for p in glob.glob(os.path.join(csv_dir, "*." + ext))}
         scenarios = []
-        for p in paths:
+        for p in sorted(stems):
             meta = ScenarioParser.parse_filename(p)
             if meta:
                 scenarios.append(meta)
@@ -316,19 +321,17 @@ class ScenarioFilter:
 
 class EvidenceBoardPlotter:
 
-    def __init__(self, scenarios: List[ScenarioMeta]):
-        self.scenarios = scenarios
-        self.stats = StatsTracker()
+    def __init__(self, analysis: RampAnalysis, stats: StatsTracker):
+        self.analysis = analysis
+        self.stats = stats
 
     def plot_env_matrix(self):
         """
         Main plotting routine for Board #2.
         """
-        scenarios = ScenarioFilter.for_env_matrix(self.scenarios)
-        if not scenarios:
-            print("No env-matrix scenarios found.")
-            return
+        import matplotlib.pyplot as plt
 
+        scenarios = self.analysis.scenarios
         env_pairs, settle_vals, grid = ScenarioFilter.build_env_matrix_grid(scenarios)
 
         n_rows, n_cols = len(env_pairs), len(settle_vals)
@@ -376,10 +379,12 @@ class EvidenceBoardPlotter:
 
     def _render_single_panel(self, ax, meta: ScenarioMeta, is_leftmost: bool, is_top: bool):
         """Draws one specific scenario onto one specific axis."""
-        df = pd.read_csv(meta.path)
+        col = lambda name: self.analysis.column(meta, name)
+        t_sec = col("t_sec")
+        out_u16 = col("out_u16")
 
         # Prep Data
-        noise_u16, thresh_u16 = self._prep_diagnostic_lines(df)
+        noise_u16, thresh_u16 = self._prep_diagnostic_lines(meta)
 
         # Setup Axes
         ax.set_ylim(0, 1023)
@@ -391,26 +396,26 @@ class EvidenceBoardPlotter:
 
         # Draw Diagnostics
         if noise_u16 is not None:
-            ax.plot(df["t_sec"], noise_u16, linewidth=1.5, linestyle="--", color=Config.COLOR_NOISE_LINE, alpha=0.8)
+            ax.plot(t_sec, noise_u16, linewidth=1.5, linestyle="--", color=Config.COLOR_NOISE_LINE, alpha=0.8)
         if thresh_u16 is not None:
-            ax.plot(df["t_sec"], thresh_u16, linewidth=1.5, linestyle=":", color=Config.COLOR_THRESH_LINE, alpha=0.3)
+            ax.plot(t_sec, thresh_u16, linewidth=1.5, linestyle=":", color=Config.COLOR_THRESH_LINE, alpha=0.3)
 
         # Draw Signals
-        ax.plot(df["t_sec"], df["raw_base"], linewidth=0.2, color=Config.COLOR_BASELINE)
-        ax.plot(df["t_sec"], df["raw_noisy"], linewidth=0.05, alpha=0.5, color=Config.COLOR_NOISY)
-        ax.plot(df["t_sec"], df["out_u16"], linewidth=0.5, color=Config.COLOR_SMOOTH)
-        # ax.plot(df["t_sec"], df["acceleration"], linewidth=0.5, color="black", alpha=0.3)
+        ax.plot(t_sec, col("raw_base"), linewidth=0.2, color=Config.COLOR_BASELINE)
+        ax.plot(t_sec, col("raw_noisy"), linewidth=0.05, alpha=0.5, color=Config.COLOR_NOISY)
+        ax.plot(t_sec, out_u16, linewidth=0.5, color=Config.COLOR_SMOOTH)
+        # ax.plot(t_sec, col("acceleration"), linewidth=0.5, color="black", alpha=0.3)
 
         # Draw Events
-        events = df[df["has_new"] == 1]
-        ax.scatter(events["t_sec"], events["out_u16"], s=3, color=Config.COLOR_EVENT)
+        events = col("has_new") == 1
+        ax.scatter(t_sec[events], out_u16[events], s=3, color=Config.COLOR_EVENT)
 
 
         # Update Stats
-        self._add_update_stats_text(ax, df)
+        self._add_update_stats_text(ax, meta)
 
-        # Settle Time Analysis (Calculates Error)
-        # self._add_settle_time_analysis(ax, df, Config.MOTION_END_T, meta.settle_time)
+        # Settle Time Analysis
+        # self._add_settle_time_analysis(ax, meta, Config.MOTION_END_T)
 
         # Labels
         if is_top:
@@ -418,30 +423,27 @@ class EvidenceBoardPlotter:
         if is_leftmost:
             self._set_row_label(ax, meta.jitter, meta.noise)
 
-    def _prep_diagnostic_lines(self, df: pd.DataFrame):
+    def _prep_diagnostic_lines(self, meta: ScenarioMeta):
         noise_u16 = None
         thresh_u16 = None
-        if "noise_norm" in df.columns and "thresh_norm" in df.columns:
-            noise_u16 = df["noise_norm"] * RAW_NOISE_RMS_TO_PTP_MULTIPLIER * 1023
+        if "noise_norm" in self.analysis.batch.cols and "thresh_norm" in self.analysis.batch.cols:
+            noise_u16 = self.analysis.column(meta, "noise_norm") * RAW_NOISE_RMS_TO_PTP_MULTIPLIER * 1023
             # noise_u16 = Utils.map_ranges(noise_u16,0,1,0,1020)
-            thresh_u16 = Utils.map_ranges(df["thresh_norm"] * 1023, Config.MIN_THRESH, Config.MAX_THRESH, 0, 1022)
+            thresh_u16 = Utils.map_ranges(self.analysis.column(meta, "thresh_norm") * 1023,
+                                          Config.MIN_THRESH, Config.MAX_THRESH, 0, 1022)
         return noise_u16, thresh_u16
 
-    def _add_update_stats_text(self, ax, df: pd.DataFrame):
-        false_u, total_u = SignalAnalyzer.calculate_update_stats(df)
-        self.stats.add_batch(false_u, total_u)
+    def _add_update_stats_text(self, ax, meta: ScenarioMeta):
+        false_u, total_u = self.analysis.update_stats(meta)
 
         stats_text = f"false: {false_u} / {total_u}"
         ax.text(0.98, 0.03, stats_text, transform=ax.transAxes,
                 ha="right", va="bottom", fontsize=6, color="0.3")
 
-    def _add_settle_time_analysis(self, ax, df, motion_end_t, target_settle_time):
-        t_first, delay = SignalAnalyzer.measure_settle_time_robust(df, motion_end_t)
+    def _add_settle_time_analysis(self, ax, meta: ScenarioMeta, motion_end_t):
+        t_first, delay = self.analysis.settle_time(meta)
 
         if t_first is not None and delay is not None:
-            # Record the error stat
-            self.stats.add_timing_error(target_settle_time, delay)
-
             ax.axvline(motion_end_t, linestyle="--", linewidth=0.6, color="0.5", alpha=0.4)
             ax.axvline(t_first, linestyle="--", linewidth=0.8, color="0.2", alpha=0.4)
 
@@ -463,6 +465,8 @@ class EvidenceBoardPlotter:
         ax.set_ylabel(f"{env_label} ({jit_r * 100:.1f}%, {noise_r * 100:.1f}%)")
 
     def _decorate_figure(self, fig):
+        import matplotlib.pyplot as plt
+
         fig.text(0.5, 0.98, "smooth_axis: Settle-Time Behavior",
                  ha="center", va="center", fontsize=18, fontweight="bold")
         fig.text(0.5, 0.963, "Noise presets (rows) × τ presets (columns)",
@@ -493,7 +497,16 @@ class EvidenceBoardPlotter:
 # MAIN
 # ============================
 
-def main():
+def parse_args():
+    parser = argparse.ArgumentParser(description="Evidence boards for smooth_axis ramp traces.")
+    parser.add_argument("--no-render", action="store_true",
+                        help="only compute and print the accuracy tables (no matplotlib)")
+    parser.add_argument("--no-cache", action="store_true",
+                        help="re-parse CSV exports instead of using their .npz cache")
+    return parser.parse_args()
+
+
+def main(args) -> None:
     scenarios = ScenarioParser.load_all(Config.CSV_DIR)
     if not scenarios:
         print("No scenarios parsed from:", Config.CSV_DIR)
@@ -501,11 +514,22 @@ def main():
 
     print(f"Loaded {len(scenarios)} scenarios from {Config.CSV_DIR}")
 
-    plotter = EvidenceBoardPlotter(scenarios)
-    plotter.plot_env_matrix()
+    env_scenarios = ScenarioFilter.for_env_matrix(scenarios)
+    if not env_scenarios:
+        print("No env-matrix scenarios found.")
+        return
+
+    # One batch for every metric; rendering only reads the results
+    analysis = RampAnalysis(env_scenarios, Config.MOTION_END_T, use_cache=not args.no_cache)
+    s = StatsTracker()
+    analysis.fill_stats(s)
+
+    if args.no_render:
+        print("\n".join(analysis.report_lines()))
+    else:
+        EvidenceBoardPlotter(analysis, s).plot_env_matrix()
 
     # Reporting
-    s = plotter.stats
 
     # Monotonic Accuracy Report
     if s.total_reports > 0:
@@ -523,7 +547,10 @@ def main():
 
 
 if __name__ == "__main__":
-    main()
+    args = parse_args()
+    main(args)
+    if args.no_render:
+        raise SystemExit(0)
     print("\n" + "="*50)
     print("Ramp test plots saved:")
     print("="*50)
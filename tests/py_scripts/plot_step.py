@@ -2,27 +2,33 @@
 """
 Step Response Accuracy Visualization for smooth_axis library.
 Creates a 2×8 grid showing settle time accuracy under clean and noisy conditions.
+
+All traces are analysed in one vectorized batch (trace_analysis.TraceBatch);
+--no-render stops after the accuracy tables and never imports matplotlib.
 """
 
 import os
+import argparse
 import numpy as np
 import pandas as pd
-import matplotlib.pyplot as plt
-from typing import Dict, Tuple, Optional
+from typing import Dict, List, Tuple, Optional
+
+from trace_io import load_arrays
+from trace_analysis import TraceBatch
 
 
 # ============================
 # CONFIGURATION
 # ============================
 class Config:
-    # Base directory for all CSV files and output
+    # Base directory for all trace/CSV files and output
     BASE_DIR = "tests/data/step_files"
     OUT_DIR = "tests/data/renders"
     SUMMARY_CLEAN = "step_results_clean.csv"
     SUMMARY_NOISY = "step_results_noisy.csv"
 
-    # Trace file pattern: step_trace_{condition}_{settle_ms}ms.csv
-    TRACE_PATTERN = "step_trace_{condition}_{settle_ms}ms.csv"
+    # Trace file pattern: step_trace_{condition}_{settle_ms}ms.bin (or .csv export)
+    TRACE_PATTERN = "step_trace_{condition}_{settle_ms}ms"
 
     # Test parameters
     STEP_TIME_MS = 1000  # When the step occurs
@@ -60,23 +66,21 @@ class DataLoader:
         return pd.read_csv(filepath)
 
     @staticmethod
-    def load_trace(condition: str, settle_ms: int, base_dir: str = ".") -> Optional[pd.DataFrame]:
-        """Load a single trace CSV file."""
+    def load_trace(condition: str, settle_ms: int, base_dir: str = ".",
+                   use_cache: bool = True) -> Optional[Dict[str, np.ndarray]]:
+        """Load a single trace as column arrays (binary, falling back to the CSV export)."""
         filename = Config.TRACE_PATTERN.format(condition=condition, settle_ms=settle_ms)
-        filepath = os.path.join(base_dir, filename)
+        stem = os.path.join(base_dir, filename)
 
-        if not os.path.exists(filepath):
-            print(f"Warning: Trace file not found: {filepath}")
+        if not (os.path.exists(stem + ".bin") or os.path.exists(stem + ".csv")):
+            print(f"Warning: Trace file not found: {stem}.bin")
             return None
 
-        df = pd.read_csv(filepath)
-        # Convert time to seconds
-        df['time_sec'] = df['time_ms'] / 1000.0
-        return df
+        return load_arrays(stem, use_cache)
 
     @staticmethod
-    def load_all_data(base_dir: str = None) -> Tuple[pd.DataFrame, pd.DataFrame, Dict]:
-        """Load all summary and trace data."""
+    def load_all_data(base_dir: str = None, use_cache: bool = True) -> Tuple[pd.DataFrame, pd.DataFrame, "StepAnalysis"]:
+        """Load all summary data and analyse every trace in one batch."""
         if base_dir is None:
             base_dir = Config.BASE_DIR
 
@@ -85,15 +89,69 @@ class DataLoader:
         summary_noisy = DataLoader.load_summary(os.path.join(base_dir, Config.SUMMARY_NOISY))
 
         # Load all trace files
-        traces = {}
+        keys, traces = [], []
         for condition in ['clean', 'noisy']:
-            traces[condition] = {}
             for settle_ms in Config.SETTLE_TIMES_MS:
-                df = DataLoader.load_trace(condition, settle_ms, base_dir)
-                if df is not None:
-                    traces[condition][settle_ms] = df
+                arrays = DataLoader.load_trace(condition, settle_ms, base_dir, use_cache)
+                if arrays is not None:
+                    keys.append((condition, settle_ms))
+                    traces.append(arrays)
+
+        return summary_clean, summary_noisy, StepAnalysis(keys, traces)
+
+
+# ============================
+# ANALYSIS
+# ============================
+class StepAnalysis:
+    """Per-trace step metrics, computed for all traces at once."""
+
+    def __init__(self, keys: List[Tuple[str, int]], traces: List[Dict[str, np.ndarray]]):
+        self.index = {key: i for i, key in enumerate(keys)}
+        self.batch = TraceBatch(traces) if traces else None
+        if self.batch is None:
+            return
+
+        b = self.batch
+        b.cols['time_sec'] = b.cols['time_ms'] / 1000.0
+
+        # Step start: raw_input drops from 900 to 100
+        start = b.step_start_index('raw_input', high=800, low=200)
+        self.step_start_sec = np.where(start >= 0, b.cols['time_sec'][b.starts + np.maximum(start, 0)], np.nan)
+
+        # Exact crossing point: first update event past the 95% threshold
+        self.crossing = b.first_index((b.cols['has_new'] == 1) & (b.cols['crossed_95'] == 1))
+
+        # Falling step (900→100): a false update is an increase
+        self.false_updates, self.total_updates = b.update_stats(falling=True)
+
+    def __len__(self) -> int:
+        return len(self.index)
 
-        return summary_clean, summary_noisy, traces
+    def get(self, condition: str, settle_ms: int) -> Optional[int]:
+        """Batch index of a trace, or None if it was not loaded."""
+        return self.index.get((condition, settle_ms))
+
+    def column(self, i: int, name: str) -> np.ndarray:
+        return self.batch.column(name, i)
+
+    def step_start_time(self, i: int) -> Optional[float]:
+        t = self.step_start_sec[i]
+        return None if np.isnan(t) else float(t)
+
+    def crossing_point(self, i: int) -> Optional[Tuple[float, int]]:
+        """(time_sec, out_u16) of the 95% crossing, or None."""
+        k = self.crossing[i]
+        if k < 0:
+            return None
+        return float(self.column(i, 'time_sec')[k]), int(self.column(i, 'out_u16')[k])
+
+    def measured_settle_ms(self, i: int) -> float:
+        """Crossing time after the step start, as seen in the trace (NaN if undefined)."""
+        start, cross = self.step_start_time(i), self.crossing_point(i)
+        if start is None or cross is None:
+            return float('nan')
+        return (cross[0] - start) * 1000.0
 
 
 # ============================
@@ -101,13 +159,15 @@ class DataLoader:
 # ============================
 class StepResponsePlotter:
 
-    def __init__(self, summary_clean: pd.DataFrame, summary_noisy: pd.DataFrame, traces: Dict):
+    def __init__(self, summary_clean: pd.DataFrame, summary_noisy: pd.DataFrame, analysis: StepAnalysis):
         self.summary_clean = summary_clean
         self.summary_noisy = summary_noisy
-        self.traces = traces
+        self.analysis = analysis
 
     def plot_grid(self, output_path: str):
         """Create the main 2×8 grid plot."""
+        import matplotlib.pyplot as plt
+
         n_rows = 2
         n_cols = len(Config.SETTLE_TIMES_MS)
 
@@ -149,8 +209,8 @@ class StepResponsePlotter:
                            is_leftmost: bool, is_bottom: bool, is_top: bool, is_rightmost: bool = False):
         """Plot a single subplot for one condition and settle time."""
         # Get trace data
-        df = self.traces[condition].get(settle_ms)
-        if df is None:
+        i = self.analysis.get(condition, settle_ms)
+        if i is None:
             ax.set_axis_off()
             ax.text(0.5, 0.5, "Data\nNot Found",
                     ha='center', va='center', transform=ax.transAxes,
@@ -167,38 +227,35 @@ class StepResponsePlotter:
             measured_ms = settle_ms
             error_pct = 0.0
 
-        # Find step start time (when raw_input changes from 900 to 100)
-        step_start_time = None
-        for i in range(1, len(df)):
-            if df.iloc[i - 1]['raw_input'] >= 800 and df.iloc[i]['raw_input'] <= 200:
-                step_start_time = df.iloc[i]['time_sec']
-                break
+        time_axis = self.analysis.column(i, 'time_sec')
+        out_u16 = self.analysis.column(i, 'out_u16')
+        has_new = self.analysis.column(i, 'has_new') == 1
+
+        # Step start time (when raw_input changes from 900 to 100)
+        step_start_time = self.analysis.step_start_time(i)
 
         # Create ideal baseline curve (same for all tests)
         # 900 from 0 to step_start_time, then 100 afterwards
         if step_start_time is not None:
-            time_axis = df['time_sec'].values
             baseline = np.where(time_axis < step_start_time, 900, 100)
             ax.plot(time_axis, baseline,
                     linewidth=0.8, color=Config.COLOR_BASELINE, alpha=0.5,
                     label='Ideal Baseline' if is_leftmost and is_top else '')
 
         # Plot raw input (faint red)
-        ax.plot(df['time_sec'], df['raw_input'],
+        ax.plot(time_axis, self.analysis.column(i, 'raw_input'),
                 linewidth=0.5, alpha=0.3, color=Config.COLOR_INPUT,
                 label='Raw Input' if is_leftmost and is_top else '')
 
         # Plot output (dark blue - matching ramp test)
-        ax.plot(df['time_sec'], df['out_u16'],
+        ax.plot(time_axis, out_u16,
                 linewidth=1.5, color=Config.COLOR_OUTPUT,
                 label='Smooth Axis' if is_leftmost and is_top else '')
 
         # Plot update events (has_new) as light blue dots (s=3)
-        if 'has_new' in df.columns:
-            events = df[df['has_new'] == 1]
-            ax.scatter(events['time_sec'], events['out_u16'],
-                       s=3, color=Config.COLOR_EVENT, zorder=5,
-                       label='Update Event' if is_leftmost and is_top else '')
+        ax.scatter(time_axis[has_new], out_u16[has_new],
+                   s=3, color=Config.COLOR_EVENT, zorder=5,
+                   label='Update Event' if is_leftmost and is_top else '')
 
         # Threshold line (gray dashed horizontal)
         ax.axhline(Config.THRESHOLD_VALUE,
@@ -206,16 +263,12 @@ class StepResponsePlotter:
                    color=Config.COLOR_THRESHOLD, alpha=0.5,
                    label='95% Threshold' if is_leftmost and is_top else '')
 
-        # Find exact crossing point (where has_new=1 AND crossed_95=1)
-        crossing_point = None
-        if 'has_new' in df.columns and 'crossed_95' in df.columns:
-            crossed = df[(df['has_new'] == 1) & (df['crossed_95'] == 1)]
-            if not crossed.empty:
-                crossing_point = crossed.iloc[0]
+        # Exact crossing point (where has_new=1 AND crossed_95=1)
+        crossing_point = self.analysis.crossing_point(i)
 
         # Plot marker at exact crossing point (smaller and thinner)
         if crossing_point is not None:
-            ax.plot(crossing_point['time_sec'], crossing_point['out_u16'],
+            ax.plot(crossing_point[0], crossing_point[1],
                     marker='o', markersize=5, color='black',
                     markerfacecolor='none', markeredgewidth=1, zorder=10,
                     label='Crossing Point' if is_leftmost and is_top else '')
@@ -234,29 +287,17 @@ class StepResponsePlotter:
                 h_align = 'left'
 
             ax.annotate(annotation_text,
-                        xy=(crossing_point['time_sec'], crossing_point['out_u16']),
+                        xy=crossing_point,
                         xytext=xytext_offset, textcoords='offset points',
                         fontsize=6,
                         bbox=dict(boxstyle='round,pad=0.4', facecolor='white',
                                   alpha=0.8, edgecolor='none'),
                         ha=h_align, va='bottom')
 
-        # Calculate and display false update statistics (lower left corner)
-        if 'has_new' in df.columns and 'out_u16' in df.columns:
-            events = df[df['has_new'] == 1]
-            total_updates = int(len(events))
-
-            if total_updates <= 1:
-                false_updates = 0
-            else:
-                values = events['out_u16'].to_numpy()
-                diffs = values[1:] - values[:-1]
-                # For falling step (900→100), false updates are when value increases
-                false_updates = int((diffs > 0).sum())
-
-            stats_text = f"false: {false_updates} / {total_updates}"
-            ax.text(0.98, 0.03, stats_text, transform=ax.transAxes,
-                    ha="right", va="bottom", fontsize=6, color="0.3")
+        # Display false update statistics (lower right corner)
+        stats_text = f"false: {self.analysis.false_updates[i]} / {self.analysis.total_updates[i]}"
+        ax.text(0.98, 0.03, stats_text, transform=ax.transAxes,
+                ha="right", va="bottom", fontsize=6, color="0.3")
 
         # Set axis limits
         ax.set_xlim(Config.TIME_RANGE)
@@ -303,6 +344,8 @@ class StepResponsePlotter:
 
     def _add_figure_labels(self, fig):
         """Add main title, subtitle, row labels, and aggregate metrics."""
+        import matplotlib.pyplot as plt
+
         # Calculate MAPE for both conditions
         clean_mape = self.summary_clean['error_pct'].abs().mean()
         noisy_mape = self.summary_noisy['error_pct'].abs().mean()
@@ -344,7 +387,7 @@ class SummaryReporter:
 
     @staticmethod
     def generate_summary(summary_clean: pd.DataFrame, summary_noisy: pd.DataFrame,
-                         output_path: str):
+                         analysis: StepAnalysis, output_path: str):
         """Generate text summary of test results."""
         # Calculate MAPE (Mean Absolute Percentage Error)
         clean_mape = summary_clean['error_pct'].abs().mean()
@@ -399,6 +442,24 @@ class SummaryReporter:
                     f"noisy={noisy_meas:6.1f}ms ({noisy_err:5.1f}%)"
             )
 
+        # Trace-side table (from the batch analysis)
+        if len(analysis) > 0:
+            lines += [
+                    "",
+                    "Trace Analysis (crossing after step start, false/total updates):",
+                    "-" * 70,
+            ]
+            for condition in ['clean', 'noisy']:
+                for settle_ms in Config.SETTLE_TIMES_MS:
+                    i = analysis.get(condition, settle_ms)
+                    if i is None:
+                        continue
+                    lines.append(
+                            f"  {condition:5s} {settle_ms:4d}ms: "
+                            f"crossing={analysis.measured_settle_ms(i):6.1f}ms, "
+                            f"false={analysis.false_updates[i]}/{analysis.total_updates[i]}"
+                    )
+
         lines.append("=" * 70)
 
         # Write to file
@@ -413,34 +474,47 @@ class SummaryReporter:
 # ============================
 # MAIN
 # ============================
-def main():
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--no-render", action="store_true",
+                        help="only compute and print the accuracy tables (no matplotlib)")
+    parser.add_argument("--no-cache", action="store_true",
+                        help="re-parse CSV exports instead of using their .npz cache")
+    return parser.parse_args()
+
+
+def main(args) -> None:
     """Main entry point."""
     print("Loading step response test data...")
 
     # Load all data
-    summary_clean, summary_noisy, traces = DataLoader.load_all_data()
+    summary_clean, summary_noisy, analysis = DataLoader.load_all_data(use_cache=not args.no_cache)
 
     print(f"Loaded {len(summary_clean)} clean results")
     print(f"Loaded {len(summary_noisy)} noisy results")
-    print(f"Loaded {sum(len(t) for t in traces.values())} trace files")
+    print(f"Loaded {len(analysis)} trace files")
 
-    # Create plotter
-    plotter = StepResponsePlotter(summary_clean, summary_noisy, traces)
+    if not args.no_render:
+        # Create plotter
+        plotter = StepResponsePlotter(summary_clean, summary_noisy, analysis)
 
-    # Generate plot
-    print("\nGenerating step response accuracy plot...")
-    plotter.plot_grid(Config.OUTPUT_PNG)
+        # Generate plot
+        print("\nGenerating step response accuracy plot...")
+        plotter.plot_grid(Config.OUTPUT_PNG)
 
     # Generate summary report
     print("\nGenerating summary report...")
-    SummaryReporter.generate_summary(summary_clean, summary_noisy, Config.OUTPUT_TXT)
+    SummaryReporter.generate_summary(summary_clean, summary_noisy, analysis, Config.OUTPUT_TXT)
 
     print("\n✓ Done! All outputs generated successfully.")
     # plt.show()
 
 
 if __name__ == "__main__":
-    main()
+    args = parse_args()
+    main(args)
+    if args.no_render:
+        raise SystemExit(0)
 
     print("\n" + "="*50)
     print("Step test plots saved:")
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+Vectorized analysis of smooth_axis traces, batched over many traces at once.
+
+All traces of a run are concatenated column-wise into one TraceBatch. Every
+per-trace metric is then a handful of NumPy operations over the whole batch
+(segment reductions with np.bincount), with no Python loop over samples or
+traces. Results come back as one array entry per trace, in input order.
+"""
+
+import numpy as np
+from typing import Dict, Sequence, Tuple
+
+
+class TraceBatch:
+    """Many traces (dicts of equal-length column arrays) as one flat batch."""
+
+    def __init__(self, traces: Sequence[Dict[str, np.ndarray]]):
+        if not traces:
+            raise ValueError("TraceBatch needs at least one trace")
+        names = list(traces[0].keys())
+        self.count = len(traces)
+        self.lengths = np.array([len(t[names[0]]) for t in traces], dtype=np.int64)
+        self.starts = np.concatenate(([0], np.cumsum(self.lengths)[:-1])).astype(np.int64)
+        self.seg = np.repeat(np.arange(self.count), self.lengths)
+        self.local = np.arange(len(self.seg), dtype=np.int64) - self.starts[self.seg]
+
+        # Integers widen to int64 (so diffs of u16 columns cannot wrap), floats to float64
+        self.cols = {}
+        for name in names:
+            col = np.concatenate([np.asarray(t[name]) for t in traces])
+            self.cols[name] = col.astype(np.float64 if col.dtype.kind == "f" else np.int64)
+
+    def __len__(self) -> int:
+        return self.count
+
+    def column(self, name: str, i: int) -> np.ndarray:
+        """View of one column of trace i."""
+        s = self.starts[i]
+        return self.cols[name][s:s + self.lengths[i]]
+
+    def first_index(self, mask: np.ndarray) -> np.ndarray:
+        """Per trace: local index of the first True in `mask`, or -1."""
+        hits = np.flatnonzero(mask)
+        first = np.full(self.count, -1, dtype=np.int64)
+        segs, pos = np.unique(self.seg[hits], return_index=True)  # hits are sorted: first per segment
+        first[segs] = self.local[hits[pos]]
+        return first
+
+    def _same_seg_pairs(self) -> np.ndarray:
+        """mask[k]: samples k and k+1 belong to the same trace."""
+        return self.seg[1:] == self.seg[:-1]
+
+    # -------------------------------------------------------------------------
+    # Update statistics
+    # -------------------------------------------------------------------------
+
+    def update_stats(self, falling) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Per trace (false_updates, total_updates).
+
+        A false update is a declared value moving against the input direction
+        (up for a falling input, down for a rising one). `falling` is one bool
+        for the whole batch or one per trace.
+        """
+        ev = np.flatnonzero(self.cols["has_new"] == 1)
+        seg = self.seg[ev]
+        total = np.bincount(seg, minlength=self.count)
+
+        diffs = np.diff(self.cols["out_u16"][ev])
+        down = np.broadcast_to(np.asarray(falling, dtype=bool), (self.count,))[seg[1:]]
+        wrong = np.where(down, diffs > 0, diffs < 0)
+        wrong &= seg[1:] == seg[:-1]  # Only between events of the same trace
+        false = np.bincount(seg[1:][wrong], minlength=self.count)
+        return false, total
+
+    def step_start_index(self, column: str, high: float, low: float) -> np.ndarray:
+        """Per trace: first local index i with col[i-1] >= high and col[i] <= low, or -1."""
+        col = self.cols[column]
+        mask = np.zeros(len(col), dtype=bool)
+        mask[1:] = (col[:-1] >= high) & (col[1:] <= low) & self._same_seg_pairs()
+        return self.first_index(mask)
+
+    # -------------------------------------------------------------------------
+    # Settle time (truncated-area method)
+    # -------------------------------------------------------------------------
+
+    def settle_time_robust(self, motion_end_t: float, t_col: str = "t_sec",
+                           y_col: str = "out_u16") -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Per trace (settled_timestamp, delay_seconds), NaN where undefined.
+
+        Batched form of the truncated-area estimate:
+          - y_start: output interpolated at motion_end_t
+          - y_final: mean output over the second half of the tail (t >= motion_end_t)
+          - area: integral of |y_final - y| over the tail, up to the first sample
+            that reaches y_final
+          - delay = 3 * area / |y_final - y_start|
+        """
+        n = self.count
+        t = self.cols[t_col]
+        y = self.cols[y_col]
+        seg = self.seg
+        nan = np.full(n, np.nan)
+
+        # Tail start (t is increasing within a trace)
+        tail = t >= motion_end_t
+        k = self.first_index(tail)
+        has_tail = k >= 0
+        last = self.starts + self.lengths - 1
+        k_abs = np.where(has_tail, self.starts + k, last)
+
+        # y_start = np.interp(motion_end_t, t, y) with end clamping
+        prev = np.maximum(k_abs - 1, self.starts)
+        t0, t1 = t[prev], t[k_abs]
+        y0, y1 = y[prev], y[k_abs]
+        span = t1 - t0
+        w = np.where(span > 0, (motion_end_t - t0) / np.where(span > 0, span, 1.0), 1.0)
+        y_start = np.where(k_abs == self.starts, y1, y0 + np.clip(w, 0.0, 1.0) * (y1 - y0))
+
+        # y_final over the steady half of the tail
+        t_mid = (t[last] + t[k_abs]) / 2.0
+        steady = tail & (t > t_mid[seg])
+        steady_n = np.bincount(seg[steady], minlength=n)
+        steady_sum = np.bincount(seg[steady], weights=y[steady], minlength=n)
+        ok = has_tail & (steady_n > 0)
+        y_final = np.where(ok, steady_sum / np.maximum(steady_n, 1), np.nan)
+        height = y_final - y_start
+        flat = ok & (np.abs(height) < 1.0)
+
+        # Cut the tail at the first sample that reaches y_final (whole tail if none)
+        rising = height[seg] > 0
+        reached = tail & np.where(rising, y >= y_final[seg], y <= y_final[seg])
+        cutoff = self.first_index(reached)
+        cutoff = np.where(cutoff >= 0, cutoff, self.lengths - 1)
+        valid = tail & (self.local <= cutoff[seg])
+
+        # Trapezoid over consecutive valid samples of the same trace
+        err = np.abs(y_final[seg] - y)
+        pair = valid[:-1] & valid[1:] & self._same_seg_pairs()
+        pair_area = 0.5 * (err[:-1] + err[1:]) * (t[1:] - t[:-1])
+        area = np.bincount(seg[:-1][pair], weights=pair_area[pair], minlength=n)
+
+        with np.errstate(divide="ignore", invalid="ignore"):
+            delay = 3.0 * area / np.abs(height)
+        delay = np.where(flat, 0.0, delay)
+        delay = np.where(ok, delay, nan)
+        return motion_end_t + delay, delay
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+Reader for the binary traces written by tests/c_tests/trace_writer.h.
+
+A trace is a small self-describing header followed by fixed-size little-endian
+records, so it maps straight into a NumPy structured array without parsing.
+See trace_writer.h for the byte layout; the two must change together.
+"""
+
+import os
+import numpy as np
+import pandas as pd
+from typing import Dict, Tuple
+
+MAGIC = b"SATRACE\0"
+FORMAT_VERSION = 1
+
+HEADER_DTYPE = np.dtype([
+    ("magic", "S8"),
+    ("version", "<u2"),
+    ("num_cols", "<u2"),
+    ("record_size", "<u4"),
+    ("data_offset", "<u4"),
+    ("reserved", "<u4"),
+])
+
+COLUMN_DTYPE = np.dtype([
+    ("name", "S24"),
+    ("type", "S4"),
+    ("offset", "<u4"),
+])
+
+
+def read_header(path: str) -> Tuple[np.dtype, int]:
+    """Return (record dtype, data offset) described by a trace header."""
+    with open(path, "rb") as f:
+        raw = f.read(HEADER_DTYPE.itemsize)
+        if len(raw) < HEADER_DTYPE.itemsize:
+            raise ValueError(f"{path}: truncated trace header")
+        hdr = np.frombuffer(raw, dtype=HEADER_DTYPE)[0]
+        # NumPy strips trailing NULs from "S" fields
+        if hdr["magic"] != MAGIC.rstrip(b"\0"):
+            raise ValueError(f"{path}: not a smooth_axis trace")
+        if hdr["version"] != FORMAT_VERSION:
+            raise ValueError(f"{path}: unsupported trace version {hdr['version']}")
+
+        n = int(hdr["num_cols"])
+        cols = np.frombuffer(f.read(COLUMN_DTYPE.itemsize * n), dtype=COLUMN_DTYPE, count=n)
+
+    return np.dtype({
+        "names": [c["name"].decode("ascii") for c in cols],
+        "formats": ["<" + c["type"].decode("ascii") for c in cols],
+        "offsets": [int(c["offset"]) for c in cols],
+        "itemsize": int(hdr["record_size"]),
+    }), int(hdr["data_offset"])
+
+
+def load_trace(path: str) -> np.ndarray:
+    """Map a binary trace as a read-only structured array (one field per column)."""
+    dtype, data_offset = read_header(path)
+    count = (os.path.getsize(path) - data_offset) // dtype.itemsize  # Ignores a partial tail
+    if count <= 0:
+        return np.empty(0, dtype=dtype)
+    return np.memmap(path, dtype=dtype, mode="r", offset=data_offset, shape=(count,))
+
+
+def load_arrays(stem: str, use_cache: bool = True) -> Dict[str, np.ndarray]:
+    """
+    Load `stem`.bin if it exists, else the `stem`.csv export, as column arrays.
+
+    Binary columns are memmap views (float columns are float32). A CSV export is
+    parsed once and cached next to it as `stem`.npz; the cache is reused while it
+    is newer than the CSV.
+    """
+    bin_path = stem + ".bin"
+    if os.path.exists(bin_path):
+        rec = load_trace(bin_path)
+        return {name: rec[name] for name in rec.dtype.names}
+
+    csv_path = stem + ".csv"
+    npz_path = stem + ".npz"
+    if use_cache and os.path.exists(npz_path) and \
+            os.path.getmtime(npz_path) >= os.path.getmtime(csv_path):
+        with np.load(npz_path) as cached:
+            return {name: cached[name] for name in cached.files}
+
+    df = pd.read_csv(csv_path)
+    arrays = {name: df[name].to_numpy() for name in df.columns}
+    if use_cache:
+        np.savez(npz_path, **arrays)
+    return arrays
+
+
+def load_table(stem: str, use_cache: bool = True) -> pd.DataFrame:
+    """
+    load_arrays() as a DataFrame.
+
+    Unsigned columns are widened to int64 so differences behave as they do for
+    the CSV export (a u16 diff would otherwise wrap instead of going negative).
+    """
+    arrays = load_arrays(stem, use_cache)
+    return pd.DataFrame({name: np.asarray(col).astype(np.int64) if col.dtype.kind == "u" else np.asarray(col)
+                         for name, col in arrays.items()})
+
+
+def trace_stem(path: str) -> str:
+    """Strip a .bin/.csv extension."""
+    base, ext = os.path.splitext(path)
+    return base if ext in (".bin", ".csv") else path